@@ -0,0 +1,60 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "rix/core/bag.hpp"
+#include "rix/util/time.hpp"
+
+/**
+ * Measures the rate at which a BagWriter accepts messages of a LaserScan-like
+ * size, including the time to write the last chunk on close, and the rate at
+ * which a BagReader returns them with read-ahead. Pass the path of the bag,
+ * e.g. `./bag_bench /data/bench.rixbag`; it defaults to /tmp. The bag is
+ * likely still in the page cache when it is read.
+ */
+int main(int argc, char **argv) {
+    const char *path = argc > 1 ? argv[1] : "/tmp/bag_bench.rixbag";
+    const size_t count = 200000;
+    const size_t size = 8 * 1024;
+    std::vector<uint8_t> msg(size, 0xA5);
+
+    rix::msg::mediator::TopicInfo info;
+    info.name = "/scan";
+    rix::core::BagWriter bag;
+    if (!bag.open(path)) {
+        return 1;
+    }
+    int topic = bag.add_topic(info);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) {
+        bag.write(static_cast<uint16_t>(topic), rix::util::Time::now().to_nanoseconds(), 0, msg.data(), msg.size());
+    }
+    uint64_t bytes = bag.bytes();
+    bool ok = bag.close();
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::fprintf(stderr, "write %zu messages of %zu bytes: %.0f MB/s, %.0f messages/s%s\n", count, size,
+                 bytes / seconds / 1e6, count / seconds, ok ? "" : " (write failed)");
+
+    rix::core::BagReader reader;
+    if (!ok || !reader.open(path)) {
+        return 1;
+    }
+    start = std::chrono::steady_clock::now();
+    reader.start();
+    rix::core::BagReader::Message read;
+    size_t messages = 0;
+    uint64_t checksum = 0;
+    while (reader.next(read)) {
+        checksum += read.data[read.len - 1];
+        messages++;
+    }
+    end = std::chrono::steady_clock::now();
+    seconds = std::chrono::duration<double>(end - start).count();
+    std::fprintf(stderr, "read  %zu messages of %zu bytes: %.0f MB/s, %.0f messages/s (checksum %llu)\n", messages,
+                 size, bytes / seconds / 1e6, messages / seconds, static_cast<unsigned long long>(checksum));
+    std::remove(path);
+    return messages == count ? 0 : 1;
+}
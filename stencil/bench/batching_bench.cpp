@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "rix/core/mediator.hpp"
+#include "rix/core/node.hpp"
+#include "rix/msg/standard/Header.hpp"
+
+using rix::msg::standard::Header;
+
+/**
+ * Measures message rate against latency for small messages over loopback TCP
+ * with and without publisher batching, and with publish_batch. The payload is a Header with an empty
+ * frame_id (16 bytes). The publisher node publishes a burst of messages per
+ * spin iteration, as a timer callback publishing several messages would, and
+ * the subscriber node is spun in a background thread. Latency is measured from
+ * the stamp of each message to its callback.
+ */
+struct Config {
+    const char *name;
+    size_t max_bytes;
+    double max_latency;
+    bool publish_batch; /**< Publish each burst with one call to publish_batch */
+};
+
+int main(int argc, char **argv) {
+    std::setvbuf(stdout, nullptr, _IONBF, 0);
+    const size_t count = 100000;
+    const size_t burst = 16;
+    rix::ipc::Endpoint rixhub_endpoint("127.0.0.1", rix::core::RIXHUB_PORT + 2);
+
+    rix::core::Mediator mediator(rixhub_endpoint);
+    if (!mediator.ok()) {
+        std::fprintf(stderr, "Failed to create mediator.\n");
+        return 1;
+    }
+    std::thread rixhub_thread([&]() {
+        while (mediator.ok()) {
+            mediator.spin_once();
+            rix::util::sleep_for(rix::util::Duration(0.001));
+        }
+    });
+
+    std::atomic<size_t> received(0);
+    std::vector<double> latencies(count);
+    auto sub_node = std::make_shared<rix::core::Node>("batching_bench_sub", rixhub_endpoint);
+    auto sub = sub_node->create_subscriber<Header>("/bench/header", [&](const Header &msg) {
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        int64_t sent = static_cast<int64_t>(msg.stamp.sec) * 1'000'000'000LL + msg.stamp.nsec;
+        size_t i = received.load(std::memory_order_relaxed);
+        if (i < latencies.size()) {
+            latencies[i] = (std::chrono::duration_cast<std::chrono::nanoseconds>(now).count() - sent) / 1e3;
+        }
+        received.store(i + 1, std::memory_order_release);
+    });
+
+    auto pub_node = std::make_shared<rix::core::Node>("batching_bench_pub", rixhub_endpoint);
+    auto pub = pub_node->create_publisher<Header>("/bench/header");
+
+    std::thread sub_thread([&]() { sub_node->spin(); });
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (pub->get_subscriber_count() == 0 && std::chrono::steady_clock::now() < deadline) {
+        pub_node->spin_once();
+    }
+    if (pub->get_subscriber_count() == 0) {
+        std::fprintf(stderr, "Subscriber did not connect.\n");
+    } else {
+        const Config configs[] = {
+            {"unbatched", 0, 0.0, false},
+            {"end of spin", 65536, 0.0, false},
+            {"100 us", 65536, 0.0001, false},
+            {"1 ms", 65536, 0.001, false},
+            {"4 KiB", 4096, 1.0, false},
+            {"burst", 0, 0.0, true},
+        };
+        for (const auto &config : configs) {
+            pub->set_batching(config.max_bytes, rix::util::Duration(config.max_latency));
+            received.store(0);
+
+            std::vector<Header> msgs(burst);
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < count;) {
+                size_t j = 0;
+                for (; j < burst && i < count; j++, i++) {
+                    auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::system_clock::now().time_since_epoch())
+                                   .count();
+                    Header &msg = msgs[j];
+                    msg.seq = static_cast<uint32_t>(i);
+                    msg.stamp.sec = static_cast<int32_t>(now / 1'000'000'000);
+                    msg.stamp.nsec = static_cast<int32_t>(now % 1'000'000'000);
+                    if (!config.publish_batch) pub->publish(msg);
+                }
+                if (config.publish_batch) pub->publish_batch<Header>(std::span<const Header>(msgs.data(), j));
+                pub_node->spin_once();
+            }
+            pub->flush();
+            auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (received.load(std::memory_order_acquire) < count && std::chrono::steady_clock::now() < timeout) {
+                std::this_thread::yield();
+            }
+            double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            size_t n = std::min(received.load(std::memory_order_acquire), count);
+            std::vector<double> sorted(latencies.begin(), latencies.begin() + n);
+            std::sort(sorted.begin(), sorted.end());
+            if (n == 0) {
+                std::printf("%-12s received nothing\n", config.name);
+                continue;
+            }
+            std::printf("%-12s received=%zu rate=%.0f msg/s latency p50=%.1fus p99=%.1fus\n", config.name, n, n / secs,
+                        sorted[n / 2], sorted[n * 99 / 100]);
+        }
+    }
+
+    sub_node->shutdown();
+    sub_thread.join();
+
+    // The nodes talk to rixhub when they are destroyed, so destroy them first
+    pub.reset();
+    sub.reset();
+    pub_node.reset();
+    sub_node.reset();
+    mediator.shutdown();
+    rixhub_thread.join();
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+#include "rix/core/message_pool.hpp"
+#include "rix/msg/mediator/SubNotify.hpp"
+#include "rix/msg/sensor/LaserScan.hpp"
+
+/**
+ * Counts the heap allocations made while decoding messages the ways the
+ * Mediator, Subscriber and subscriber callbacks do.
+ */
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+    allocations++;
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+struct Result {
+    double allocations;
+    double ns;
+};
+
+template <typename F>
+Result measure(size_t count, F f) {
+    f();  // Warm up, e.g. grow reused messages to their steady-state size
+    size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) f();
+    auto end = std::chrono::steady_clock::now();
+    return {double(allocations - before) / count, std::chrono::duration<double, std::nano>(end - start).count() / count};
+}
+
+void print(const char *name, Result r) { std::printf("%-34s %6.1f allocations %9.1f ns\n", name, r.allocations, r.ns); }
+
+int main(int argc, char **argv) {
+    using namespace rix::msg;
+    const size_t count = 200'000;
+
+    mediator::SubNotify notify;
+    for (int i = 0; i < 8; i++) {
+        mediator::PubInfo pub;
+        pub.id = i;
+        pub.topic_info.name = "/robot/sensors/front_laser/scan";
+        pub.endpoint.address = "192.168.100.200";
+        pub.endpoint.port = 5000 + i;
+        notify.publishers.push_back(pub);
+    }
+    std::vector<uint8_t> notify_bytes(notify.size());
+    size_t offset = 0;
+    notify.serialize(notify_bytes.data(), offset);
+
+    print("SubNotify[8] new message", measure(count, [&] {
+              mediator::SubNotify msg;
+              size_t off = 0;
+              msg.deserialize(notify_bytes.data(), notify_bytes.size(), off);
+          }));
+    mediator::SubNotify reused;
+    print("SubNotify[8] reused message", measure(count, [&] {
+              size_t off = 0;
+              reused.deserialize(notify_bytes.data(), notify_bytes.size(), off);
+          }));
+    print("SubNotify[8] View", measure(count, [&] {
+              mediator::SubNotify::View view;
+              size_t off = 0;
+              view.parse(notify_bytes.data(), notify_bytes.size(), off);
+              uint64_t sum = 0;
+              for (const auto &pub : view.publishers()) sum += pub.endpoint().port();
+              asm volatile("" : : "r"(sum));
+          }));
+
+    print("Operation payload std::vector", measure(count, [&] {
+              std::vector<uint8_t> payload(notify_bytes.size());
+              asm volatile("" : : "r"(payload.data()) : "memory");
+          }));
+    print("Operation payload stack arena", measure(count, [&] {
+              std::array<uint8_t, 1024> buffer;
+              std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+              std::pmr::vector<uint8_t> payload(notify_bytes.size(), &arena);
+              asm volatile("" : : "r"(payload.data()) : "memory");
+          }));
+
+    sensor::LaserScan scan;
+    scan.header.frame_id = "front_laser_link_frame";
+    scan.ranges.assign(360, 1.0f);
+    scan.intensities.assign(360, 100.0f);
+    std::vector<uint8_t> scan_bytes(scan.size());
+    offset = 0;
+    scan.serialize(scan_bytes.data(), offset);
+
+    print("LaserScan[360] new message", measure(count, [&] {
+              sensor::LaserScan msg;
+              size_t off = 0;
+              msg.deserialize(scan_bytes.data(), scan_bytes.size(), off);
+          }));
+    rix::core::MessagePool<sensor::LaserScan> pool;
+    print("LaserScan[360] pooled message", measure(count, [&] {
+              auto msg = pool.acquire();
+              size_t off = 0;
+              msg->deserialize(scan_bytes.data(), scan_bytes.size(), off);
+          }));
+    standard::Header header;
+    print("LaserScan[360] Header prefix", measure(count, [&] {
+              size_t off = 0;
+              header.deserialize_prefix(scan_bytes.data(), scan_bytes.size(), off, standard::Header::FIELD::FRAME_ID);
+              asm volatile("" : : "r"(header.seq) : "memory");
+          }));
+    print("LaserScan[360] seek intensities", measure(count, [&] {
+              size_t off = 0;
+              sensor::LaserScan::seek(sensor::LaserScan::FIELD::INTENSITIES, scan_bytes.data(), scan_bytes.size(), off);
+              asm volatile("" : : "r"(off));
+          }));
+    return 0;
+}
@@ -0,0 +1,194 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "rix/msg/geometry/Pose2D.hpp"
+#include "rix/msg/standard/Time.hpp"
+
+using rix::msg::Message;
+
+/**
+ * Pose2D and Time as they were generated before fixed-size traits: every field
+ * is sized, serialized and bounds checked on its own.
+ */
+class FieldwisePose2D : public Message {
+   public:
+    float x;
+    float y;
+    float theta;
+
+    size_t size() const override {
+        using namespace rix::msg::detail;
+        size_t size = 0;
+        size += size_number(x);
+        size += size_number(y);
+        size += size_number(theta);
+        return size;
+    }
+
+    std::array<uint64_t, 2> hash() const override { return {0xe6921cbc9b9f8376ULL, 0x5ab0f8a78d45b88fULL}; }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        using namespace rix::msg::detail;
+        serialize_number(dst, offset, x);
+        serialize_number(dst, offset, y);
+        serialize_number(dst, offset, theta);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        using namespace rix::msg::detail;
+        if (!deserialize_number(x, src, size, offset)) return false;
+        if (!deserialize_number(y, src, size, offset)) return false;
+        if (!deserialize_number(theta, src, size, offset)) return false;
+        return true;
+    }
+};
+
+class FieldwiseTime : public Message {
+   public:
+    int32_t sec{};
+    int32_t nsec{};
+
+    size_t size() const override {
+        using namespace rix::msg::detail;
+        return size_number(sec) + size_number(nsec);
+    }
+
+    std::array<uint64_t, 2> hash() const override { return {0xe80974cc496bf99dULL, 0xf7f4f2296e012a33ULL}; }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        using namespace rix::msg::detail;
+        serialize_number(dst, offset, sec);
+        serialize_number(dst, offset, nsec);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        using namespace rix::msg::detail;
+        if (!deserialize_number(sec, src, size, offset)) return false;
+        if (!deserialize_number(nsec, src, size, offset)) return false;
+        return true;
+    }
+};
+
+/**
+ * A stamped pose in both styles: nested messages go through serialize_message
+ * today, and are folded into a single fixed-size block with traits.
+ */
+class FieldwiseStampedPose : public Message {
+   public:
+    FieldwiseTime stamp;
+    FieldwisePose2D pose;
+
+    size_t size() const override {
+        using namespace rix::msg::detail;
+        return size_message(stamp) + size_message(pose);
+    }
+
+    std::array<uint64_t, 2> hash() const override { return {0, 0}; }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        using namespace rix::msg::detail;
+        serialize_message(dst, offset, stamp);
+        serialize_message(dst, offset, pose);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        using namespace rix::msg::detail;
+        if (!deserialize_message(stamp, src, size, offset)) return false;
+        if (!deserialize_message(pose, src, size, offset)) return false;
+        return true;
+    }
+};
+
+class FixedStampedPose : public Message {
+   public:
+    rix::msg::standard::Time stamp;
+    rix::msg::geometry::Pose2D pose;
+
+    static constexpr size_t FIXED_SIZE =
+        rix::msg::detail::fixed_size_of<rix::msg::standard::Time, rix::msg::geometry::Pose2D>();
+
+    size_t size() const override { return FIXED_SIZE; }
+
+    std::array<uint64_t, 2> hash() const override { return {0, 0}; }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        using namespace rix::msg::detail;
+        serialize_fixed(dst, offset, stamp, pose);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        using namespace rix::msg::detail;
+        return deserialize_fixed(src, size, offset, stamp, pose);
+    }
+};
+
+static_assert(FixedStampedPose::FIXED_SIZE == 20, "Nested fixed-size fields are folded");
+
+/**
+ * Serializes and deserializes `count` messages through the Message interface,
+ * as Publisher and Subscriber do, and returns nanoseconds per round trip.
+ */
+template <typename T>
+double round_trip(size_t count) {
+    std::vector<std::unique_ptr<Message>> in, out;
+    for (size_t i = 0; i < 64; i++) {
+        in.push_back(std::make_unique<T>());
+        out.push_back(std::make_unique<T>());
+    }
+    std::vector<uint8_t> buffer(256);
+    size_t failures = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) {
+        const Message &src = *in[i & 63];
+        Message &dst = *out[i & 63];
+        size_t offset = 0;
+        size_t size = src.size();
+        src.serialize(buffer.data(), offset);
+        offset = 0;
+        if (!dst.deserialize(buffer.data(), size, offset)) failures++;
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (failures) std::fprintf(stderr, "%zu failures\n", failures);
+    return secs * 1e9 / count;
+}
+
+/**
+ * Serializes and deserializes a vector of `n` messages with the vector helpers,
+ * where the element type is known statically, and returns nanoseconds per
+ * message.
+ */
+template <typename T>
+double vector_round_trip(size_t n, size_t iterations) {
+    using namespace rix::msg::detail;
+    std::vector<T> in(n), out;
+    std::vector<uint8_t> buffer(size_message_vector(in));
+    size_t failures = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        size_t offset = 0;
+        serialize_message_vector(buffer.data(), offset, in);
+        offset = 0;
+        if (!deserialize_message_vector(out, buffer.data(), buffer.size(), offset)) failures++;
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (failures) std::fprintf(stderr, "%zu failures\n", failures);
+    return secs * 1e9 / (n * iterations);
+}
+
+int main(int argc, char **argv) {
+    const size_t count = 20'000'000;
+    std::printf("Pose2D       fieldwise=%.2fns fixed=%.2fns\n", round_trip<FieldwisePose2D>(count),
+                round_trip<rix::msg::geometry::Pose2D>(count));
+    std::printf("Time         fieldwise=%.2fns fixed=%.2fns\n", round_trip<FieldwiseTime>(count),
+                round_trip<rix::msg::standard::Time>(count));
+    std::printf("StampedPose  fieldwise=%.2fns fixed=%.2fns\n", round_trip<FieldwiseStampedPose>(count),
+                round_trip<FixedStampedPose>(count));
+    std::printf("Pose2D[1000] fieldwise=%.2fns fixed=%.2fns per message\n",
+                vector_round_trip<FieldwisePose2D>(1000, 20000),
+                vector_round_trip<rix::msg::geometry::Pose2D>(1000, 20000));
+    return 0;
+}
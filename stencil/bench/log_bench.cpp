@@ -0,0 +1,46 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "rix/util/binary_log.hpp"
+#include "rix/util/log.hpp"
+
+/**
+ * Measures the time spent in a log statement by the calling thread, with the
+ * default backend, with the asynchronous one, and with a binary log. Records go to stdout, so run
+ * with stdout redirected, e.g. `./log_bench > /dev/null`. Results are printed
+ * to stderr.
+ */
+template <typename F>
+void measure(const char *name, size_t count, F f) {
+    std::vector<double> samples(count);
+    for (size_t i = 0; i < count; i++) {
+        auto start = std::chrono::steady_clock::now();
+        f(i);
+        auto end = std::chrono::steady_clock::now();
+        samples[i] = std::chrono::duration<double, std::nano>(end - start).count();
+        // Stay below the rate at which the background thread drains the queue
+        if (i % 64 == 63) rix::util::Log::flush();
+    }
+    std::sort(samples.begin(), samples.end());
+    std::fprintf(stderr, "%-6s p50=%7.0f ns p99=%7.0f ns p99.9=%7.0f ns\n", name, samples[count / 2],
+                 samples[count * 99 / 100], samples[count * 999 / 1000]);
+}
+
+int main(int argc, char **argv) {
+    const size_t count = 100000;
+    auto log = [](size_t i) { rix::util::Log::info << "spin " << i << " took " << 0.25 * i << " ms" << std::endl; };
+
+    measure("sync", count, log);
+    rix::util::Log::set_async(true);
+    measure("async", count, log);
+    rix::util::Log::set_async(false);
+
+    static const auto fmt =
+        rix::util::BinaryLog::format<size_t, double>(rix::util::Log::INFO, "spin {} took {} ms");
+    rix::util::BinaryLog::open_file("/tmp/log_bench.rixlog", "log_bench");
+    measure("binary", count, [](size_t i) { rix::util::BinaryLog::write(fmt, i, 0.25 * i); });
+    rix::util::BinaryLog::close();
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "rix/core/mediator.hpp"
+#include "rix/core/node.hpp"
+#include "rix/msg/standard/UInt32.hpp"
+
+using rix::msg::standard::UInt32;
+
+/**
+ * Measures service round trips over loopback TCP. A rixhub instance and a
+ * service node (UInt32 -> UInt32) are spun in background threads. The client
+ * first issues sequential blocking calls to measure latency, then keeps N
+ * requests in flight on its persistent connection to measure throughput.
+ * Note that the service node busy loops, so results on a single core machine
+ * are dominated by scheduling.
+ */
+int main(int argc, char **argv) {
+    std::setvbuf(stdout, nullptr, _IONBF, 0);
+    const size_t sequential = 2000;
+    const size_t total = 20000;
+    rix::ipc::Endpoint rixhub_endpoint("127.0.0.1", rix::core::RIXHUB_PORT + 1);
+
+    rix::core::Mediator mediator(rixhub_endpoint);
+    if (!mediator.ok()) {
+        std::fprintf(stderr, "Failed to create mediator.\n");
+        return 1;
+    }
+    // rixhub is only needed for registration and lookup, so it does not need
+    // to busy loop and compete with the nodes for the CPU.
+    std::thread rixhub_thread([&]() {
+        while (mediator.ok()) {
+            mediator.spin_once();
+            rix::util::sleep_for(rix::util::Duration(0.001));
+        }
+    });
+
+    auto server_node = std::make_shared<rix::core::Node>("service_bench_server", rixhub_endpoint);
+    auto srv = server_node->create_service<UInt32, UInt32>("/bench/echo", [](const UInt32 &req, UInt32 &res) {
+        res.data = req.data;
+        return true;
+    });
+    if (!srv || !srv->ok()) {
+        std::fprintf(stderr, "Failed to create service.\n");
+        mediator.shutdown();
+        rixhub_thread.join();
+        return 1;
+    }
+    std::thread server_thread([&]() { server_node->spin(); });
+
+    auto client_node = std::make_shared<rix::core::Node>("service_bench_client", rixhub_endpoint);
+    auto client = client_node->create_client<UInt32, UInt32>("/bench/echo");
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!client->is_connected() && std::chrono::steady_clock::now() < deadline) {
+        client_node->spin_once();
+    }
+    if (!client->is_connected()) {
+        std::fprintf(stderr, "Failed to connect to service.\n");
+    } else {
+        // Sequential latency
+        std::vector<double> latencies;
+        latencies.reserve(sequential);
+        UInt32 req, res;
+        for (size_t i = 0; i < sequential; i++) {
+            req.data = static_cast<uint32_t>(i);
+            auto start = std::chrono::steady_clock::now();
+            if (!client->call(req, res)) break;
+            latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        if (!latencies.empty()) {
+            std::printf("sequential calls=%zu p50=%.1fus p99=%.1fus max=%.1fus\n", latencies.size(),
+                        latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100], latencies.back());
+        }
+
+        // Pipelined throughput with N requests in flight
+        for (size_t inflight : {1, 8, 64, 256}) {
+            std::vector<std::future<std::optional<UInt32>>> futures;
+            futures.reserve(total);
+            size_t sent = 0, done = 0, failed = 0;
+            auto start = std::chrono::steady_clock::now();
+            while (done < total) {
+                while (sent < total && sent - done < inflight) {
+                    req.data = static_cast<uint32_t>(sent++);
+                    futures.push_back(client->call_async<UInt32, UInt32>(req));
+                }
+                client->wait_for_responses(rix::util::Duration(0.01));
+                while (done < sent && futures[done].wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                    if (!futures[done++].get()) failed++;
+                }
+            }
+            double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::printf("pipelined inflight=%-4zu requests=%zu failed=%zu rate=%.0f req/s\n", inflight, total, failed,
+                        total / secs);
+        }
+    }
+
+    server_node->shutdown();
+    server_thread.join();
+
+    // The nodes talk to rixhub when they are destroyed, so destroy them first
+    client.reset();
+    srv.reset();
+    client_node.reset();
+    server_node.reset();
+    mediator.shutdown();
+    rixhub_thread.join();
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+#include "rix/core/synchronizer.hpp"
+#include "rix/msg/geometry/Pose2DStamped.hpp"
+#include "rix/msg/sensor/LaserScan.hpp"
+
+using rix::msg::geometry::Pose2DStamped;
+using rix::msg::sensor::LaserScan;
+
+/**
+ * Feeds a LaserScan stream and a Pose2DStamped stream, both at 1 kHz, through
+ * a Synchronizer and reports the cost per added message. The pose stream is
+ * offset by up to +/- 0.3 ms of jitter for the approximate policy and is
+ * exactly aligned for the exact policy.
+ */
+static void run(rix::core::SyncPolicy policy, const char *name, size_t count) {
+    const int64_t period_ns = 1'000'000;  // 1 kHz
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int64_t> jitter(-300'000, 300'000);
+
+    uint64_t matched = 0;
+    rix::core::Synchronizer<LaserScan, Pose2DStamped> sync(
+        policy, [&](const LaserScan &, const Pose2DStamped &) { matched++; }, 32, rix::util::Duration(0.0005));
+
+    LaserScan scan;
+    scan.ranges.resize(360);
+    scan.intensities.resize(360);
+    Pose2DStamped pose;
+
+    auto set_stamp = [](rix::msg::standard::Header &h, int64_t ns) {
+        h.stamp.sec = static_cast<int32_t>(ns / 1'000'000'000);
+        h.stamp.nsec = static_cast<int32_t>(ns % 1'000'000'000);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) {
+        int64_t t = 1'000'000'000 + static_cast<int64_t>(i) * period_ns;
+        set_stamp(scan.header, t);
+        set_stamp(pose.header, policy == rix::core::SyncPolicy::EXACT_TIME ? t : t + jitter(gen));
+        sync.add<0>(scan);
+        sync.add<1>(pose);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    double per_msg = ns / (2.0 * count);
+    std::printf("%-18s messages=%zu matched=%llu dropped=%llu ns/msg=%.1f 1kHz-budget=%.4f%%\n", name, 2 * count,
+                static_cast<unsigned long long>(matched), static_cast<unsigned long long>(sync.get_dropped_count()),
+                per_msg, 100.0 * (2.0 * per_msg) / period_ns);
+}
+
+int main() {
+    const size_t count = 60'000;  // One minute of data per topic at 1 kHz
+    run(rix::core::SyncPolicy::EXACT_TIME, "exact_time", count);
+    run(rix::core::SyncPolicy::APPROXIMATE_TIME, "approximate_time", count);
+    return 0;
+}
@@ -0,0 +1,375 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rix/msg/mediator/TopicInfo.hpp"
+
+namespace rix {
+namespace core {
+
+/**
+ * @brief The file format of bags, which store the serialized messages of a
+ * set of topics.
+ *
+ * @details A bag starts with HEADER_SIZE bytes:
+ *
+ *     [MAGIC][uint64 index offset][uint64 chunk size][zero padding]
+ *
+ * followed by chunks. Every chunk starts with a CHUNK_HEADER_SIZE header
+ *
+ *     [uint64 size][uint32 records][uint32 messages][int64 first time][int64 last time]
+ *
+ * where size is the number of bytes of records that follow, and the times
+ * are those of the first and last MESSAGE record. Every record
+ * starts with a RECORD_HEADER_SIZE header and its size is a multiple of 8:
+ *
+ *     [uint32 len][uint16 topic][uint8 kind][uint8 encoding][int64 time (ns since the epoch)]
+ *
+ * followed by len bytes. A TOPIC record defines the topic ID with the
+ * serialized rix::msg::mediator::TopicInfo, and precedes the first MESSAGE
+ * record of that topic. A MESSAGE record holds a serialized message as
+ * received by a Subscriber, in the given encoding. All numbers are
+ * little-endian.
+ *
+ * A closed bag ends with an index at the index offset:
+ *
+ *     [uint64 chunks][uint32 topics][uint32 0][TOPIC records][chunk entries]
+ *
+ * with one CHUNK_INDEX_SIZE entry per chunk, in the order of the file:
+ *
+ *     [uint64 offset][uint64 size][uint32 records][uint32 messages][int64 first time][int64 last time]
+ *
+ * Chunks are written whole, so a bag that was not closed ends at the last
+ * chunk that fits in the file. Its index offset is 0, and readers rebuild the
+ * index by reading the chunks.
+ */
+namespace bag {
+inline constexpr char MAGIC[8] = {'R', 'I', 'X', 'B', 'A', 'G', '0', '1'};
+inline constexpr size_t HEADER_SIZE = 64;
+inline constexpr size_t CHUNK_HEADER_SIZE = 32;
+inline constexpr size_t RECORD_HEADER_SIZE = 16;
+inline constexpr size_t INDEX_HEADER_SIZE = 16;
+inline constexpr size_t CHUNK_INDEX_SIZE = 40;
+inline constexpr size_t DEFAULT_CHUNK_SIZE = size_t(4) << 20;
+inline constexpr size_t DEFAULT_MAX_PENDING = 16;
+
+enum KIND : uint8_t {
+    TOPIC = 0,
+    MESSAGE = 1,
+};
+
+/**
+ * @brief An entry of the chunk index.
+ *
+ */
+struct Chunk {
+    uint64_t offset = 0;   /**< Offset of the chunk header in the file */
+    uint64_t size = 0;     /**< Bytes of records */
+    uint32_t records = 0;  /**< Number of records */
+    uint32_t messages = 0; /**< Number of MESSAGE records */
+    int64_t first = 0;     /**< Time of the first message */
+    int64_t last = 0;      /**< Time of the last message */
+};
+}  // namespace bag
+
+/**
+ * @brief Writes a bag (see rix::core::bag).
+ *
+ * @details Records are appended to a chunk in memory. Full chunks are
+ * written by a background thread with one system call each, so write only
+ * copies the message and never waits for the disk unless `max_pending`
+ * chunks are queued. Then it blocks until the disk catches up rather than
+ * dropping messages. Writing is not thread-safe.
+ */
+class BagWriter {
+   public:
+    BagWriter() = default;
+    BagWriter(const BagWriter &) = delete;
+    BagWriter &operator=(const BagWriter &) = delete;
+
+    /**
+     * @brief Closes the bag.
+     *
+     */
+    ~BagWriter();
+
+    /**
+     * @brief Creates the bag at `path`, replacing an existing file.
+     *
+     * @param path The path of the bag
+     * @param chunk_size The number of bytes of records per chunk
+     * @param max_pending The number of full chunks that may wait for the disk
+     * @return true if the file was created
+     */
+    bool open(const std::string &path, size_t chunk_size = bag::DEFAULT_CHUNK_SIZE,
+              size_t max_pending = bag::DEFAULT_MAX_PENDING);
+
+    /**
+     * @brief Returns true if the bag is open and no write has failed.
+     *
+     */
+    bool ok() const;
+
+    /**
+     * @brief Adds a topic to the bag.
+     *
+     * @param info The topic info, including the message hash
+     * @return The ID to pass to write, or -1 if the bag is not ok
+     */
+    int add_topic(const rix::msg::mediator::TopicInfo &info);
+
+    /**
+     * @brief Appends a serialized message.
+     *
+     * @param topic The ID returned by add_topic
+     * @param time The receive time in nanoseconds since the epoch
+     * @param encoding The encoding of the message (see rix/core/encoding.hpp)
+     * @param data The serialized message
+     * @param len The size of the serialized message
+     * @return true if the bag is ok
+     */
+    bool write(uint16_t topic, int64_t time, uint8_t encoding, const uint8_t *data, size_t len);
+
+    /**
+     * @brief Writes the last chunk and the index, and closes the file.
+     *
+     * @return true if every write succeeded
+     */
+    bool close();
+
+    /**
+     * @brief Returns the number of messages written.
+     *
+     */
+    uint64_t messages() const;
+
+    /**
+     * @brief Returns the number of bytes of the file, including the chunks
+     * that are not written yet.
+     *
+     */
+    uint64_t bytes() const;
+
+   private:
+    struct Chunk {
+        std::vector<uint8_t> data;
+        size_t size = 0;       /**< Bytes used, including the chunk header */
+        uint32_t count = 0;    /**< Number of records */
+        uint32_t messages = 0; /**< Number of MESSAGE records */
+        int64_t first = 0;     /**< Time of the first message */
+        int64_t last = 0;      /**< Time of the last message */
+    };
+
+    int fd_ = -1;
+    size_t chunk_size_ = 0;
+    size_t max_pending_ = 0;
+    uint16_t topics_ = 0;
+    uint64_t messages_ = 0;
+    uint64_t bytes_ = 0;
+    std::vector<uint8_t> topic_records_; /**< TOPIC records, repeated in the index */
+    std::vector<bag::Chunk> index_;      /**< Chunks that were sealed */
+    Chunk chunk_;             /**< Chunk that records are appended to */
+    std::deque<Chunk> full_;  /**< Chunks waiting for the writer thread */
+    std::vector<Chunk> free_; /**< Written chunks that are reused */
+    size_t allocated_ = 0;    /**< Number of chunks, in use or free */
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool stop_ = false;
+    std::atomic<bool> failed_{false};
+
+    /**
+     * @brief Appends a record to the current chunk, submitting it first if
+     * the record does not fit.
+     *
+     */
+    bool append(uint16_t topic, uint8_t kind, uint8_t encoding, int64_t time, const uint8_t *data, size_t len);
+
+    /**
+     * @brief Writes the header of the current chunk.
+     *
+     */
+    void seal();
+
+    /**
+     * @brief Queues the current chunk for the writer thread and takes a free
+     * chunk, waiting if `max_pending` chunks are queued.
+     *
+     */
+    void submit();
+
+    /**
+     * @brief Loop of the writer thread.
+     *
+     */
+    void run();
+
+    /**
+     * @brief Appends the index and fills in its offset in the header. The
+     * writer thread must be stopped.
+     *
+     */
+    bool write_index();
+};
+
+/**
+ * @brief Reads a bag (see rix::core::bag).
+ *
+ * @details open reads the topics and the chunk index. Messages are then read
+ * with start and next, while a background thread reads up to `read_ahead`
+ * chunks in advance, so that next only waits for the disk if the reader
+ * falls behind. Reading messages is not thread-safe.
+ */
+class BagReader {
+   public:
+    /**
+     * @brief A message in a bag. The data is valid until the next call to
+     * next, start or close.
+     *
+     */
+    struct Message {
+        uint16_t topic = 0;
+        uint8_t encoding = 0;
+        int64_t time = 0; /**< Receive time in nanoseconds since the epoch */
+        const uint8_t *data = nullptr;
+        size_t len = 0;
+    };
+
+    BagReader() = default;
+    BagReader(const BagReader &) = delete;
+    BagReader &operator=(const BagReader &) = delete;
+
+    /**
+     * @brief Closes the bag.
+     *
+     */
+    ~BagReader();
+
+    /**
+     * @brief Opens the bag at `path` and reads its index. Bags that were not
+     * closed are indexed by reading all of their chunks.
+     *
+     * @param path The path of the bag
+     * @return true if the file is a bag
+     */
+    bool open(const std::string &path);
+
+    /**
+     * @brief Stops reading and closes the file.
+     *
+     */
+    void close();
+
+    /**
+     * @brief Returns the topics of the bag, indexed by their ID.
+     *
+     */
+    const std::vector<rix::msg::mediator::TopicInfo> &topics() const;
+
+    /**
+     * @brief Returns the chunk index, in the order of the file.
+     *
+     */
+    const std::vector<bag::Chunk> &chunks() const;
+
+    /**
+     * @brief Returns the number of messages in the bag.
+     *
+     */
+    uint64_t messages() const;
+
+    /**
+     * @brief Returns the time of the first message, or 0 if there is none.
+     *
+     */
+    int64_t start_time() const;
+
+    /**
+     * @brief Returns the time of the last message, or 0 if there is none.
+     *
+     */
+    int64_t end_time() const;
+
+    /**
+     * @brief Returns the first chunk that holds messages at or after `time`,
+     * or chunks().size() if there is none. The chunks are searched by
+     * bisection, assuming that receive times do not decrease.
+     *
+     */
+    size_t seek(int64_t time) const;
+
+    /**
+     * @brief Starts reading messages from chunk `first`.
+     *
+     * @param first The index of the chunk, e.g. from seek
+     * @param read_ahead The number of chunks that are read in advance
+     * @return true if the bag is open
+     */
+    bool start(size_t first = 0, size_t read_ahead = 4);
+
+    /**
+     * @brief Reads the next message, waiting for its chunk to be read.
+     *
+     * @param msg Set to the message
+     * @return false at the end of the bag or if a read failed
+     */
+    bool next(Message &msg);
+
+   private:
+    int fd_ = -1;
+    std::vector<rix::msg::mediator::TopicInfo> topics_;
+    std::vector<bag::Chunk> chunks_;
+    uint64_t messages_ = 0;
+
+    std::vector<uint8_t> current_;           /**< Records of the chunk that next reads from */
+    size_t offset_ = 0;                      /**< Offset of the next record in current_ */
+    std::deque<std::vector<uint8_t>> ready_; /**< Chunks read by the thread */
+    std::vector<std::vector<uint8_t>> free_; /**< Buffers that are reused */
+    size_t read_ahead_ = 0;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool stop_ = false;
+    bool done_ = false; /**< Set by the thread after the last chunk or a failed read */
+
+    /**
+     * @brief Reads the index at `offset`.
+     *
+     */
+    bool read_index(uint64_t offset, uint64_t file_size);
+
+    /**
+     * @brief Builds the index by reading the chunks of a bag that was not
+     * closed.
+     *
+     */
+    bool scan(uint64_t file_size);
+
+    /**
+     * @brief Adds the topic of a TOPIC record.
+     *
+     */
+    bool add_topic(uint16_t id, const uint8_t *data, size_t len);
+
+    /**
+     * @brief Stops the read-ahead thread.
+     *
+     */
+    void stop();
+
+    /**
+     * @brief Loop of the read-ahead thread.
+     *
+     */
+    void run(size_t first);
+};
+
+}  // namespace core
+}  // namespace rix
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <functional>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <random>
 #include <string>
@@ -14,6 +16,7 @@
 #include "rix/ipc/interfaces/server.hpp"
 #include "rix/msg/mediator/Operation.hpp"
 #include "rix/msg/mediator/Status.hpp"
+#include "rix/msg/standard/UInt32.hpp"
 #include "rix/util/log.hpp"
 
 namespace rix {
@@ -21,16 +24,91 @@ namespace core {
 
 const uint16_t RIXHUB_PORT = 48104;
 
+/**
+ * @brief Nodes with statistics enabled publish them on STATS_TOPIC_PREFIX
+ * followed by their name (see Node::enable_stats).
+ */
+const char STATS_TOPIC_PREFIX[] = "/rix/stats/";
+
+/**
+ * @brief Size of the stack buffer that mediator operations are read into.
+ *
+ * @details The header and payload of an operation are only needed while it
+ * is handled. They are allocated from a std::pmr::monotonic_buffer_resource
+ * over a buffer of this size on the stack, which is released in one step when
+ * the handler returns. Larger operations fall back to the heap.
+ */
+const size_t OPERATION_ARENA_SIZE = 1024;
+
+/**
+ * @brief Framing of messages sent by publishers over TCP.
+ *
+ * @details
+ *
+ *     [uint32 len][uint32 seq][len bytes of message]
+ *     [uint32 len | TIMESTAMPED][uint32 seq][int64 send time][len bytes of message]
+ *
+ * seq numbers the messages of a publisher, starting at 0 and wrapping around
+ * at 2^32. Every subscriber receives the same sequence numbers, so gaps show
+ * messages that a subscriber did not receive (see SequenceTracker).
+ *
+ * Publishers with timestamping enabled set the TIMESTAMPED bit of len and
+ * add the time of the publish call in nanoseconds of the steady clock
+ * (CLOCK_MONOTONIC on Linux), which is only comparable between processes on
+ * the same machine.
+ */
+namespace data_frame {
+const size_t HEADER_SIZE = 8;
+const size_t TIMESTAMP_SIZE = 8;
+const uint32_t TIMESTAMPED = 0x80000000u;
+}  // namespace data_frame
+
 enum OPCODE {
     NODE_REGISTER = 80,
     SUB_REGISTER,
     PUB_REGISTER,
+    SRV_REGISTER,
 
     SUB_NOTIFY = 90,
+    SRV_LOOKUP,
+    TOPIC_LOOKUP,
 
     NODE_DEREGISTER = 100,
     SUB_DEREGISTER,
     PUB_DEREGISTER,
+    SRV_DEREGISTER,
+};
+
+/**
+ * @brief Values of the protocol field of NodeInfo, PubInfo, SubInfo and
+ * SrvInfo. Subscribers use the protocol of each publisher to decide how to
+ * connect to it.
+ *
+ * TCP:     The publisher owns a server and every subscriber connects to it.
+ * TCP_MUX: The publisher shares its node's Transport. Subscribers open (or
+ *          reuse) a single connection to that node for all of its topics.
+ */
+enum PROTOCOL {
+    TCP = 0,
+    TCP_MUX = 1,
+};
+
+/**
+ * @brief Values of the encoding field of TopicInfo. A publisher registers the
+ * encoding of its messages, and subscribers learn it from the PubInfo of the
+ * SubNotify message, so each publisher of a topic may use a different one.
+ * Encodings are transparent to callbacks. See rix/core/encoding.hpp.
+ *
+ * RAW:       The serialized message.
+ * QUANTIZED: Float arrays are quantized to small integers with a per-message
+ *            scale (LaserScan only).
+ * DELTA:     The serialized message, sent as the XOR with the previous message
+ *            on the same connection (any message type, see rix/core/delta.hpp).
+ */
+enum ENCODING {
+    RAW = 0,
+    QUANTIZED = 1,
+    DELTA = 2,
 };
 
 /**
@@ -40,6 +118,14 @@ enum OPCODE {
  */
 using ClientFactory = std::function<std::shared_ptr<rix::ipc::interfaces::Client>(void)>;
 
+/**
+ * @brief Type definition for an Encoder. Publishers whose topic uses an
+ * encoding other than RAW serialize their messages with it instead of
+ * Message::serialize.
+ *
+ */
+using Encoder = std::function<void(const rix::msg::Message &msg, rix::msg::Writer &dst)>;
+
 /**
  * @brief Type definition for a ServerFactory. This is a function that takes an
  * endpoint as input and returns a shared pointer to a new
@@ -73,13 +159,16 @@ static inline bool send_message_with_opcode_no_response(std::shared_ptr<rix::ipc
         return false;
     }
 
+    // Serialize in a single pass and fill in the length of the operation
+    // afterwards
     rix::msg::mediator::Operation op;
-    op.len = msg.size();
     op.opcode = opcode;
-    std::vector<uint8_t> buffer(op.size() + msg.size());
+    rix::msg::Writer buffer;
+    op.serialize(buffer);
+    msg.serialize(buffer);
+    op.len = static_cast<uint32_t>(buffer.size() - op.size());
     size_t offset = 0;
     op.serialize(buffer.data(), offset);
-    msg.serialize(buffer.data(), offset);
 
     ssize_t bytes = client->write(buffer.data(), buffer.size());
     if (bytes != buffer.size()) {
@@ -123,5 +212,72 @@ static inline bool send_message_with_opcode(std::shared_ptr<rix::ipc::interfaces
     return true;
 }
 
+/**
+ * @brief Helper function to read exactly `len` bytes from a connection.
+ *
+ * @param conn The connection to read from
+ * @param dst The destination byte array
+ * @param len The number of bytes to read
+ * @return `true` if all bytes were read before an error or end of stream.
+ */
+static inline bool read_exact(std::shared_ptr<rix::ipc::interfaces::Connection> conn, uint8_t *dst, size_t len) {
+    size_t offset = 0;
+    while (offset < len) {
+        ssize_t bytes = conn->read(dst + offset, len - offset);
+        if (bytes <= 0) return false;
+        offset += static_cast<size_t>(bytes);
+    }
+    return true;
+}
+
+/**
+ * @brief Helper function to send a rix::msg::Message with the specified opcode
+ * to the specified endpoint using an unconnected client and read a response
+ * message.
+ *
+ * @details The server responds with a rix::msg::mediator::Status message. If
+ * the error field is 0, it is followed by the size of the response message
+ * (rix::msg::standard::UInt32) and the response message itself.
+ *
+ * @param client An unconnected client pointer
+ * @param msg The message to be sent
+ * @param opcode The opcode corresponding to the message (see `OPCODE` enum)
+ * @param endpoint The endpoint of the server to connect to
+ * @param response The message that the response is deserialized into
+ * @return `true` if the status error field is 0 and the response was read and
+ * deserialized successfully.
+ */
+static inline bool request_message_with_opcode(std::shared_ptr<rix::ipc::interfaces::Client> client,
+                                               const rix::msg::Message &msg, OPCODE opcode,
+                                               const rix::ipc::Endpoint &endpoint, rix::msg::Message &response) {
+    if (!send_message_with_opcode_no_response(client, msg, opcode, endpoint)) return false;
+
+    rix::msg::mediator::Status status;
+    std::vector<uint8_t> buffer(status.size());
+    size_t offset = 0;
+    if (!read_exact(client, buffer.data(), buffer.size()) || !status.deserialize(buffer.data(), buffer.size(), offset)) {
+        rix::util::Log::warn << "Failed to read from rixhub." << std::endl;
+        return false;
+    }
+    if (status.error != 0) {
+        return false;
+    }
+
+    rix::msg::standard::UInt32 size;
+    buffer.resize(size.size());
+    offset = 0;
+    if (!read_exact(client, buffer.data(), buffer.size()) || !size.deserialize(buffer.data(), buffer.size(), offset)) {
+        rix::util::Log::warn << "Failed to read from rixhub." << std::endl;
+        return false;
+    }
+    buffer.resize(size.data);
+    offset = 0;
+    if (!read_exact(client, buffer.data(), buffer.size()) || !response.deserialize(buffer.data(), buffer.size(), offset)) {
+        rix::util::Log::warn << "Failed to read from rixhub." << std::endl;
+        return false;
+    }
+    return true;
+}
+
 }  // namespace core
 }  // namespace rix
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "rix/msg/writer.hpp"
+
+namespace rix {
+namespace core {
+
+/**
+ * @brief Stateful compression of consecutive messages on one connection, used
+ * by publishers with the DELTA encoding.
+ *
+ * @details Each serialized message is sent as a frame whose first byte is a
+ * delta_frame::KIND:
+ *
+ *     KEYFRAME: [uint8 kind][serialized message]
+ *     DELTA:    [uint8 kind]([varint zeros][varint count][count bytes])...
+ *
+ * A DELTA frame is the XOR of the message with the previous message on the
+ * connection, run-length coded: each run skips `zeros` unchanged bytes and
+ * XORs the following `count` bytes. Unchanged bytes at the end are omitted.
+ * Varints are LEB128. A keyframe is sent for the first message, whenever the
+ * size of the message changes, and every `keyframe_interval` messages, so a
+ * receiver can always resynchronize.
+ *
+ * The connection must deliver frames in order and without loss, as TCP does.
+ */
+namespace delta_frame {
+enum KIND : uint8_t {
+    KEYFRAME = 0,
+    DELTA = 1,
+};
+}  // namespace delta_frame
+
+class DeltaEncoder {
+   public:
+    /**
+     * @brief Construct a new DeltaEncoder.
+     *
+     * @param keyframe_interval The number of messages after which a keyframe is sent
+     */
+    explicit DeltaEncoder(size_t keyframe_interval = 100);
+
+    /**
+     * @brief Appends the frame of a serialized message to `dst`.
+     *
+     * @param src The serialized message
+     * @param len The size of the serialized message
+     * @param dst The buffer that the frame is appended to
+     */
+    void encode(const uint8_t *src, size_t len, rix::msg::Writer &dst);
+
+   private:
+    size_t keyframe_interval_;
+    size_t since_keyframe_;
+    bool has_previous_;
+    std::vector<uint8_t> previous_;
+};
+
+class DeltaDecoder {
+   public:
+    DeltaDecoder();
+
+    /**
+     * @brief Decodes a frame written by DeltaEncoder::encode.
+     *
+     * @param src The frame
+     * @param len The size of the frame
+     * @return `true` if the frame was valid. The message is then available
+     * through data() and size() until the next call.
+     */
+    bool decode(const uint8_t *src, size_t len);
+
+    const uint8_t *data() const { return message_.data(); }
+    size_t size() const { return message_.size(); }
+
+   private:
+    bool has_keyframe_;
+    std::vector<uint8_t> message_;
+};
+
+}  // namespace core
+}  // namespace rix
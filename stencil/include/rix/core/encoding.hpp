@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "rix/core/common.hpp"
+#include "rix/msg/message.hpp"
+#include "rix/msg/quantize.hpp"
+#include "rix/msg/sensor/LaserScan.hpp"
+#include "rix/msg/serialization.hpp"
+#include "rix/msg/writer.hpp"
+
+namespace rix {
+namespace core {
+
+/**
+ * @brief The encodings supported by a message type.
+ *
+ * @details Every message supports RAW and DELTA. A message type can support
+ * other values of ENCODING by specializing Encoding. encode writes the message
+ * to `dst`, and decode reads the bytes written by encode back into a message.
+ * Subscribers decode according to the encoding each publisher registered, so
+ * callbacks always receive the plain message.
+ *
+ * DELTA is applied to the serialized message by each connection (see
+ * rix/core/delta.hpp), so it is never passed to encode or decode.
+ *
+ * @tparam TMsg The message type
+ */
+template <typename TMsg>
+struct Encoding {
+    static bool supports(uint8_t encoding) { return encoding == ENCODING::RAW || encoding == ENCODING::DELTA; }
+
+    static void encode(uint8_t encoding, const TMsg &msg, rix::msg::Writer &dst) { msg.serialize(dst); }
+
+    static bool decode(uint8_t encoding, TMsg &msg, const uint8_t *src, size_t size, size_t &offset) {
+        return encoding == ENCODING::RAW && msg.deserialize(src, size, offset);
+    }
+};
+
+/**
+ * @brief LaserScan supports QUANTIZED, which sends it as a
+ * rix::msg::sensor::QuantizedLaserScan.
+ *
+ * @details Ranges are quantized to uint16 millimetres, or coarser if the
+ * largest finite range exceeds 65.534 m, so the error of a range is at most
+ * half of range_scale. Readings that are not finite (NaN included) are
+ * received as positive infinity. Intensities are quantized to uint8 with a
+ * scale that maps the largest intensity to 255. This cuts the size of the
+ * arrays from 8 to 3 bytes per beam.
+ */
+template <>
+struct Encoding<rix::msg::sensor::LaserScan> {
+    static bool supports(uint8_t encoding) {
+        return encoding == ENCODING::RAW || encoding == ENCODING::QUANTIZED || encoding == ENCODING::DELTA;
+    }
+
+    static void encode(uint8_t encoding, const rix::msg::sensor::LaserScan &msg, rix::msg::Writer &dst) {
+        using namespace rix::msg::detail;
+        if (encoding != ENCODING::QUANTIZED) {
+            msg.serialize(dst);
+            return;
+        }
+        float range_scale = std::max(0.001f, max_finite(msg.ranges.data(), msg.ranges.size()) / QUANTIZED_U16_MAX);
+        float intensity_scale = max_finite(msg.intensities.data(), msg.intensities.size()) / 255.0f;
+        if (intensity_scale <= 0.0f) intensity_scale = 1.0f;
+
+        write_message(dst, msg.header);
+        write_fixed(dst, msg.angle_min, msg.angle_max, msg.angle_increment, msg.time_increment, msg.scan_time,
+                    msg.range_min, msg.range_max, range_scale, static_cast<uint32_t>(msg.ranges.size()));
+        quantize_u16(msg.ranges.data(), msg.ranges.size(), range_scale, dst.extend(2 * msg.ranges.size()));
+        write_fixed(dst, intensity_scale, static_cast<uint32_t>(msg.intensities.size()));
+        quantize_u8(msg.intensities.data(), msg.intensities.size(), intensity_scale,
+                    dst.extend(msg.intensities.size()));
+    }
+
+    static bool decode(uint8_t encoding, rix::msg::sensor::LaserScan &msg, const uint8_t *src, size_t size,
+                       size_t &offset) {
+        using namespace rix::msg::detail;
+        if (encoding == ENCODING::RAW) {
+            return msg.deserialize(src, size, offset);
+        }
+        if (encoding != ENCODING::QUANTIZED) {
+            return false;
+        }
+        float range_scale, intensity_scale;
+        uint32_t count;
+        if (!deserialize_message(msg.header, src, size, offset) ||
+            !deserialize_fixed(src, size, offset, msg.angle_min, msg.angle_max, msg.angle_increment,
+                               msg.time_increment, msg.scan_time, msg.range_min, msg.range_max, range_scale, count) ||
+            (size - offset) / 2 < count) {
+            return false;
+        }
+        msg.ranges.resize(count);
+        dequantize_u16(src + offset, count, range_scale, msg.ranges.data());
+        offset += 2 * count;
+
+        if (!deserialize_fixed(src, size, offset, intensity_scale, count) || size - offset < count) {
+            return false;
+        }
+        msg.intensities.resize(count);
+        dequantize_u8(src + offset, count, intensity_scale, msg.intensities.data());
+        offset += count;
+        return true;
+    }
+};
+
+}  // namespace core
+}  // namespace rix
@@ -6,6 +6,7 @@
 
 #include "rix/core/common.hpp"
 #include "rix/core/interfaces/spinner.hpp"
+#include "rix/core/stats.hpp"
 #include "rix/ipc/client_tcp.hpp"
 #include "rix/ipc/server_tcp.hpp"
 #include "rix/msg/mediator/NodeInfo.hpp"
@@ -13,7 +14,9 @@
 #include "rix/msg/mediator/PubInfo.hpp"
 #include "rix/msg/mediator/Status.hpp"
 #include "rix/msg/mediator/SubInfo.hpp"
+#include "rix/msg/mediator/SrvInfo.hpp"
 #include "rix/msg/mediator/SubNotify.hpp"
+#include "rix/msg/stats/MediatorStatistics.hpp"
 
 namespace rix {
 namespace core {
@@ -89,24 +92,71 @@ class Mediator : public interfaces::Spinner {
      *               'endpoint' field in the SubInfo to send a
      *               rix::msg::mediator::SubNotify message to the subscriber
      *               that contains the PubInfo of the new publisher.
+     *        SRV_REGISTER: rix::msg::mediator::SrvInfo
+     *            1. Check that no other service is registered with the same
+     *               name.
+     *            2. If valid, insert the SrvInfo into the services_ map.
+     *            3. Respond with a rix::msg::mediator::Status message. If an
+     *               error occured during registration, set the 'error' field
+     *               to a nonzero value.
+     *        SRV_LOOKUP: rix::msg::mediator::SrvInfo
+     *            1. Find the service with the requested name and check that
+     *               its request and response hashes match.
+     *            2. Respond with a rix::msg::mediator::Status message. If the
+     *               service was found, follow it with the size of the
+     *               registered SrvInfo and the SrvInfo itself.
+     *        TOPIC_LOOKUP: rix::msg::mediator::TopicInfo
+     *            1. Find the message hash registered for the requested topic
+     *               name.
+     *            2. Respond with a rix::msg::mediator::Status message. If the
+     *               topic is known, follow it with the size of a TopicInfo
+     *               and the TopicInfo, which holds the encoding of a
+     *               publisher of the topic if there is one.
      *        NODE_DEREGISTER: rix::msg::mediator::NodeInfo
      *           1. Erase the NodeInfo from the nodes_ map.
      *        SUB_DEREGISTER: rix::msg::mediator::SubInfo
      *           1. Erase the SubInfo from the subscribers_ map.
      *        PUB_DEREGISTER: rix::msg::mediator::PubInfo
      *           1. Erase the PubInfo from the publishers_ map.
+     *        SRV_DEREGISTER: rix::msg::mediator::SrvInfo
+     *           1. Erase the SrvInfo from the services_ map.
      */
     virtual void spin_once() override;
 
+    /**
+     * @brief Returns the size of the registry and the latency of the requests
+     * handled so far. May be called while another thread spins the Mediator.
+     *
+     */
+    rix::msg::stats::MediatorStatistics stats() const;
+
    private:
     std::shared_ptr<rix::ipc::interfaces::Server> server_;        /**< The server for registry of new components */
     ClientFactory client_factory_;                                /**< The factory method to create new clients */
     std::map<uint64_t, rix::msg::mediator::NodeInfo> nodes_;      /**< Active nodes (lookup by node ID) */
     std::map<uint64_t, rix::msg::mediator::PubInfo> publishers_;  /**< Active publishers (lookup by publisher ID) */
     std::map<uint64_t, rix::msg::mediator::SubInfo> subscribers_; /**< Active subscribers (lookup by subscriber ID) */
+    std::map<uint64_t, rix::msg::mediator::SrvInfo> services_;    /**< Active services (lookup by service ID) */
     std::map<std::string, std::array<uint64_t, 2>> topic_hashes_; /**< Message hashes (lookup by topic name) */
     std::atomic<bool> shutdown_flag_;
 
+    /**
+     * @brief Statistics for stats(). They are written by the spinning thread
+     * only, and the registry sizes are copied after every request so that
+     * stats() does not read the maps.
+     */
+    Counter registrations_;
+    Counter failures_;
+    LatencyHistogram registration_latency_;
+    std::array<std::atomic<uint32_t>, 5> registry_sizes_{}; /**< nodes, publishers, subscribers, services, topics */
+
+    /**
+     * @brief Records a request that was accepted at `start` (see
+     * CallbackStats::now()) and copies the sizes of the registry.
+     *
+     */
+    void record_request(int64_t start);
+
     /**
      * @brief Helper function to send the PubInfo to each subscriber. Each
      * subscriber in the vector should have the same topic as the publisher.
@@ -160,6 +210,18 @@ class Mediator : public interfaces::Spinner {
      * @param status The Status message to send
      */
     void send_status_message(std::shared_ptr<rix::ipc::interfaces::Connection> conn, rix::msg::mediator::Status status);
+
+    /**
+     * @brief Helper function to send a successful Status message followed by
+     * a size-prefixed response message to a Connection.
+     *
+     * @details This is the response format read by
+     * rix::core::request_message_with_opcode.
+     *
+     * @param conn The connection to which to send the response
+     * @param msg The response message
+     */
+    void send_response_message(std::shared_ptr<rix::ipc::interfaces::Connection> conn, const rix::msg::Message &msg);
 };
 
 }  // namespace core
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace rix {
+namespace core {
+
+/**
+ * @brief A small pool of messages that are reused across receives.
+ *
+ * @details Deserializing into a fresh message allocates every vector and
+ * string field again. Deserializing into a message that was used before
+ * resizes those fields instead, so once the pool has seen the largest message
+ * on a topic, receiving does not allocate. A message is free when the pool
+ * holds the only reference to it. Callbacks that keep the shared_ptr of a
+ * message simply keep it out of the pool until they release it; no custom
+ * deleter is needed.
+ *
+ * @tparam TMsg The message type
+ */
+template <typename TMsg>
+class MessagePool {
+   public:
+    /**
+     * @brief Construct a new MessagePool.
+     *
+     * @param capacity The maximum number of messages the pool keeps. When
+     * every pooled message is still referenced elsewhere, acquire() returns a
+     * new message that is not kept.
+     */
+    explicit MessagePool(size_t capacity = 4) : capacity_(capacity) {}
+
+    /**
+     * @brief Returns a message that is not referenced outside the pool. Its
+     * fields hold the values of its previous use.
+     *
+     * @return std::shared_ptr<TMsg>
+     */
+    std::shared_ptr<TMsg> acquire() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        for (const auto &msg : messages_) {
+            if (msg.use_count() == 1) return msg;
+        }
+        auto msg = std::make_shared<TMsg>();
+        if (messages_.size() < capacity_) messages_.push_back(msg);
+        return msg;
+    }
+
+    /**
+     * @brief Returns the number of messages kept by the pool.
+     *
+     */
+    size_t size() const {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return messages_.size();
+    }
+
+   private:
+    size_t capacity_;
+    std::vector<std::shared_ptr<TMsg>> messages_;
+    mutable std::mutex mutex_;
+};
+
+}  // namespace core
+}  // namespace rix
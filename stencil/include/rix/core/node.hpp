@@ -5,13 +5,20 @@
 #include <set>
 
 #include "rix/core/common.hpp"
+#include "rix/core/pose_buffer.hpp"
 #include "rix/core/publisher.hpp"
+#include "rix/core/service.hpp"
+#include "rix/core/service_client.hpp"
 #include "rix/core/subscriber.hpp"
+#include "rix/core/synchronizer.hpp"
 #include "rix/core/timer.hpp"
+#include "rix/core/transport.hpp"
 #include "rix/ipc/client_tcp.hpp"
 #include "rix/ipc/server_tcp.hpp"
 #include "rix/msg/mediator/NodeInfo.hpp"
+#include "rix/msg/stats/NodeStatistics.hpp"
 #include "rix/util/log.hpp"
+#include "rix/util/trace.hpp"
 
 namespace rix {
 namespace core {
@@ -71,6 +78,105 @@ class Node : public interfaces::Spinner {
     std::shared_ptr<Subscriber> create_subscriber(const std::string &topic, std::function<void(const TMsg &)> callback,
                                                   const rix::ipc::Endpoint &endpoint = rix::ipc::Endpoint("127.0.0.1",
                                                                                                           0));
+
+    /**
+     * @brief Subscriber factory method for callbacks that receive pooled
+     * messages by shared_ptr.
+     *
+     * @details The callback may keep the message after it returns. The message
+     * is reused for later receives once every copy of the shared_ptr has been
+     * released.
+     *
+     * @tparam TMsg The message type of the topic
+     * @param topic The topic to subscribe to
+     * @param callback The callback function to be invoked upon receiving a message from a publisher
+     * @param endpoint The endpoint that the subscriber server will host on (used for notification of new publishers).
+     * @return std::shared_ptr<Subscriber>
+     */
+    template <typename TMsg>
+    std::shared_ptr<Subscriber> create_subscriber(const std::string &topic,
+                                                  std::function<void(std::shared_ptr<const TMsg>)> callback,
+                                                  const rix::ipc::Endpoint &endpoint = rix::ipc::Endpoint("127.0.0.1",
+                                                                                                          0));
+
+    /**
+     * @brief Subscriber factory method for callbacks that receive serialized
+     * messages (see Subscriber::set_serialized_callback).
+     *
+     * @details The message type is not known at compile time, so the topic
+     * info must hold the message hash of the topic, e.g. from lookup_topic.
+     *
+     * @param topic_info The topic to subscribe to and its message hash
+     * @param callback The callback function to be invoked upon receiving a message from a publisher
+     * @param endpoint The endpoint that the subscriber server will host on (used for notification of new publishers).
+     * @return std::shared_ptr<Subscriber>
+     */
+    std::shared_ptr<Subscriber> create_subscriber(const rix::msg::mediator::TopicInfo &topic_info,
+                                                  Subscriber::SerializedCallback callback,
+                                                  const rix::ipc::Endpoint &endpoint = rix::ipc::Endpoint("127.0.0.1",
+                                                                                                          0));
+
+    /**
+     * @brief Publisher factory method for messages that are already
+     * serialized (see Publisher::publish_serialized).
+     *
+     * @param topic_info The topic to publish on, its message hash and the
+     * encoding of the messages
+     * @param endpoint The endpoint that the publisher server will host on.
+     * @return std::shared_ptr<Publisher>
+     */
+    std::shared_ptr<Publisher> create_serialized_publisher(const rix::msg::mediator::TopicInfo &topic_info,
+                                                           const rix::ipc::Endpoint &endpoint =
+                                                               rix::ipc::Endpoint("127.0.0.1", 0));
+
+    /**
+     * @brief Looks up the message hash that rixhub registered for a topic.
+     *
+     * @details A topic is registered by its first publisher or subscriber.
+     * The encoding is set to that of one of its publishers, or RAW if it has
+     * none.
+     *
+     * @param topic The name of the topic
+     * @param info Set to the info of the topic if it is registered
+     * @return true if the topic is registered
+     */
+    bool lookup_topic(const std::string &topic, rix::msg::mediator::TopicInfo &info);
+
+    /**
+     * @brief Service factory method.
+     *
+     * @details Registers a service with rixhub. Clients created with
+     * create_client on any node can then send requests to it. The callback is
+     * invoked in the thread that calls Node::spin().
+     *
+     * @tparam TReq The request message type
+     * @tparam TRes The response message type
+     * @param name The name of the service
+     * @param callback The callback that fills in the response. Return false to
+     * report a failure to the client.
+     * @param endpoint The endpoint that the service server will host on.
+     * @return std::shared_ptr<Service>
+     */
+    template <typename TReq, typename TRes>
+    std::shared_ptr<Service> create_service(const std::string &name,
+                                            std::function<bool(const TReq &, TRes &)> callback,
+                                            const rix::ipc::Endpoint &endpoint = rix::ipc::Endpoint("127.0.0.1", 0));
+
+    /**
+     * @brief Service client factory method.
+     *
+     * @details The client looks up the service with rixhub and keeps a
+     * persistent connection to it. If the service is not registered yet, the
+     * lookup is retried while the node spins.
+     *
+     * @tparam TReq The request message type
+     * @tparam TRes The response message type
+     * @param name The name of the service
+     * @return std::shared_ptr<ServiceClient>
+     */
+    template <typename TReq, typename TRes>
+    std::shared_ptr<ServiceClient> create_client(const std::string &name);
+
     /**
      * @brief Factory method for Timer.
      *
@@ -83,6 +189,124 @@ class Node : public interfaces::Spinner {
      */
     std::shared_ptr<Timer> create_timer(const rix::util::Duration &d, Timer::Callback callback);
 
+    /**
+     * @brief Factory method for PoseBuffer.
+     *
+     * @details Creates a Subscriber on a Pose2DStamped topic that inserts each
+     * received pose into a PoseBuffer. The buffer can then be queried from any
+     * thread for the pose at a given time. The Subscriber is shut down when the
+     * PoseBuffer is destroyed.
+     *
+     * @param topic The Pose2DStamped topic to subscribe to
+     * @param capacity The number of poses kept in the window
+     * @param endpoint The endpoint that the subscriber server will host on
+     * @return std::shared_ptr<PoseBuffer> nullptr if the subscriber failed to be created
+     */
+    std::shared_ptr<PoseBuffer> create_pose_buffer(const std::string &topic, size_t capacity,
+                                                   const rix::ipc::Endpoint &endpoint = rix::ipc::Endpoint("127.0.0.1",
+                                                                                                           0));
+
+    /**
+     * @brief Factory method for Synchronizer.
+     *
+     * @details Creates one Subscriber per topic and feeds the received
+     * messages into a Synchronizer. The callback is invoked with one message
+     * from each topic whenever a set is matched according to the policy. The
+     * Subscribers are shut down when the Synchronizer is destroyed.
+     *
+     * @tparam TMsgs The message types of each topic, in order
+     * @param topics The topics to subscribe to
+     * @param callback The callback function to be invoked with each matched set
+     * @param policy The matching policy
+     * @param queue_size The capacity of each per-topic queue
+     * @param max_interval The maximum spread of a matched set (APPROXIMATE_TIME only, zero disables)
+     * @return std::shared_ptr<Synchronizer<TMsgs...>> nullptr if any subscriber failed to be created
+     */
+    template <typename... TMsgs>
+    std::shared_ptr<Synchronizer<TMsgs...>> create_synchronizer(
+        const std::array<std::string, sizeof...(TMsgs)> &topics, typename Synchronizer<TMsgs...>::Callback callback,
+        SyncPolicy policy = SyncPolicy::APPROXIMATE_TIME, size_t queue_size = 16,
+        const rix::util::Duration &max_interval = rix::util::Duration(0.0));
+
+    /**
+     * @brief Sets the encoding of the publishers of `topic` that are created
+     * after this call.
+     *
+     * @details The encoding is registered with the Mediator as part of the
+     * topic info of each publisher, and subscribers decode each publisher's
+     * messages accordingly, so callbacks are unaffected. If the message type
+     * of a publisher does not support the encoding (see rix/core/encoding.hpp),
+     * it publishes RAW messages.
+     *
+     * @param topic The topic
+     * @param encoding The encoding of its messages
+     */
+    void set_encoding(const std::string &topic, ENCODING encoding);
+
+    /**
+     * @brief Multiplex the topics of this node over one connection per node.
+     *
+     * @details Publishers created after this call register with the TCP_MUX
+     * protocol. Instead of hosting a server per publisher, they share the
+     * node's Transport server at `endpoint`. A subscribing node opens a single
+     * connection to this node (or reuses the one this node opened to it) and
+     * receives every topic over it. Frames are tagged with a channel and
+     * demultiplexed on receive, and the frames queued for a node during a spin
+     * are written with a single write at the end of spin_once.
+     *
+     * Subscribers of every node can receive from multiplexed publishers, so
+     * this only needs to be enabled on the publishing side.
+     *
+     * @param endpoint The endpoint that the transport server will host on.
+     * @return std::shared_ptr<Transport> The node's Transport, nullptr if the
+     * server could not be created.
+     */
+    std::shared_ptr<Transport> enable_multiplexing(const rix::ipc::Endpoint &endpoint = rix::ipc::Endpoint("127.0.0.1",
+                                                                                                            0));
+
+    /**
+     * @brief Returns the statistics of the publishers and subscribers of this
+     * node that still exist, publishers first.
+     *
+     * @details Every publisher and subscriber keeps a TopicStats, which is
+     * updated on each message with a few relaxed atomic stores and no locks.
+     * This function reads them without locks too, and only holds the lock of
+     * the list of publishers and subscribers, so it may be called while
+     * another thread spins the node or creates components.
+     *
+     */
+    std::vector<TopicStats::Snapshot> stats() const;
+
+    /**
+     * @brief Returns the execution time statistics of the callbacks of the
+     * timers, subscribers and services of this node, in the order they were
+     * created. See CallbackStats.
+     *
+     * @details Like stats(), this reads the statistics without locks and
+     * holds the lock of the list of components while it reads them.
+     *
+     */
+    std::vector<CallbackStats::Snapshot> callback_stats() const;
+
+    /**
+     * @brief Publishes the statistics of this node periodically as a
+     * rix::msg::stats::NodeStatistics on STATS_TOPIC_PREFIX + the node name,
+     * e.g. /rix/stats/planner.
+     *
+     * @details Each report covers the publishers and subscribers (messages,
+     * bytes, rates since the previous report, connections, queued bytes and
+     * latency percentiles) and the callbacks (see callback_stats()) of the
+     * node. Reports are built in Node::spin_once, so the overhead is one
+     * message per `period` with at most `max_entries` topics and
+     * `max_entries` callbacks. Calling this again changes the period and the
+     * limit.
+     *
+     * @param period The time between reports
+     * @param max_entries The maximum number of topics and of callbacks in a report
+     * @return false if the publisher could not be created
+     */
+    bool enable_stats(const rix::util::Duration &period = rix::util::Duration(1.0), size_t max_entries = 64);
+
     /**
      * @brief Returns true if the Node has not been shut down.
      *
@@ -108,6 +332,11 @@ class Node : public interfaces::Spinner {
      * all Publisher and Subscriber objects are tied to the lifetime of the Node
      * that they are created from, unless they are shutdown by the user.
      *
+     * The Transport is spun after all components so that messages published
+     * during this iteration are written in one batch per connection. Likewise,
+     * publishers with batching enabled write their buffers at the end of the
+     * iteration once their latency has elapsed.
+     *
      */
     virtual void spin_once() override;
 
@@ -117,6 +346,18 @@ class Node : public interfaces::Spinner {
     ClientFactory client_factory_;      /**< Client factory used to connect to the Mediator */
     std::vector<std::shared_ptr<interfaces::Spinner>> components_; /**< Set of Spinner interface pointers. */
     rix::ipc::Endpoint rixhub_endpoint_; /**< Endpoint of the rixhub instance (the Mediator's server). */
+    std::shared_ptr<Transport> transport_; /**< Shared connections for TCP_MUX publishers and subscribers */
+    std::vector<std::weak_ptr<Publisher>> publishers_;   /**< Publishers that may have batched messages */
+    std::vector<std::weak_ptr<Subscriber>> subscribers_; /**< Subscribers, for stats() */
+    mutable std::mutex components_mutex_; /**< Guards components_, publishers_ and subscribers_ */
+    std::vector<std::shared_ptr<interfaces::Spinner>> spinning_; /**< Copy of components_ used by spin_once */
+    std::map<std::string, ENCODING> encodings_;        /**< Topic -> encoding of new publishers */
+    std::shared_ptr<Publisher> stats_publisher_;       /**< Publisher of enable_stats, if enabled */
+    rix::util::Duration stats_period_;
+    rix::util::Time stats_last_;
+    size_t stats_max_entries_ = 0;
+    std::map<const TopicStats *, std::array<uint64_t, 2>> stats_previous_; /**< Messages and bytes at the last report */
+    rix::msg::stats::NodeStatistics stats_message_; /**< Reused for every report */
     std::atomic<bool> shutdown_flag_;
 
     /**
@@ -129,6 +370,12 @@ class Node : public interfaces::Spinner {
      */
     static uint64_t generate_id();
 
+    /**
+     * @brief Publishes a report of enable_stats.
+     *
+     */
+    void publish_stats();
+
     /**
      * @brief Factory method for Publisher.
      *
@@ -178,6 +425,29 @@ class Node : public interfaces::Spinner {
     std::shared_ptr<Subscriber> create_subscriber(const rix::msg::mediator::TopicInfo &topic_info,
                                                   const rix::ipc::Endpoint &endpoint);
 
+    /**
+     * @brief Factory method for Service.
+     *
+     * @param info The service information (name and message hashes).
+     * @param endpoint The endpoint that the service server will host on.
+     * @return std::shared_ptr<Service> A shared pointer to a Service object.
+     */
+    std::shared_ptr<Service> create_service(const rix::msg::mediator::SrvInfo &info,
+                                            const rix::ipc::Endpoint &endpoint);
+
+    /**
+     * @brief Factory method for ServiceClient.
+     *
+     * @param info The service information (name and message hashes).
+     * @return std::shared_ptr<ServiceClient> A shared pointer to a ServiceClient object.
+     */
+    std::shared_ptr<ServiceClient> create_client(const rix::msg::mediator::SrvInfo &info);
+
+    template <typename... TMsgs, size_t... Is>
+    bool create_synchronizer_subscribers(const std::shared_ptr<Synchronizer<TMsgs...>> &sync,
+                                         const std::array<std::string, sizeof...(TMsgs)> &topics,
+                                         std::index_sequence<Is...>);
+
    protected:
     static inline ServerFactory make_server_default{
         [](const rix::ipc::Endpoint &endpoint) { return std::make_shared<rix::ipc::ServerTCP>(endpoint); }};
@@ -192,8 +462,33 @@ std::shared_ptr<Publisher> Node::create_publisher(const std::string &topic, cons
     topic_info.name = topic;
     topic_info.message_hash = TMsg().hash();
 
+    auto it = encodings_.find(topic);
+    if (it != encodings_.end()) {
+        if (Encoding<TMsg>::supports(it->second)) {
+            topic_info.encoding = it->second;
+        } else {
+            rix::util::Log::warn << "Encoding " << it->second << " is not supported on \"" << topic
+                                 << "\", publishing raw messages." << std::endl;
+        }
+    }
+
     // Invoke private implementation
-    return create_publisher(topic_info, endpoint);
+    auto pub = create_publisher(topic_info, endpoint);
+
+    // Set encoder (need template info to do this)
+    if (pub && topic_info.encoding != ENCODING::RAW && topic_info.encoding != ENCODING::DELTA) {
+        uint8_t encoding = topic_info.encoding;
+        pub->encoder_ = [encoding](const rix::msg::Message &msg, rix::msg::Writer &dst) {
+            auto typed = dynamic_cast<const TMsg *>(&msg);
+            if (!typed) {
+                rix::util::Log::warn << "Message type mismatch in publish." << std::endl;
+                msg.serialize(dst);
+                return;
+            }
+            Encoding<TMsg>::encode(encoding, *typed, dst);
+        };
+    }
+    return pub;
 }
 
 template <typename TMsg>
@@ -215,5 +510,76 @@ std::shared_ptr<Subscriber> Node::create_subscriber(const std::string &topic,
     return sub;
 }
 
+template <typename TMsg>
+std::shared_ptr<Subscriber> Node::create_subscriber(const std::string &topic,
+                                                    std::function<void(std::shared_ptr<const TMsg>)> callback,
+                                                    const rix::ipc::Endpoint &endpoint) {
+    static_assert(std::is_base_of<rix::msg::Message, TMsg>::value, "TMsg must be a subclass of rix::msg::Message.");
+    rix::msg::mediator::TopicInfo topic_info;
+    topic_info.name = topic;
+    topic_info.message_hash = TMsg().hash();
+
+    auto sub = create_subscriber(topic_info, endpoint);
+    if (sub) sub->set_callback(callback);
+    return sub;
+}
+
+template <typename TReq, typename TRes>
+std::shared_ptr<Service> Node::create_service(const std::string &name,
+                                              std::function<bool(const TReq &, TRes &)> callback,
+                                              const rix::ipc::Endpoint &endpoint) {
+    static_assert(std::is_base_of<rix::msg::Message, TReq>::value, "TReq must be a subclass of rix::msg::Message.");
+    static_assert(std::is_base_of<rix::msg::Message, TRes>::value, "TRes must be a subclass of rix::msg::Message.");
+    rix::msg::mediator::SrvInfo info;
+    info.name = name;
+    info.request_hash = TReq().hash();
+    info.response_hash = TRes().hash();
+
+    auto srv = create_service(info, endpoint);
+    if (srv) srv->set_callback(callback);
+    return srv;
+}
+
+template <typename TReq, typename TRes>
+std::shared_ptr<ServiceClient> Node::create_client(const std::string &name) {
+    static_assert(std::is_base_of<rix::msg::Message, TReq>::value, "TReq must be a subclass of rix::msg::Message.");
+    static_assert(std::is_base_of<rix::msg::Message, TRes>::value, "TRes must be a subclass of rix::msg::Message.");
+    rix::msg::mediator::SrvInfo info;
+    info.name = name;
+    info.request_hash = TReq().hash();
+    info.response_hash = TRes().hash();
+    return create_client(info);
+}
+
+template <typename... TMsgs>
+std::shared_ptr<Synchronizer<TMsgs...>> Node::create_synchronizer(
+    const std::array<std::string, sizeof...(TMsgs)> &topics, typename Synchronizer<TMsgs...>::Callback callback,
+    SyncPolicy policy, size_t queue_size, const rix::util::Duration &max_interval) {
+    auto sync = std::make_shared<Synchronizer<TMsgs...>>(policy, callback, queue_size, max_interval);
+    if (!create_synchronizer_subscribers(sync, topics, std::index_sequence_for<TMsgs...>{})) {
+        return nullptr;
+    }
+    return sync;
+}
+
+template <typename... TMsgs, size_t... Is>
+bool Node::create_synchronizer_subscribers(const std::shared_ptr<Synchronizer<TMsgs...>> &sync,
+                                           const std::array<std::string, sizeof...(TMsgs)> &topics,
+                                           std::index_sequence<Is...>) {
+    // The subscriber callbacks only hold a weak reference so that the
+    // Synchronizer (and its subscribers) can be released by the user.
+    std::weak_ptr<Synchronizer<TMsgs...>> weak = sync;
+    ((sync->subscribers_[Is] = create_subscriber<typename Synchronizer<TMsgs...>::template MessageType<Is>>(
+          topics[Is],
+          [weak](const typename Synchronizer<TMsgs...>::template MessageType<Is> &msg) {
+              if (auto s = weak.lock()) s->template add<Is>(msg);
+          })),
+     ...);
+    for (const auto &sub : sync->subscribers_) {
+        if (!sub || !sub->ok()) return false;
+    }
+    return true;
+}
+
 }  // namespace core
 }  // namespace rix
\ No newline at end of file
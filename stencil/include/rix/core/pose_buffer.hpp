@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "rix/core/subscriber.hpp"
+#include "rix/msg/geometry/Pose2D.hpp"
+#include "rix/msg/geometry/Pose2DStamped.hpp"
+#include "rix/util/time.hpp"
+
+namespace rix {
+namespace core {
+
+namespace detail {
+
+inline double wrap_angle(double a) {
+    a = std::fmod(a + M_PI, 2.0 * M_PI);
+    if (a < 0) a += 2.0 * M_PI;
+    return a - M_PI;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Interpolates between two poses along the SE(2) geodesic.
+ *
+ * @details The relative transform from `p0` to `p1` is mapped to a twist
+ * (log map), scaled by `alpha`, and mapped back onto the group (exp map). This
+ * moves along the constant-curvature arc between the poses rather than
+ * interpolating position and heading independently.
+ *
+ * @param p0 The pose at alpha = 0
+ * @param p1 The pose at alpha = 1
+ * @param alpha The interpolation parameter, in [0, 1]
+ * @return rix::msg::geometry::Pose2D The interpolated pose
+ */
+inline rix::msg::geometry::Pose2D interpolate(const rix::msg::geometry::Pose2D &p0,
+                                              const rix::msg::geometry::Pose2D &p1, double alpha) {
+    const double c0 = std::cos(p0.theta), s0 = std::sin(p0.theta);
+    const double gx = p1.x - p0.x, gy = p1.y - p0.y;
+
+    // Relative transform expressed in the frame of p0
+    const double dx = c0 * gx + s0 * gy;
+    const double dy = -s0 * gx + c0 * gy;
+    const double dth = detail::wrap_angle(p1.theta - p0.theta);
+
+    // Log map: solve V * v = d for the translational twist v
+    double vx = dx, vy = dy;
+    if (std::abs(dth) > 1e-9) {
+        const double a = std::sin(dth) / dth, b = (1.0 - std::cos(dth)) / dth;
+        const double det = a * a + b * b;
+        vx = (a * dx + b * dy) / det;
+        vy = (-b * dx + a * dy) / det;
+    }
+
+    // Exp map of the scaled twist
+    const double w = alpha * dth;
+    vx *= alpha;
+    vy *= alpha;
+    double lx = vx, ly = vy;
+    if (std::abs(w) > 1e-9) {
+        const double a = std::sin(w) / w, b = (1.0 - std::cos(w)) / w;
+        lx = a * vx - b * vy;
+        ly = b * vx + a * vy;
+    }
+
+    rix::msg::geometry::Pose2D out;
+    out.x = static_cast<float>(p0.x + c0 * lx - s0 * ly);
+    out.y = static_cast<float>(p0.y + s0 * lx + c0 * ly);
+    out.theta = static_cast<float>(detail::wrap_angle(p0.theta + w));
+    return out;
+}
+
+/**
+ * @brief A time-indexed window of poses that supports O(log n) lookup of the
+ * pose at an arbitrary time.
+ *
+ * @details Poses are kept in a contiguous ring sorted by stamp. Storage is
+ * allocated once, so inserting never allocates. There must be a single writer
+ * (normally the Node spin thread through the Subscriber created by
+ * Node::create_pose_buffer). Any number of threads may call lookup()
+ * concurrently with the writer: the read path is protected by a sequence lock,
+ * so readers never block the writer and take no locks themselves. A reader
+ * that overlaps a write simply retries.
+ *
+ */
+class PoseBuffer {
+   public:
+    /**
+     * @brief Construct a new PoseBuffer.
+     *
+     * @param capacity The number of poses kept in the window
+     */
+    explicit PoseBuffer(size_t capacity);
+
+    PoseBuffer(const PoseBuffer &) = delete;
+    PoseBuffer &operator=(const PoseBuffer &) = delete;
+    ~PoseBuffer();
+
+    /**
+     * @brief Insert a pose. Poses are expected in stamp order; an out of order
+     * pose is inserted in place. A pose older than the whole window of a full
+     * buffer is dropped. A pose with the same stamp as an existing entry
+     * replaces it.
+     *
+     * @param msg The stamped pose
+     * @return `true` if the pose was stored.
+     */
+    bool insert(const rix::msg::geometry::Pose2DStamped &msg);
+
+    /**
+     * @brief Look up the pose at time `t` by interpolating between the two
+     * surrounding entries.
+     *
+     * @param t The query time. Must lie within [oldest(), newest()].
+     * @param pose The interpolated pose
+     * @return `false` if the buffer is empty or `t` is outside the window.
+     */
+    bool lookup(const rix::util::Time &t, rix::msg::geometry::Pose2D &pose) const;
+
+    /**
+     * @brief Returns the stamps of the oldest and newest poses in the window.
+     *
+     * @return `false` if the buffer is empty.
+     */
+    bool window(rix::util::Time &oldest, rix::util::Time &newest) const;
+
+    size_t size() const;
+    size_t capacity() const;
+
+   private:
+    friend class Node;
+
+    /**
+     * @brief Each field is an atomic so that a reader racing with the writer
+     * reads torn data (which the sequence check then rejects) rather than
+     * causing undefined behavior. All accesses are relaxed.
+     */
+    struct Entry {
+        std::atomic<int64_t> stamp{0};
+        std::atomic<float> x{0.0f};
+        std::atomic<float> y{0.0f};
+        std::atomic<float> theta{0.0f};
+    };
+
+    std::vector<Entry> entries_;
+    std::atomic<size_t> head_;
+    std::atomic<size_t> size_;
+    std::atomic<uint64_t> sequence_; /**< Odd while a write is in progress */
+    std::shared_ptr<Subscriber> subscriber_;
+
+    Entry &at(size_t i) { return entries_[(head_.load(std::memory_order_relaxed) + i) % entries_.size()]; }
+    const Entry &at(size_t i, size_t head) const { return entries_[(head + i) % entries_.size()]; }
+    void copy(Entry &dst, const Entry &src);
+};
+
+}  // namespace core
+}  // namespace rix
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <span>
 
 #include "rix/core/common.hpp"
+#include "rix/core/delta.hpp"
 #include "rix/core/interfaces/spinner.hpp"
+#include "rix/core/stats.hpp"
+#include "rix/core/transport.hpp"
 #include "rix/ipc/interfaces/client.hpp"
 #include "rix/ipc/interfaces/server.hpp"
 #include "rix/msg/mediator/Operation.hpp"
@@ -14,6 +20,7 @@
 #include "rix/msg/mediator/SubInfo.hpp"
 #include "rix/msg/standard/UInt32.hpp"
 #include "rix/util/log.hpp"
+#include "rix/util/trace.hpp"
 
 namespace rix {
 namespace core {
@@ -51,13 +58,88 @@ class Publisher : public interfaces::Spinner {
      * @details First, this function will check that the input message hash
      * matches the message hash of the topic that this publisher is publishing
      * on. Then, if the hashes match, it will serialize the specified message
-     * with the message size prefixed and send the data to each connection. If
+     * in a data_frame and send the data to each connection. If
      * a connection is not writable, erase it from the set.
      *
+     * Multiplexed publishers (TCP_MUX) instead queue the message on the Node's
+     * Transport, which writes it at the end of the current spin together with
+     * the messages of other topics sent to the same node.
+     *
      * @param msg The message to be published
      */
     void publish(const rix::msg::Message &msg);
 
+    /**
+     * @brief Publish a message that is already serialized.
+     *
+     * @details The bytes are sent as they are, so they must be a message of
+     * the topic's type in the encoding that the publisher registered, e.g. a
+     * message recorded by a subscriber of the topic (see rixbag).
+     *
+     * @param data The serialized message
+     * @param len The size of the serialized message
+     */
+    void publish_serialized(const uint8_t *data, size_t len);
+
+    /**
+     * @brief Publish a burst of messages on the topic.
+     *
+     * @details The messages are serialized into one buffer per connection,
+     * under a single lock, and each buffer is written with one system call.
+     * The wire format is the same as for consecutive calls to publish, so
+     * subscribers receive one callback per message, in order. If batching is
+     * enabled, the messages are added to the batch instead (see set_batching).
+     *
+     * @tparam TMsg The message type, e.g. `publish_batch<Pose2DStamped>(poses)`
+     * @param msgs The messages to be published
+     */
+    template <typename TMsg>
+    void publish_batch(std::span<const TMsg> msgs) {
+        publish_batch(msgs.size(), [&](size_t i) -> const rix::msg::Message & { return msgs[i]; });
+    }
+
+    /**
+     * @brief Enable batching of small messages.
+     *
+     * @details By default, every call to publish writes the message to every
+     * connection, which costs one system call per subscriber per message. With
+     * batching enabled, publish appends the framed message to a buffer per
+     * connection instead. The buffers are written when
+     *
+     * 1. a buffer holds at least `max_bytes`,
+     * 2. the oldest buffered message has waited for `max_latency` (checked on
+     *    publish and at the end of every Node::spin_once), or
+     * 3. flush is called.
+     *
+     * With a `max_latency` of zero, the buffers are written at the end of the
+     * spin iteration in which the messages were published. The wire format
+     * does not change, so subscribers are unaffected. This has no effect on
+     * multiplexed publishers, which are always batched by their Transport.
+     *
+     * @param max_bytes The buffer size that triggers a write. 0 disables batching.
+     * @param max_latency The maximum time a message is buffered while the Node spins
+     */
+    void set_batching(size_t max_bytes, const rix::util::Duration &max_latency = rix::util::Duration(0.0));
+
+    /**
+     * @brief Enable send timestamps in the frames of this publisher.
+     *
+     * @details Every frame carries the time of the publish call (see
+     * data_frame), from which subscribers on the same machine record the
+     * delivery latency and the queueing delay before their callback in
+     * TopicStats. This adds 8 bytes and one clock read per message. Frames of
+     * multiplexed publishers (TCP_MUX) are not timestamped.
+     *
+     * @param enabled True to add timestamps to the following messages
+     */
+    void set_timestamping(bool enabled);
+
+    /**
+     * @brief Write all buffered messages. Does nothing if batching is disabled.
+     *
+     */
+    void flush();
+
     /**
      * @brief Returns the number of subscribers that this publisher is 
      * currently connected to.
@@ -65,13 +147,49 @@ class Publisher : public interfaces::Spinner {
      */
     size_t get_subscriber_count() const;
 
+    /**
+     * @brief Returns the statistics of this publisher. See TopicStats.
+     *
+     */
+    const TopicStats &stats() const;
+
+    /**
+     * @brief Returns the number of bytes that are batched but not yet
+     * written, summed over all subscribers. Multiplexed publishers queue in
+     * the Node's Transport and return 0.
+     *
+     */
+    size_t get_queued_bytes() const;
+
    private:
+    /**
+     * @brief State of a connection to a subscriber.
+     *
+     */
+    struct ConnectionState {
+        std::vector<uint8_t> batch; /**< Batched bytes not yet written */
+        size_t frames = 0;          /**< Number of frames in batch */
+        DeltaEncoder delta;         /**< Used if the topic has the DELTA encoding */
+    };
+
     rix::msg::mediator::PubInfo info_;
     std::shared_ptr<rix::ipc::interfaces::Server> server_;
-    std::set<std::weak_ptr<rix::ipc::interfaces::Connection>, std::owner_less<>> connections_;
+    std::shared_ptr<Transport> transport_; /**< Set if the publisher is multiplexed */
+    /**< Connections to subscribers and their state */
+    std::map<std::weak_ptr<rix::ipc::interfaces::Connection>, ConnectionState, std::owner_less<>> connections_;
     mutable std::mutex connections_mutex_;
+    rix::msg::Writer frame_;              /**< Serialized frame that is copied into every buffer */
+    uint32_t sequence_ = 0;               /**< Sequence number of the next message, see data_frame */
+    bool timestamping_ = false;           /**< Adds the send time to every frame, see set_timestamping */
+    rix::msg::Writer delta_frame_;        /**< Frame of a connection if the topic has the DELTA encoding */
+    Encoder encoder_;                     /**< Set if the topic uses an encoding other than RAW or DELTA */
+    size_t batch_bytes_;                  /**< 0 if batching is disabled */
+    rix::util::Duration batch_latency_;
+    rix::util::Time batch_start_;         /**< Time the oldest buffered message was published */
+    bool batch_pending_;
     ClientFactory factory_;
     rix::ipc::Endpoint rixhub_endpoint_;
+    TopicStats stats_;
     std::atomic<bool> shutdown_flag_;
 
     /**
@@ -80,11 +198,13 @@ class Publisher : public interfaces::Spinner {
      *
      * @param info The info of the Node
      * @param server The server that will accept connections from subscribers.
+     * Unused if transport is set.
      * @param factory The client factory used to create connections to the Mediator
      * @param rixhub_endpoint The endpoint of the rixhub instance (the Mediator's server)
+     * @param transport The Transport of the Node if info.protocol is TCP_MUX
      */
     Publisher(const rix::msg::mediator::PubInfo &info, std::shared_ptr<rix::ipc::interfaces::Server> server,
-              ClientFactory factory, rix::ipc::Endpoint rixhub_endpoint);
+              ClientFactory factory, rix::ipc::Endpoint rixhub_endpoint, std::shared_ptr<Transport> transport = nullptr);
 
     /**
      * @brief We do not want the user to call spin or spin_once for Publisher.
@@ -105,6 +225,54 @@ class Publisher : public interfaces::Spinner {
      * 
      */
     virtual void spin_once() override;
+
+    /**
+     * @brief Writes the buffered messages if the oldest has waited for the
+     * batching latency. Invoked by the Node at the end of every spin_once.
+     *
+     */
+    void flush_if_due();
+
+    /**
+     * @brief Writes the buffered messages. connections_mutex_ must be held.
+     *
+     */
+    void flush_locked();
+
+    /**
+     * @brief Publishes `count` messages, where message `i` is `at(i)`.
+     *
+     */
+    void publish_batch(size_t count, const std::function<const rix::msg::Message &(size_t)> &at);
+
+    /**
+     * @brief Serializes the message into frame_ with the next sequence
+     * number (see data_frame). connections_mutex_ must be held.
+     *
+     */
+    void serialize_locked(const rix::msg::Message &msg);
+
+    /**
+     * @brief Returns the size of the frame header, including the send time
+     * if timestamping is enabled. connections_mutex_ must be held.
+     *
+     */
+    size_t header_size() const;
+
+    /**
+     * @brief Returns the frame to send on a connection for the message in
+     * frame_. connections_mutex_ must be held.
+     *
+     */
+    const rix::msg::Writer &frame_for(ConnectionState &state);
+
+    /**
+     * @brief Writes the buffers if one is full or the batching latency has
+     * passed, and starts the latency timer otherwise. connections_mutex_ must
+     * be held.
+     *
+     */
+    void batch_locked();
 };
 
 }  // namespace core
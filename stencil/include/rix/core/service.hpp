@@ -0,0 +1,182 @@
+#pragma once
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "rix/core/common.hpp"
+#include "rix/core/interfaces/spinner.hpp"
+#include "rix/core/stats.hpp"
+#include "rix/ipc/interfaces/client.hpp"
+#include "rix/ipc/interfaces/server.hpp"
+#include "rix/msg/mediator/SrvInfo.hpp"
+#include "rix/util/log.hpp"
+
+namespace rix {
+namespace core {
+
+class Node;  // Forward declaration
+
+/**
+ * @brief Framing of service requests and responses.
+ *
+ * @details Requests and responses are exchanged over a persistent connection
+ * between a ServiceClient and a Service. Every request carries an ID chosen by
+ * the client so that many requests can be in flight at once (pipelining).
+ * Responses are sent in the order requests are received.
+ *
+ *     Request:  [uint32 len][uint32 request_id][len bytes of request]
+ *     Response: [uint32 len][uint32 request_id][uint8 status][len bytes of response]
+ *
+ * A nonzero status means that the request could not be deserialized or that
+ * the service callback returned false. In that case len is 0.
+ */
+namespace service_frame {
+const size_t REQUEST_HEADER_SIZE = 8;
+const size_t RESPONSE_HEADER_SIZE = 9;
+}  // namespace service_frame
+
+class Service : public interfaces::Spinner {
+    /**
+     * @brief We declare the Node as a friend class so that its factory method
+     * create_service has access to the private constructor.
+     */
+    friend class Node;
+
+   public:
+    /**
+     * @brief Type-erased handler. Deserializes the request from `src`, invokes
+     * the user callback and appends the serialized response to `dst`.
+     * Returns false on failure.
+     */
+    using SerializedHandler = std::function<bool(const uint8_t *src, size_t len, rix::msg::Writer &dst)>;
+
+    Service(const Service &) = delete;
+    Service &operator=(const Service &) = delete;
+    ~Service();
+
+    /**
+     * @brief Returns true if the Service has not been shut down.
+     *
+     */
+    virtual bool ok() const override;
+
+    /**
+     * @brief Stops the spin loop. ok() will return false after this function
+     * is called.
+     *
+     */
+    virtual void shutdown() override;
+
+    /**
+     * @brief Set the callback for the service.
+     *
+     * @tparam TReq The request message type of the service.
+     * @tparam TRes The response message type of the service.
+     * @param callback The callback invoked for each request. It fills in the
+     * response and returns false if the request failed.
+     */
+    template <typename TReq, typename TRes>
+    void set_callback(std::function<bool(const TReq &, TRes &)> callback);
+
+    /**
+     * @brief Returns the number of clients currently connected to the service.
+     *
+     */
+    size_t get_client_count() const;
+
+    /**
+     * @brief Returns the execution time statistics of the callback. Services
+     * have no budget, so their calls never overrun.
+     *
+     */
+    const CallbackStats &stats() const;
+
+   private:
+    struct Session {
+        std::weak_ptr<rix::ipc::interfaces::Connection> connection;
+        std::vector<uint8_t> rx; /**< Received bytes not yet parsed */
+        rix::msg::Writer tx;     /**< Responses not yet written */
+    };
+
+    rix::msg::mediator::SrvInfo info_;
+    std::shared_ptr<rix::ipc::interfaces::Server> server_;
+    std::list<Session> sessions_;
+    std::vector<uint8_t> chunk_;
+    SerializedHandler handler_;
+    mutable std::mutex mutex_;
+    ClientFactory factory_;
+    rix::ipc::Endpoint rixhub_endpoint_;
+    std::atomic<bool> shutdown_flag_;
+    CallbackStats stats_;
+
+    /**
+     * @brief Private constructor to be used by Node::create_service. This will
+     * register the service with the Mediator.
+     *
+     * @param info The info of the Service
+     * @param server The server that will accept connections from clients.
+     * @param factory The client factory used to create connections to the Mediator
+     * @param rixhub_endpoint The endpoint of the rixhub instance (the Mediator's server)
+     */
+    Service(const rix::msg::mediator::SrvInfo &info, std::shared_ptr<rix::ipc::interfaces::Server> server,
+            ClientFactory factory, const rix::ipc::Endpoint &rixhub_endpoint);
+
+    /**
+     * @brief We do not want the user to call spin or spin_once for Service.
+     * Only the Node should invoke these functions.
+     *
+     */
+    using interfaces::Spinner::spin;
+
+    /**
+     * @brief This will invoke a single iteration of the service loop.
+     *
+     * @details
+     * 1. Accept any pending connections from clients.
+     * 2. For each connection, read all available bytes and handle every
+     *    complete request frame. Responses to all requests handled in this
+     *    iteration are written to the connection with a single write.
+     * 3. Close connections that have hung up.
+     *
+     */
+    virtual void spin_once() override;
+
+    /**
+     * @brief Handles all complete request frames in the session's receive
+     * buffer and appends the response frames to its transmit buffer.
+     *
+     */
+    void handle_requests(Session &session, const SerializedHandler &handler);
+};
+
+template <typename TReq, typename TRes>
+void Service::set_callback(std::function<bool(const TReq &, TRes &)> callback) {
+    static_assert(std::is_base_of<rix::msg::Message, TReq>::value, "TReq must be a subclass of rix::msg::Message.");
+    static_assert(std::is_base_of<rix::msg::Message, TRes>::value, "TRes must be a subclass of rix::msg::Message.");
+
+    if (TReq().hash() != info_.request_hash || TRes().hash() != info_.response_hash) {
+        rix::util::Log::warn << "Message type mismatch in set_callback." << std::endl;
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    handler_ = [callback](const uint8_t *src, size_t len, rix::msg::Writer &dst) -> bool {
+        TReq req;
+        size_t offset = 0;
+        if (!req.deserialize(src, len, offset)) {
+            rix::util::Log::warn << "Failed to deserialize service request." << std::endl;
+            return false;
+        }
+        TRes res;
+        if (!callback(req, res)) {
+            return false;
+        }
+        res.serialize(dst);
+        return true;
+    };
+}
+
+}  // namespace core
+}  // namespace rix
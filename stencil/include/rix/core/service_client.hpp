@@ -0,0 +1,260 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "rix/core/common.hpp"
+#include "rix/core/interfaces/spinner.hpp"
+#include "rix/core/service.hpp"
+#include "rix/ipc/interfaces/client.hpp"
+#include "rix/msg/mediator/SrvInfo.hpp"
+#include "rix/util/log.hpp"
+
+namespace rix {
+namespace core {
+
+class Node;  // Forward declaration
+
+class ServiceClient : public interfaces::Spinner {
+    /**
+     * @brief We declare the Node as a friend class so that its factory method
+     * create_client has access to the private constructor.
+     */
+    friend class Node;
+
+   public:
+    ServiceClient(const ServiceClient &) = delete;
+    ServiceClient &operator=(const ServiceClient &) = delete;
+    ~ServiceClient();
+
+    /**
+     * @brief Returns true if the ServiceClient has not been shut down.
+     *
+     */
+    virtual bool ok() const override;
+
+    /**
+     * @brief Stops the spin loop. ok() will return false after this function
+     * is called. All pending requests are completed with std::nullopt.
+     *
+     */
+    virtual void shutdown() override;
+
+    /**
+     * @brief Send a request without waiting for the response.
+     *
+     * @details The request is written to the persistent connection to the
+     * service (or buffered until the connection is established). Any number of
+     * requests may be in flight at once; responses are matched to requests by
+     * ID. The future becomes ready when the response is read during
+     * Node::spin_once (or during a blocking call()).
+     *
+     * @tparam TReq The request message type of the service
+     * @tparam TRes The response message type of the service
+     * @param req The request
+     * @return std::future<std::optional<TRes>> The response, or std::nullopt if
+     * the service failed, the connection was lost, or the types do not match.
+     */
+    template <typename TReq, typename TRes>
+    std::future<std::optional<TRes>> call_async(const TReq &req);
+
+    /**
+     * @brief Send a request and wait for the response.
+     *
+     * @details This reads from the connection itself, so it does not require
+     * another thread to spin the Node, but it may be called while one does. It
+     * must not be used to call a service owned by the same Node from that
+     * Node's spin thread, because the service would not be spun while waiting.
+     * Use call_async in that case.
+     *
+     * @tparam TReq The request message type of the service
+     * @tparam TRes The response message type of the service
+     * @param req The request
+     * @param res The response
+     * @param timeout The maximum duration to wait for
+     * @return `true` if a successful response was received within the timeout.
+     * On timeout the request is cancelled, and a late response is ignored.
+     */
+    template <typename TReq, typename TRes>
+    bool call(const TReq &req, TRes &res, const rix::util::Duration &timeout = rix::util::Duration(1.0));
+
+    /**
+     * @brief Waits up to `timeout` for responses to arrive and completes the
+     * corresponding requests.
+     *
+     * @details Use this to drive call_async futures when the Node is not being
+     * spun by another thread, instead of busy looping on Node::spin_once.
+     *
+     * @param timeout The maximum duration to wait for
+     * @return size_t The number of requests that were completed.
+     */
+    size_t wait_for_responses(const rix::util::Duration &timeout);
+
+    /**
+     * @brief Returns true if the client is connected to the service.
+     *
+     */
+    bool is_connected() const;
+
+    /**
+     * @brief Returns the number of requests that are waiting for a response.
+     *
+     */
+    size_t get_pending_count() const;
+
+   private:
+    using Completion = std::function<void(const uint8_t *src, size_t len, bool ok)>;
+
+    rix::msg::mediator::SrvInfo info_;
+    ClientFactory factory_;
+    rix::ipc::Endpoint rixhub_endpoint_;
+    std::shared_ptr<rix::ipc::interfaces::Client> client_;
+    rix::util::Time last_lookup_;
+    rix::util::Time connect_start_; /**< When the connect to the service started */
+    rix::msg::Writer tx_;     /**< Requests not yet written */
+    std::vector<uint8_t> rx_; /**< Received bytes not yet parsed */
+    std::vector<uint8_t> chunk_;
+    std::map<uint32_t, Completion> pending_;
+    uint32_t next_id_;
+    mutable std::mutex mutex_;
+    std::atomic<bool> shutdown_flag_;
+
+    /**
+     * @brief Private constructor to be used by Node::create_client.
+     *
+     * @param info The info of the requested service (name and message hashes)
+     * @param factory The client factory used to create connections
+     * @param rixhub_endpoint The endpoint of the rixhub instance (the Mediator's server)
+     */
+    ServiceClient(const rix::msg::mediator::SrvInfo &info, ClientFactory factory,
+                  const rix::ipc::Endpoint &rixhub_endpoint);
+
+    /**
+     * @brief We do not want the user to call spin or spin_once for
+     * ServiceClient. Only the Node should invoke these functions.
+     *
+     */
+    using interfaces::Spinner::spin;
+
+    /**
+     * @brief This will invoke a single iteration of the client loop (see poll).
+     *
+     */
+    virtual void spin_once() override;
+
+    /**
+     * @brief Sends a request like call_async and sets `id` to its request ID.
+     *
+     */
+    template <typename TReq, typename TRes>
+    std::future<std::optional<TRes>> request(const TReq &req, uint32_t &id);
+
+    /**
+     * @brief Frames a serialized request and queues it for sending.
+     *
+     * @return The ID of the request, or 0 if the client has been shut down.
+     */
+    uint32_t send(const rix::msg::Message &req, Completion completion);
+
+    /**
+     * @brief Removes a pending request without completing it, so that its
+     * response is ignored if it arrives.
+     *
+     * @return `false` if the request was already completed.
+     */
+    bool cancel(uint32_t id);
+
+    /**
+     * @brief Makes progress on the connection.
+     *
+     * @details
+     * 1. If there is no connection, look up the service with rixhub (at most
+     *    every 0.5 seconds) and start a non-blocking connect. A connect that
+     *    fails, or does not complete within 1 second, is dropped with
+     *    disconnect so that the service is looked up again.
+     * 2. If connected, write any queued requests.
+     * 3. Read all available bytes (waiting up to `wait` for the first) and
+     *    complete the requests whose responses have arrived.
+     *
+     * @param wait The maximum duration to wait for a response to be readable
+     */
+    void poll(const rix::util::Duration &wait);
+
+    /**
+     * @brief Drops the connection and completes every pending request with a
+     * failure. The service is looked up again on the next poll.
+     *
+     */
+    void disconnect();
+};
+
+template <typename TReq, typename TRes>
+std::future<std::optional<TRes>> ServiceClient::call_async(const TReq &req) {
+    uint32_t id;
+    return request<TReq, TRes>(req, id);
+}
+
+template <typename TReq, typename TRes>
+std::future<std::optional<TRes>> ServiceClient::request(const TReq &req, uint32_t &id) {
+    static_assert(std::is_base_of<rix::msg::Message, TReq>::value, "TReq must be a subclass of rix::msg::Message.");
+    static_assert(std::is_base_of<rix::msg::Message, TRes>::value, "TRes must be a subclass of rix::msg::Message.");
+
+    auto promise = std::make_shared<std::promise<std::optional<TRes>>>();
+    auto future = promise->get_future();
+    id = 0;
+
+    if (req.hash() != info_.request_hash || TRes().hash() != info_.response_hash) {
+        rix::util::Log::warn << "Message type mismatch in call_async." << std::endl;
+        promise->set_value(std::nullopt);
+        return future;
+    }
+
+    id = send(req, [promise](const uint8_t *src, size_t len, bool ok) {
+        if (!ok) {
+            promise->set_value(std::nullopt);
+            return;
+        }
+        TRes res;
+        size_t offset = 0;
+        if (!res.deserialize(src, len, offset)) {
+            rix::util::Log::warn << "Failed to deserialize service response." << std::endl;
+            promise->set_value(std::nullopt);
+            return;
+        }
+        promise->set_value(std::move(res));
+    });
+    if (id == 0) {
+        promise->set_value(std::nullopt);
+    }
+    return future;
+}
+
+template <typename TReq, typename TRes>
+bool ServiceClient::call(const TReq &req, TRes &res, const rix::util::Duration &timeout) {
+    uint32_t id;
+    auto future = request<TReq, TRes>(req, id);
+    auto deadline = rix::util::Time::now() + timeout;
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        if (!ok() || rix::util::Time::now() > deadline) {
+            // The response may have arrived just before the request is cancelled
+            if (cancel(id)) {
+                return false;
+            }
+            break;
+        }
+        wait_for_responses(rix::util::Duration(0.001));
+    }
+    auto result = future.get();
+    if (!result) {
+        return false;
+    }
+    res = *result;
+    return true;
+}
+
+}  // namespace core
+}  // namespace rix
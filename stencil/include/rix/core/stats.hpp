@@ -0,0 +1,341 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rix {
+namespace core {
+
+/**
+ * @brief A counter that is read without locks.
+ *
+ * @details Only one thread may add to a counter at a time: publishers add
+ * while holding their connection lock (or the Transport's lock), and
+ * subscribers add from the thread that spins their Node. The counter can
+ * therefore be incremented with a relaxed load and store, which costs about a
+ * nanosecond, instead of a locked read-modify-write instruction, which costs
+ * several. Any thread may read it.
+ */
+class Counter {
+   public:
+    void add(uint64_t n = 1) { value_.store(value_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed); }
+    uint64_t load() const { return value_.load(std::memory_order_relaxed); }
+
+   private:
+    std::atomic<uint64_t> value_{0};
+};
+
+/**
+ * @brief A log-linear histogram of latencies in nanoseconds, in the style of
+ * HdrHistogram.
+ *
+ * @details Values below 32 ns have a bucket each. Above, every power of two
+ * is split into 16 buckets, so the bucket of a value is at most 1/16 (6.25%)
+ * wider than the value. Values of 2^40 ns (about 18 minutes) and above fall
+ * into the last bucket, and negative values (e.g. from clock offsets between
+ * machines) into the first. Recording costs a few shifts and one Counter::add,
+ * with the same single writer rule as Counter.
+ */
+class LatencyHistogram {
+   public:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr int MAX_BITS = 40;
+    static constexpr size_t BUCKET_COUNT = size_t(MAX_BITS - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+
+    /**
+     * @brief The counts of a LatencyHistogram at one point in time.
+     *
+     */
+    struct Snapshot {
+        std::vector<uint64_t> counts; /**< Count of each bucket, see lower_bound */
+        uint64_t count = 0;
+        uint64_t min = 0; /**< Smallest recorded value in nanoseconds */
+        uint64_t max = 0; /**< Largest recorded value in nanoseconds */
+        uint64_t sum = 0; /**< Sum of the recorded values in nanoseconds */
+
+        uint64_t mean() const { return count == 0 ? 0 : sum / count; }
+
+        /**
+         * @brief Returns the lower bound of the bucket that holds the
+         * `quantile` (between 0 and 1) of the recorded values, or 0 if
+         * nothing was recorded.
+         *
+         */
+        uint64_t percentile(double quantile) const {
+            if (count == 0) return 0;
+            uint64_t rank = static_cast<uint64_t>(quantile * (count - 1)) + 1;
+            uint64_t seen = 0;
+            for (size_t i = 0; i < counts.size(); i++) {
+                seen += counts[i];
+                if (seen >= rank) return lower_bound(i);
+            }
+            return max;
+        }
+    };
+
+    void record(int64_t ns) {
+        uint64_t value = ns < 0 ? 0 : static_cast<uint64_t>(ns);
+        counts_[index_of(value)].add();
+        count_.add();
+        sum_.add(value);
+        if (value < min_.load(std::memory_order_relaxed)) min_.store(value, std::memory_order_relaxed);
+        if (value > max_.load(std::memory_order_relaxed)) max_.store(value, std::memory_order_relaxed);
+    }
+
+    Snapshot snapshot() const {
+        Snapshot s;
+        s.counts.resize(BUCKET_COUNT);
+        for (size_t i = 0; i < BUCKET_COUNT; i++) s.counts[i] = counts_[i].load();
+        s.count = count_.load();
+        s.min = s.count == 0 ? 0 : min_.load(std::memory_order_relaxed);
+        s.max = max_.load(std::memory_order_relaxed);
+        s.sum = sum_.load();
+        return s;
+    }
+
+    static size_t index_of(uint64_t value) {
+        constexpr uint64_t linear = uint64_t(2) << SUB_BUCKET_BITS;
+        if (value < linear) return static_cast<size_t>(value);
+        value = std::min(value, (uint64_t(1) << MAX_BITS) - 1);
+        const int shift = std::bit_width(value) - 1 - SUB_BUCKET_BITS;
+        return (static_cast<size_t>(shift + 1) << SUB_BUCKET_BITS) +
+               static_cast<size_t>((value >> shift) - (uint64_t(1) << SUB_BUCKET_BITS));
+    }
+
+    static uint64_t lower_bound(size_t index) {
+        constexpr size_t linear = size_t(2) << SUB_BUCKET_BITS;
+        if (index < linear) return index;
+        const int shift = static_cast<int>(index >> SUB_BUCKET_BITS) - 1;
+        const uint64_t sub = (index & ((size_t(1) << SUB_BUCKET_BITS) - 1)) + (uint64_t(1) << SUB_BUCKET_BITS);
+        return sub << shift;
+    }
+
+   private:
+    std::array<Counter, BUCKET_COUNT> counts_{};
+    Counter count_;
+    Counter sum_;
+    std::atomic<uint64_t> min_{UINT64_MAX};
+    std::atomic<uint64_t> max_{0};
+};
+
+/**
+ * @brief Always-on statistics of a Publisher or Subscriber.
+ *
+ * @details Publishers count the messages they publish and the bytes they
+ * write to subscribers. A failed write counts a write failure and drops the
+ * frames that were pending on that connection. Subscribers count the messages
+ * passed to their callback and the bytes of the frames they receive, and drop
+ * frames that fail to decode. If the message has a `header` with a non-zero
+ * `stamp`, subscribers also record the delay from the stamp to the receipt of
+ * the message, which includes the clock offset between the machines.
+ *
+ * Messages from publishers with timestamping enabled (see
+ * Publisher::set_timestamping) also record their transport latency: the
+ * delivery from the publish call until the subscriber read the frame, and
+ * the queueing from that read until the callback started.
+ */
+struct TopicStats {
+    Counter messages;
+    Counter bytes;
+    Counter drops;
+    Counter write_failures;
+    Counter lost;       /**< Messages missing from the sequence of a publisher */
+    Counter duplicates; /**< Messages received twice */
+    Counter reordered;  /**< Messages received after a later one, also counted in lost */
+    LatencyHistogram latency;
+    LatencyHistogram delivery; /**< From the publish call to the read of a timestamped frame */
+    LatencyHistogram queueing; /**< From the read of a timestamped frame to its callback */
+
+    /**
+     * @brief The statistics of one Publisher or Subscriber at one point in
+     * time, as returned by Node::stats().
+     *
+     */
+    struct Snapshot {
+        std::string topic;
+        bool publisher = false; /**< false for subscribers */
+        uint64_t messages = 0;
+        uint64_t bytes = 0;
+        uint64_t drops = 0;
+        uint64_t write_failures = 0;
+        uint64_t lost = 0;
+        uint64_t duplicates = 0;
+        uint64_t reordered = 0;
+        LatencyHistogram::Snapshot latency;
+        LatencyHistogram::Snapshot delivery;
+        LatencyHistogram::Snapshot queueing;
+    };
+
+    Snapshot snapshot(const std::string &topic, bool publisher) const {
+        Snapshot s;
+        s.topic = topic;
+        s.publisher = publisher;
+        s.messages = messages.load();
+        s.bytes = bytes.load();
+        s.drops = drops.load();
+        s.write_failures = write_failures.load();
+        s.lost = lost.load();
+        s.duplicates = duplicates.load();
+        s.reordered = reordered.load();
+        s.latency = latency.snapshot();
+        s.delivery = delivery.snapshot();
+        s.queueing = queueing.snapshot();
+        return s;
+    }
+};
+
+/**
+ * @brief Tracks the sequence numbers (see data_frame) of the messages
+ * received from one publisher.
+ *
+ * @details A message with a later sequence number than expected reveals a
+ * gap, whose messages are counted as lost. A message with an earlier sequence
+ * number is a duplicate if it was received before, and is reordered (it
+ * arrived after a later message) otherwise. The last 64 sequence numbers are
+ * remembered to tell the two apart; older ones count as reordered. Since
+ * reordered messages were already counted as lost when their gap was seen,
+ * the messages that never arrived are `lost - reordered`.
+ */
+class SequenceTracker {
+   public:
+    static constexpr uint32_t WINDOW = 64;
+
+    /**
+     * @brief Records the sequence number of a received message.
+     *
+     * @return The number of messages missing before `seq`, 0 unless it
+     * revealed a gap
+     */
+    uint32_t update(uint32_t seq, TopicStats &stats) {
+        if (!started_) {
+            started_ = true;
+            next_ = seq + 1;
+            window_ = 1;
+            return 0;
+        }
+        const int32_t ahead = static_cast<int32_t>(seq - next_);
+        if (ahead >= 0) {
+            // Bit i of the window is set if next_ - 1 - i was received
+            const uint32_t shift = static_cast<uint32_t>(ahead) + 1;
+            window_ = shift >= WINDOW ? 1 : (window_ << shift) | 1;
+            next_ = seq + 1;
+            if (ahead > 0) stats.lost.add(static_cast<uint32_t>(ahead));
+            return static_cast<uint32_t>(ahead);
+        }
+        const uint32_t age = static_cast<uint32_t>(-(ahead + 1));
+        if (age < WINDOW && (window_ >> age) & 1) {
+            stats.duplicates.add();
+        } else {
+            if (age < WINDOW) window_ |= uint64_t(1) << age;
+            stats.reordered.add();
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Returns the sequence number expected next.
+     *
+     */
+    uint32_t next() const { return next_; }
+
+   private:
+    bool started_ = false;
+    uint32_t next_ = 0;
+    uint64_t window_ = 0;
+};
+
+/**
+ * @brief Execution times of the callback of a Timer, Subscriber or Service.
+ *
+ * @details Every call records how long the callback ran and the period since
+ * the start of the previous call. A call overruns when it runs longer than
+ * its budget: the duration of a Timer, or the interval between two messages
+ * of a Subscriber. Timers also record their jitter, the deviation of the
+ * period from their duration, so a 100 Hz timer that runs at 80 Hz shows up
+ * as a jitter of 2.5 ms. Recording follows the single writer rule of Counter.
+ */
+struct CallbackStats {
+    enum KIND : uint8_t {
+        TIMER = 0,
+        SUBSCRIBER,
+        SERVICE,
+    };
+
+    LatencyHistogram execution;
+    LatencyHistogram period;
+    LatencyHistogram jitter;
+    Counter overruns;
+
+    /**
+     * @brief The statistics of one callback at one point in time, as
+     * returned by Node::callback_stats().
+     *
+     */
+    struct Snapshot {
+        KIND kind = TIMER;
+        std::string name;           /**< Topic or service name, empty for timers */
+        int64_t nominal_period = 0; /**< Duration of a timer in nanoseconds, 0 otherwise */
+        LatencyHistogram::Snapshot execution;
+        LatencyHistogram::Snapshot period;
+        LatencyHistogram::Snapshot jitter;
+        uint64_t overruns = 0;
+    };
+
+    /**
+     * @brief Returns the time in nanoseconds of a steady clock, to pass to
+     * record.
+     *
+     */
+    static int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    /**
+     * @brief Returns the start of the previous call, or -1 before the first.
+     *
+     */
+    int64_t last_start() const { return last_start_; }
+
+    /**
+     * @brief Records a call that ran from `start` to `end` (see now()).
+     *
+     * @param budget The time the call may take without overrunning, 0 for none
+     * @param nominal_period The expected period for recording jitter, 0 for none
+     */
+    void record(int64_t start, int64_t end, int64_t budget = 0, int64_t nominal_period = 0) {
+        execution.record(end - start);
+        if (last_start_ >= 0) {
+            const int64_t p = start - last_start_;
+            period.record(p);
+            if (nominal_period > 0) jitter.record(p > nominal_period ? p - nominal_period : nominal_period - p);
+        }
+        last_start_ = start;
+        if (budget > 0 && end - start > budget) overruns.add();
+    }
+
+    Snapshot snapshot(KIND kind, const std::string &name, int64_t nominal_period = 0) const {
+        Snapshot s;
+        s.kind = kind;
+        s.name = name;
+        s.nominal_period = nominal_period;
+        s.execution = execution.snapshot();
+        s.period = period.snapshot();
+        s.jitter = jitter.snapshot();
+        s.overruns = overruns.load();
+        return s;
+    }
+
+   private:
+    int64_t last_start_ = -1;
+};
+
+}  // namespace core
+}  // namespace rix
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
 
 #include "rix/core/common.hpp"
+#include "rix/core/delta.hpp"
+#include "rix/core/encoding.hpp"
 #include "rix/core/interfaces/spinner.hpp"
+#include "rix/core/message_pool.hpp"
+#include "rix/core/stats.hpp"
+#include "rix/core/transport.hpp"
 #include "rix/ipc/interfaces/client.hpp"
 #include "rix/ipc/interfaces/server.hpp"
 #include "rix/msg/mediator/Operation.hpp"
@@ -15,6 +21,7 @@
 #include "rix/msg/mediator/SubNotify.hpp"
 #include "rix/msg/standard/UInt32.hpp"
 #include "rix/util/log.hpp"
+#include "rix/util/trace.hpp"
 
 namespace rix {
 namespace core {
@@ -29,7 +36,19 @@ class Subscriber : public interfaces::Spinner {
     friend class Node;
 
    public:
-    using SerializedCallback = std::function<void(const uint8_t *src, size_t len)>;
+    /**
+     * @brief Invoked with a serialized message and the encoding that its
+     * publisher registered.
+     *
+     */
+    using SerializedCallback = std::function<void(const uint8_t *src, size_t len, uint8_t encoding)>;
+
+    /**
+     * @brief Invoked when the sequence numbers of a publisher skip `count`
+     * messages, starting at `first`.
+     *
+     */
+    using LossCallback = std::function<void(uint64_t publisher_id, uint32_t first, uint32_t count)>;
 
     Subscriber(const Subscriber &) = delete;
     Subscriber &operator=(const Subscriber &) = delete;
@@ -51,6 +70,9 @@ class Subscriber : public interfaces::Spinner {
     /**
      * @brief Set the callback for the subscriber.
      *
+     * @details Messages are deserialized into a MessagePool owned by the
+     * callback, so the reference is only valid during the call.
+     *
      * @tparam TMsg The message type for the subscriber's topic.
      * @param callback The callback function to be invoked when a message is
      * received.
@@ -58,6 +80,32 @@ class Subscriber : public interfaces::Spinner {
     template <typename TMsg>
     void set_callback(std::function<void(const TMsg &)> callback);
 
+    /**
+     * @brief Set a callback that receives pooled messages by shared_ptr.
+     *
+     * @details The callback may keep the message beyond the call. It returns
+     * to the pool once the last copy of the shared_ptr is released.
+     *
+     * @tparam TMsg The message type for the subscriber's topic.
+     * @param callback The callback function to be invoked when a message is
+     * received.
+     */
+    template <typename TMsg>
+    void set_callback(std::function<void(std::shared_ptr<const TMsg>)> callback);
+
+    /**
+     * @brief Set a callback that receives the serialized messages.
+     *
+     * @details The messages are not deserialized, so the callback works for
+     * any message type, e.g. to record a topic. Messages of DELTA publishers
+     * are decoded first and passed with the RAW encoding; other encodings are
+     * passed as received (see rix/core/encoding.hpp).
+     *
+     * @param callback The callback function to be invoked when a message is
+     * received.
+     */
+    void set_serialized_callback(SerializedCallback callback);
+
     /**
      * @brief Returns the callback for this subscriber as a SerializedCallback
      * object.
@@ -70,6 +118,20 @@ class Subscriber : public interfaces::Spinner {
      */
     SerializedCallback get_callback() const;
 
+    /**
+     * @brief Set a callback that is invoked from the spin loop whenever
+     * messages of a publisher were lost.
+     *
+     * @details Messages are numbered by their publisher (see data_frame), and
+     * the subscriber tracks the numbers of every publisher it is connected to
+     * over TCP, including across reconnections. The totals are counted in
+     * stats() as lost, duplicates and reordered. Multiplexed publishers share
+     * the ordered connection of their Transport and are not tracked.
+     *
+     * @param callback The callback, or nullptr to remove it
+     */
+    void set_loss_callback(LossCallback callback);
+
     /**
      * @brief Returns the number of publishers that this subscriber is 
      * currently connected to.
@@ -77,6 +139,32 @@ class Subscriber : public interfaces::Spinner {
      */
     size_t get_publisher_count() const;
 
+    /**
+     * @brief Returns the statistics of this subscriber. See TopicStats.
+     *
+     */
+    const TopicStats &stats() const;
+
+    /**
+     * @brief Returns the execution time statistics of the callback.
+     *
+     * @details A call overruns when it takes longer than the interval to the
+     * previous message: the difference of their stamps if the message has a
+     * `header` with a non-zero `stamp`, and otherwise the time since the
+     * previous call started. Without stamps, messages that queued up behind a
+     * slow callback therefore count as overruns, as do bursts from a batching
+     * publisher.
+     *
+     */
+    const CallbackStats &callback_stats() const;
+
+    /**
+     * @brief Returns the number of received bytes that do not yet form a
+     * complete message. Must be called from the thread that spins the Node.
+     *
+     */
+    size_t get_queued_bytes() const;
+
    private:
     rix::msg::mediator::SubInfo info_;
     ClientFactory factory_;
@@ -84,9 +172,30 @@ class Subscriber : public interfaces::Spinner {
     mutable std::mutex callback_mutex_;
     std::shared_ptr<rix::ipc::interfaces::Server> server_;
     std::map<uint64_t, std::shared_ptr<rix::ipc::interfaces::Client>> clients_;
+    std::shared_ptr<Transport> transport_;  /**< Transport of the Node, used for TCP_MUX publishers */
+    std::map<uint64_t, uint16_t> channels_; /**< Publisher ID -> Transport channel */
     rix::ipc::Endpoint rixhub_endpoint_;
+    std::map<uint64_t, std::vector<uint8_t>> buffers_; /**< Publisher ID -> received bytes not yet parsed */
+    std::map<uint64_t, uint8_t> encodings_;            /**< Publisher ID -> encoding of its messages */
+    std::map<uint64_t, DeltaDecoder> deltas_;          /**< Publisher ID -> state of DELTA publishers */
+    std::map<uint64_t, SequenceTracker> sequences_;    /**< Publisher ID -> sequence numbers received */
+    LossCallback loss_callback_;
+    std::vector<uint8_t> chunk_;
+    rix::msg::mediator::SubNotify notify_; /**< Last notification from the Mediator, reused for decoding */
+    std::shared_ptr<TopicStats> stats_;    /**< Shared with the callback */
+    std::shared_ptr<CallbackStats> callback_stats_; /**< Shared with the callback */
     std::atomic<bool> shutdown_flag_;
 
+    /**
+     * @brief Stores a callback that deserializes each message into a message
+     * acquired from a MessagePool and passes it to `invoke`.
+     *
+     * @tparam TMsg The message type for the subscriber's topic.
+     * @tparam TInvoke Callable with the signature void(const std::shared_ptr<TMsg> &)
+     */
+    template <typename TMsg, typename TInvoke>
+    void set_pooled_callback(TInvoke invoke);
+
     /**
      * @brief Private constructor to be used by Node::create_subscriber. This
      * will register the subscriber with the Mediator.
@@ -95,9 +204,11 @@ class Subscriber : public interfaces::Spinner {
      * @param server The server that will accept connections from the Mediator (for notification of new publishers).
      * @param factory The client factory used to create connections to the Mediator
      * @param rixhub_endpoint The endpoint of the rixhub instance (the Mediator's server)
+     * @param transport The Transport of the Node, used to receive from multiplexed publishers
      */
     Subscriber(const rix::msg::mediator::SubInfo &info, std::shared_ptr<rix::ipc::interfaces::Server> server,
-               ClientFactory factory, const rix::ipc::Endpoint &rixhub_endpoint);
+               ClientFactory factory, const rix::ipc::Endpoint &rixhub_endpoint,
+               std::shared_ptr<Transport> transport = nullptr);
 
     /**
      * @brief We do not want the user to call spin or spin_once for Subscriber.
@@ -125,7 +236,9 @@ class Subscriber : public interfaces::Spinner {
      * 6. Deserialize the data into a SubNotify message.
      * 7. For each publisher in the SubNotify message, create a client using the
      *    ClientFactory and connect to the publisher's server. Store this client
-     *    in the clients_ set.
+     *    in the clients_ set. Publishers with the TCP_MUX protocol are
+     *    subscribed to through the Node's Transport instead, which shares one
+     *    connection per node and invokes the callback when it spins.
      * 
      * Important note: before calling connect, make sure that you set the client
      * to non-blocking mode. This is important because we cannot wait for the 
@@ -142,9 +255,11 @@ class Subscriber : public interfaces::Spinner {
      * 3. If the client is not connected or readable, skip it (this means that
      *    the publisher has not accepted our connection OR that it has not sent
      *    a message since the last iteration.)
-     * 4. Read the prefixed size (4 bytes, use a rix::msg::standard::UInt32)
-     * 5. Read the number of bytes specified by the size message.
-     * 6. Invoke the callback on the byte array.
+     * 4. Read all available bytes into the buffer of the client.
+     * 5. For every complete message in the buffer, read the data_frame
+     *    header, track its sequence number and invoke the callback on the
+     *    bytes that follow. Incomplete messages stay in the buffer until the
+     *    rest arrives.
      *
      */
     virtual void spin_once() override;
@@ -152,6 +267,16 @@ class Subscriber : public interfaces::Spinner {
 
 template <typename TMsg>
 void Subscriber::set_callback(std::function<void(const TMsg &)> callback) {
+    set_pooled_callback<TMsg>([callback](const std::shared_ptr<TMsg> &msg) { callback(*msg); });
+}
+
+template <typename TMsg>
+void Subscriber::set_callback(std::function<void(std::shared_ptr<const TMsg>)> callback) {
+    set_pooled_callback<TMsg>([callback](const std::shared_ptr<TMsg> &msg) { callback(msg); });
+}
+
+template <typename TMsg, typename TInvoke>
+void Subscriber::set_pooled_callback(TInvoke invoke) {
     static_assert(std::is_base_of<rix::msg::Message, TMsg>::value, "TMsg must be a subclass of rix::msg::Message.");
 
     /**
@@ -184,15 +309,43 @@ void Subscriber::set_callback(std::function<void(const TMsg &)> callback) {
      * 2. It forces the implementation of the entire class to exist in a header
      * file, so we cannot hide solution code from you in future projects ;)
      *
+     * The message is taken from a pool rather than constructed for every
+     * call. Deserializing into a message that was used before reuses the
+     * capacity of its vectors and strings, so receiving a steady stream of
+     * messages does not allocate. Messages are decoded according to the
+     * encoding of their publisher (see rix/core/encoding.hpp).
+     *
+     * Messages with a Header also record their latency from the stamp.
      */
-    callback_ = [callback](const uint8_t *msg, size_t len) {
-        TMsg obj;
+    auto pool = std::make_shared<MessagePool<TMsg>>();
+    // The stamp of the previous message is shared by all copies of the
+    // callback, since the spin loops copy it before invoking it
+    auto last_stamp = std::make_shared<int64_t>(-1);
+    callback_ = [invoke, pool, stats = stats_, callback_stats = callback_stats_, last_stamp](
+                    const uint8_t *msg, size_t len, uint8_t encoding) {
+        std::shared_ptr<TMsg> obj = pool->acquire();
         size_t offset = 0;
-        if (!obj.deserialize(msg, len, offset)) {
+        if (!Encoding<TMsg>::decode(encoding, *obj, msg, len, offset)) {
             rix::util::Log::warn << "Failed to deserialize message from publisher." << std::endl;
+            stats->drops.add();
             return;
         }
-        callback(obj);
+        stats->messages.add();
+        const int64_t start = CallbackStats::now();
+        int64_t budget = callback_stats->last_start() < 0 ? 0 : start - callback_stats->last_start();
+        if constexpr (requires { obj->header.stamp.sec + obj->header.stamp.nsec; }) {
+            const auto &stamp = obj->header.stamp;
+            if (stamp.sec != 0 || stamp.nsec != 0) {
+                auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    rix::util::Clock::now().time_since_epoch());
+                const int64_t stamp_ns = int64_t(stamp.sec) * 1'000'000'000 + stamp.nsec;
+                stats->latency.record(now.count() - stamp_ns);
+                budget = *last_stamp < 0 ? 0 : stamp_ns - *last_stamp;
+                *last_stamp = stamp_ns;
+            }
+        }
+        invoke(obj);
+        callback_stats->record(start, CallbackStats::now(), budget);
     };
 }
 
@@ -0,0 +1,293 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "rix/core/subscriber.hpp"
+#include "rix/util/ring_buffer.hpp"
+#include "rix/util/time.hpp"
+
+namespace rix {
+namespace core {
+
+/**
+ * @brief Matching policy used by a Synchronizer.
+ *
+ * EXACT_TIME: A set is emitted only when every topic has a message with the
+ * same `header.stamp`.
+ *
+ * APPROXIMATE_TIME: A set is emitted with the message from each topic that is
+ * closest to the newest of the queue heads, provided the spread of the set is
+ * within the configured maximum interval.
+ */
+enum class SyncPolicy { EXACT_TIME, APPROXIMATE_TIME };
+
+/**
+ * @brief Synchronizes messages from two or more topics by `header.stamp`.
+ *
+ * @details Each topic has a bounded RingBuffer. When a message is added, the
+ * heads of the queues are compared and any message that can no longer be part
+ * of a match is dropped. Every message is pushed and popped at most once, and
+ * the approximate search resumes where it stopped in each queue, so the cost
+ * per message is amortized O(1) (O(N) in the number of topics).
+ *
+ * Every message type must have a `header` field of type
+ * rix::msg::standard::Header.
+ *
+ * Matched sets are moved out of the queues and the callback is invoked after
+ * the lock is released, so the callback may call add() again. If add() is
+ * called from several threads, their callbacks may run concurrently.
+ *
+ * The Synchronizer can be used standalone by calling add<I>() directly, or
+ * created through Node::create_synchronizer, in which case it owns one
+ * Subscriber per topic.
+ *
+ * @tparam TMsgs The message types of each topic, in order.
+ */
+template <typename... TMsgs>
+class Synchronizer {
+    static_assert(sizeof...(TMsgs) >= 2, "Synchronizer requires at least two message types.");
+
+   public:
+    static constexpr size_t N = sizeof...(TMsgs);
+    using Callback = std::function<void(const TMsgs &...)>;
+
+    template <size_t I>
+    using MessageType = std::tuple_element_t<I, std::tuple<TMsgs...>>;
+
+    /**
+     * @brief Construct a new Synchronizer.
+     *
+     * @param policy The matching policy
+     * @param callback The callback invoked with each matched set
+     * @param queue_size The capacity of each per-topic queue
+     * @param max_interval The maximum spread between the oldest and newest
+     * message of a set (APPROXIMATE_TIME only). A zero duration disables the
+     * check.
+     */
+    Synchronizer(SyncPolicy policy, Callback callback, size_t queue_size = 16,
+                 const rix::util::Duration &max_interval = rix::util::Duration(0.0))
+        : policy_(policy),
+          callback_(callback),
+          queues_(RingBuffer<TMsgs>(queue_size)...),
+          max_interval_ns_(max_interval.to_nanoseconds()),
+          matched_(0),
+          dropped_(0) {}
+
+    Synchronizer(const Synchronizer &) = delete;
+    Synchronizer &operator=(const Synchronizer &) = delete;
+
+    ~Synchronizer() {
+        for (auto &sub : subscribers_) {
+            if (sub) sub->shutdown();
+        }
+    }
+
+    /**
+     * @brief Add a message to the queue of topic I and emit any sets that are
+     * now complete.
+     *
+     * @tparam I The index of the topic
+     * @param msg The received message
+     */
+    template <size_t I>
+    void add(const MessageType<I> &msg) {
+        std::vector<std::tuple<TMsgs...>> ready;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (std::get<I>(queues_).push(msg)) {
+                dropped_++;
+                advance(I, 1);
+            }
+            if (policy_ == SyncPolicy::EXACT_TIME) {
+                process_exact(ready);
+            } else {
+                process_approximate(ready);
+            }
+        }
+        for (auto &set : ready) {
+            std::apply(callback_, set);
+        }
+    }
+
+    /**
+     * @brief Returns the number of sets passed to the callback.
+     *
+     */
+    uint64_t get_matched_count() const { return matched_; }
+
+    /**
+     * @brief Returns the number of messages discarded without being matched.
+     *
+     */
+    uint64_t get_dropped_count() const { return dropped_; }
+
+   private:
+    friend class Node;
+
+    template <typename T>
+    using RingBuffer = rix::util::RingBuffer<T>;
+
+    SyncPolicy policy_;
+    Callback callback_;
+    std::tuple<RingBuffer<TMsgs>...> queues_;
+    int64_t max_interval_ns_;
+    std::atomic<uint64_t> matched_;
+    std::atomic<uint64_t> dropped_;
+    std::array<std::shared_ptr<Subscriber>, N> subscribers_;
+    /**
+     * @brief Where closest() stopped in a queue. Every message after the head
+     * and up to `index` is at or before `pivot`.
+     *
+     */
+    struct Cursor {
+        size_t index = 0;
+        int64_t pivot = INT64_MIN;
+    };
+    std::array<Cursor, N> cursors_{};
+    std::mutex mutex_;
+
+    template <typename T>
+    static int64_t stamp(const T &msg) {
+        return static_cast<int64_t>(msg.header.stamp.sec) * 1'000'000'000LL + msg.header.stamp.nsec;
+    }
+
+    template <size_t... Is>
+    bool all_nonempty(std::index_sequence<Is...>) const {
+        return (!std::get<Is>(queues_).empty() && ...);
+    }
+
+    template <size_t... Is>
+    std::array<int64_t, N> front_stamps(std::index_sequence<Is...>) const {
+        return {stamp(std::get<Is>(queues_).front())...};
+    }
+
+    /**
+     * @brief Moves the set at `idx` to `ready` for the callback.
+     *
+     */
+    template <size_t... Is>
+    void emit(std::array<size_t, N> idx, std::vector<std::tuple<TMsgs...>> &ready, std::index_sequence<Is...>) {
+        ready.emplace_back(std::move(std::get<Is>(queues_)[idx[Is]])...);
+        matched_++;
+        // Discard the emitted messages and everything older
+        ((dropped_ += idx[Is], drop(std::get<Is>(queues_), idx[Is] + 1), advance(Is, idx[Is] + 1)), ...);
+    }
+
+    /**
+     * @brief Moves the cursor of queue i after `n` messages were popped.
+     *
+     */
+    void advance(size_t i, size_t n) { cursors_[i].index -= std::min(cursors_[i].index, n); }
+
+    template <typename T>
+    static void drop(RingBuffer<T> &queue, size_t n) {
+        for (size_t i = 0; i < n; i++) queue.pop();
+    }
+
+    /**
+     * @brief Pops the head of the queue with index i.
+     *
+     */
+    template <size_t... Is>
+    void pop_front(size_t i, std::index_sequence<Is...>) {
+        ((Is == i ? std::get<Is>(queues_).pop() : void()), ...);
+        dropped_++;
+        advance(i, 1);
+    }
+
+    void process_exact(std::vector<std::tuple<TMsgs...>> &ready) {
+        constexpr auto seq = std::index_sequence_for<TMsgs...>{};
+        while (all_nonempty(seq)) {
+            auto stamps = front_stamps(seq);
+            int64_t newest = stamps[0];
+            for (size_t i = 1; i < N; i++) newest = std::max(newest, stamps[i]);
+
+            bool match = true;
+            for (size_t i = 0; i < N; i++) {
+                if (stamps[i] < newest) {
+                    pop_front(i, seq);
+                    match = false;
+                }
+            }
+            if (match) {
+                emit(std::array<size_t, N>{}, ready, seq);
+            }
+        }
+    }
+
+    /**
+     * @brief Finds the message in a queue that is closest to the pivot stamp,
+     * starting at `cursor`, where the previous search of the queue stopped.
+     *
+     * @details The pivot only moves forward as heads are popped, so each
+     * message is passed over once. If the pivot moved back, e.g. because
+     * stamps decreased, the search starts over at the head.
+     *
+     * @return `false` if a closer message may still arrive on this topic.
+     */
+    template <typename T>
+    static bool closest(const RingBuffer<T> &queue, int64_t pivot, Cursor &cursor, size_t &index) {
+        index = pivot >= cursor.pivot ? std::min(cursor.index, queue.size() - 1) : 0;
+        while (index + 1 < queue.size() && stamp(queue[index + 1]) <= pivot) index++;
+        cursor = {index, pivot};
+        if (index + 1 < queue.size()) {
+            // queue[index + 1] is after the pivot, pick whichever is closer
+            if (stamp(queue[index + 1]) - pivot < pivot - stamp(queue[index])) index++;
+            return true;
+        }
+        return stamp(queue[index]) >= pivot || queue.full();
+    }
+
+    template <size_t... Is>
+    bool select(int64_t pivot, std::array<size_t, N> &idx, std::index_sequence<Is...>) {
+        return (closest(std::get<Is>(queues_), pivot, cursors_[Is], idx[Is]) && ...);
+    }
+
+    template <size_t... Is>
+    std::array<int64_t, N> stamps_at(const std::array<size_t, N> &idx, std::index_sequence<Is...>) const {
+        return {stamp(std::get<Is>(queues_)[idx[Is]])...};
+    }
+
+    void process_approximate(std::vector<std::tuple<TMsgs...>> &ready) {
+        constexpr auto seq = std::index_sequence_for<TMsgs...>{};
+        while (all_nonempty(seq)) {
+            auto heads = front_stamps(seq);
+            int64_t pivot = heads[0];
+            for (size_t i = 1; i < N; i++) pivot = std::max(pivot, heads[i]);
+
+            std::array<size_t, N> idx{};
+            if (!select(pivot, idx, seq)) {
+                return;  // Wait for more messages
+            }
+
+            auto stamps = stamps_at(idx, seq);
+            size_t oldest = 0;
+            int64_t lo = stamps[0], hi = stamps[0];
+            for (size_t i = 1; i < N; i++) {
+                if (stamps[i] < lo) {
+                    lo = stamps[i];
+                    oldest = i;
+                }
+                hi = std::max(hi, stamps[i]);
+            }
+
+            if (max_interval_ns_ > 0 && hi - lo > max_interval_ns_) {
+                pop_front(oldest, seq);
+                continue;
+            }
+            emit(idx, ready, seq);
+        }
+    }
+};
+
+}  // namespace core
+}  // namespace rix
@@ -6,6 +6,8 @@
 
 #include "rix/core/common.hpp"
 #include "rix/core/interfaces/spinner.hpp"
+#include "rix/core/stats.hpp"
+#include "rix/util/trace.hpp"
 
 namespace rix {
 namespace core {
@@ -62,12 +64,26 @@ class Timer : public interfaces::Spinner {
      */
     Callback get_callback() const;
 
+    /**
+     * @brief Returns the execution time statistics of the callback. A call
+     * overruns when it takes longer than the duration of the timer.
+     *
+     */
+    const CallbackStats &stats() const;
+
+    /**
+     * @brief Returns the duration of the timer.
+     *
+     */
+    const rix::util::Duration &get_duration() const;
+
    private:
     rix::util::Duration duration_;
     Event event_;
     Callback callback_;
     std::mutex callback_mutex_;
     std::atomic<bool> shutdown_flag_;
+    CallbackStats stats_;
 };
 
 }  // namespace core
@@ -0,0 +1,282 @@
+#pragma once
+
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "rix/core/common.hpp"
+#include "rix/core/delta.hpp"
+#include "rix/core/interfaces/spinner.hpp"
+#include "rix/core/stats.hpp"
+#include "rix/ipc/interfaces/client.hpp"
+#include "rix/ipc/interfaces/server.hpp"
+#include "rix/msg/mediator/PubInfo.hpp"
+#include "rix/util/log.hpp"
+#include "rix/util/trace.hpp"
+
+namespace rix {
+namespace core {
+
+class Node;  // Forward declaration
+
+/**
+ * @brief Framing of multiplexed connections.
+ *
+ * @details A Transport keeps a single connection to each peer node and tags
+ * every frame with a channel. Channels are chosen by the receiving side when
+ * it subscribes to a publisher, so a data frame can be dispatched to its
+ * Subscriber with a single lookup.
+ *
+ *     Frame: [uint32 len][uint16 channel][len bytes of payload]
+ *
+ * Channel 0 carries control messages. The first byte of their payload is a
+ * CONTROL value:
+ *
+ *     HELLO:       [uint8 type][uint64 node_id]
+ *     SUBSCRIBE:   [uint8 type][uint64 publisher_id][uint16 channel]
+ *     UNSUBSCRIBE: [uint8 type][uint16 channel]
+ *
+ * HELLO is the first frame sent on a new connection so that the accepting
+ * node can reuse it for its own subscriptions to the connecting node.
+ */
+namespace mux_frame {
+const size_t HEADER_SIZE = 6;
+const uint16_t CONTROL_CHANNEL = 0;
+enum CONTROL : uint8_t {
+    HELLO = 1,
+    SUBSCRIBE,
+    UNSUBSCRIBE,
+};
+}  // namespace mux_frame
+
+class Transport : public interfaces::Spinner {
+    /**
+     * @brief We declare the Node as a friend class so that it can create the
+     * Transport and spin it after all other components.
+     */
+    friend class Node;
+
+    /**
+     * @brief Publishers and Subscribers created with the TCP_MUX protocol send
+     * and receive through the Transport of their Node.
+     */
+    friend class Publisher;
+    friend class Subscriber;
+
+   public:
+    using Receiver = std::function<void(const uint8_t *src, size_t len)>;
+
+    Transport(const Transport &) = delete;
+    Transport &operator=(const Transport &) = delete;
+    ~Transport();
+
+    /**
+     * @brief Returns true if the Transport has not been shut down.
+     *
+     */
+    virtual bool ok() const override;
+
+    /**
+     * @brief Stops the spin loop and closes all connections. ok() will return
+     * false after this function is called.
+     *
+     */
+    virtual void shutdown() override;
+
+    /**
+     * @brief Returns true if the Transport has a server, i.e. publishers of
+     * its Node are multiplexed.
+     *
+     */
+    bool is_multiplexing() const;
+
+    /**
+     * @brief Returns the endpoint that peers connect to.
+     *
+     */
+    rix::ipc::Endpoint local_endpoint() const;
+
+    /**
+     * @brief Returns the number of connections to other nodes.
+     *
+     */
+    size_t get_connection_count() const;
+
+   private:
+    struct Link {
+        std::shared_ptr<rix::ipc::interfaces::Client> client; /**< Set if this node connected */
+        std::weak_ptr<rix::ipc::interfaces::Connection> accepted; /**< Set if the peer connected */
+        uint64_t peer_id;          /**< Node ID of the peer, 0 until known */
+        std::vector<uint8_t> rx;   /**< Received bytes not yet parsed */
+        rix::msg::Writer tx;       /**< Frames not yet written */
+    };
+
+    struct Route {
+        std::weak_ptr<Link> link;
+        uint16_t channel;
+        std::shared_ptr<DeltaEncoder> delta; /**< Set if the publisher has the DELTA encoding */
+    };
+
+    struct Channel {
+        std::weak_ptr<Link> link;
+        Receiver receiver;
+    };
+
+    /**< Queued bytes on a connection that trigger a write before the end of spin */
+    static const size_t FLUSH_THRESHOLD = 65536;
+    /**< Queued bytes on a connection at which the peer is considered stalled */
+    static const size_t MAX_QUEUED = 1 << 24;
+
+    uint64_t node_id_;
+    std::shared_ptr<rix::ipc::interfaces::Server> server_;
+    ClientFactory factory_;
+    std::list<std::shared_ptr<Link>> links_;
+    std::map<uint64_t, std::vector<Route>> routes_; /**< Publisher ID -> subscribed channels of peers */
+    std::map<uint16_t, Channel> channels_;          /**< Channel -> local subscriber */
+    std::set<uint64_t> delta_publishers_;           /**< Publishers with the DELTA encoding */
+    uint16_t next_channel_;
+    std::vector<uint8_t> chunk_;
+    rix::msg::Writer scratch_;     /**< Serialized message sent on several channels */
+    mutable std::recursive_mutex mutex_;
+    std::atomic<bool> shutdown_flag_;
+
+    /**
+     * @brief Private constructor to be used by Node. A Transport without a
+     * server can only subscribe to multiplexed publishers of other nodes.
+     *
+     * @param node_id The ID of the Node that owns the Transport
+     * @param factory The client factory used to connect to other nodes
+     */
+    Transport(uint64_t node_id, ClientFactory factory);
+
+    /**
+     * @brief Binds the server that peers connect to. Publishers created after
+     * this call are multiplexed.
+     *
+     * @param server The server that will accept connections from other nodes
+     * @return `true` if the server is valid.
+     */
+    bool listen(std::shared_ptr<rix::ipc::interfaces::Server> server);
+
+    /**
+     * @brief We do not want the user to call spin or spin_once for Transport.
+     * Only the Node should invoke these functions.
+     *
+     */
+    using interfaces::Spinner::spin;
+
+    /**
+     * @brief This will invoke a single iteration of the transport loop.
+     *
+     * @details
+     * 1. Accept any pending connections from other nodes.
+     * 2. For each connection, read all available bytes, handle control frames
+     *    and pass data frames to the receiver of their channel.
+     * 3. Write all frames queued on each connection since the last iteration
+     *    with a single write.
+     * 4. Close connections that have hung up.
+     *
+     */
+    virtual void spin_once() override;
+
+    /**
+     * @brief Makes the publisher with the specified ID available to peers.
+     *
+     * @param pub_id The ID of the publisher
+     * @param delta If true, messages are delta encoded per subscription
+     */
+    void advertise(uint64_t pub_id, bool delta = false);
+
+    /**
+     * @brief Stops sending messages of the publisher with the specified ID.
+     *
+     */
+    void unadvertise(uint64_t pub_id);
+
+    /**
+     * @brief Queues a message of a local publisher on every connection that
+     * subscribed to it. The frames are written at the end of spin_once, or
+     * sooner if a connection has more than FLUSH_THRESHOLD bytes queued.
+     *
+     * @param pub_id The ID of the publisher
+     * @param msg The message to be sent
+     * @param encoder Serializes the message if the topic uses an encoding other than RAW
+     * @param stats The statistics of the publisher, updated while the Transport is locked
+     */
+    void send(uint64_t pub_id, const rix::msg::Message &msg, const Encoder &encoder = nullptr,
+              TopicStats *stats = nullptr);
+
+    /**
+     * @brief Returns the number of remote subscriptions to the publisher with
+     * the specified ID.
+     *
+     */
+    size_t get_subscriber_count(uint64_t pub_id) const;
+
+    /**
+     * @brief Subscribes to a multiplexed publisher. The connection to the
+     * publisher's node is created if it does not exist yet.
+     *
+     * @param pub The info of the publisher (node_id and endpoint are used)
+     * @param receiver Invoked with the serialized message for every data frame
+     * @return uint16_t The channel of the subscription, 0 on failure
+     */
+    uint16_t subscribe(const rix::msg::mediator::PubInfo &pub, Receiver receiver);
+
+    /**
+     * @brief Cancels a subscription created with subscribe.
+     *
+     */
+    void unsubscribe(uint16_t channel);
+
+    /**
+     * @brief Returns true if the channel exists and its connection is open.
+     *
+     */
+    bool is_subscribed(uint16_t channel) const;
+
+    /**
+     * @brief Returns the connection of a link, or nullptr if it was closed.
+     *
+     */
+    static std::shared_ptr<rix::ipc::interfaces::Connection> connection(const Link &link);
+
+    /**
+     * @brief Appends a frame header to the transmit buffer of a link and
+     * returns the offset at which the payload must be written.
+     *
+     */
+    static size_t begin_frame(Link &link, uint16_t channel, uint32_t len);
+
+    /**
+     * @brief Handles all complete frames in the receive buffer of a link.
+     *
+     */
+    void handle_frames(const std::shared_ptr<Link> &link);
+
+    /**
+     * @brief Handles a frame received on the control channel.
+     *
+     */
+    void handle_control(const std::shared_ptr<Link> &link, const uint8_t *src, size_t len);
+
+    /**
+     * @brief Writes as much of the transmit buffer of a link as possible.
+     *
+     * @return `false` if the connection failed and must be closed.
+     */
+    bool flush(Link &link);
+
+    /**
+     * @brief Closes a link and drops all of its channels.
+     *
+     */
+    void close(const std::shared_ptr<Link> &link);
+};
+
+}  // namespace core
+}  // namespace rix
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace rix {
+namespace msg {
+namespace detail {
+
+/**
+ * @brief The wire format is little-endian. Numbers are converted with
+ * to_wire/from_wire, which compile to nothing on little-endian hosts (x86_64
+ * and aarch64 in their usual configuration), and are always read and written
+ * with memcpy so that unaligned fields are safe on strict targets.
+ */
+inline constexpr bool WIRE_IS_NATIVE = std::endian::native == std::endian::little;
+
+/**
+ * @brief Reverses the bytes of a number.
+ *
+ */
+template <typename T>
+inline T byteswap(T value) {
+    static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
+    if constexpr (sizeof(T) == 1) {
+        return value;
+    } else {
+        using U = std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+        static_assert(sizeof(U) == sizeof(T), "Unsupported number size");
+        U bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        if constexpr (sizeof(T) == 2) {
+            bits = __builtin_bswap16(bits);
+        } else if constexpr (sizeof(T) == 4) {
+            bits = __builtin_bswap32(bits);
+        } else {
+            bits = __builtin_bswap64(bits);
+        }
+        std::memcpy(&value, &bits, sizeof(T));
+        return value;
+    }
+}
+
+template <typename T>
+inline T to_wire(T value) {
+    if constexpr (WIRE_IS_NATIVE) {
+        return value;
+    } else {
+        return byteswap(value);
+    }
+}
+
+template <typename T>
+inline T from_wire(T value) {
+    return to_wire(value);
+}
+
+/**
+ * @brief Reverses the bytes of each of `count` consecutive elements of `S`
+ * bytes in place. `data` does not need to be aligned. Uses SSE2 on x86_64 and
+ * NEON on ARM to swap 16 bytes at a time.
+ *
+ * @tparam S The size of an element in bytes (1, 2, 4 or 8)
+ */
+template <size_t S>
+inline void byteswap_array(uint8_t *data, size_t count) {
+    static_assert(S == 1 || S == 2 || S == 4 || S == 8, "Unsupported element size");
+    if constexpr (S > 1) {
+        size_t bytes = count * S;
+        size_t i = 0;
+#if defined(__SSE2__)
+        for (; i + 16 <= bytes; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            if constexpr (S == 4) {
+                v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+                v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+            } else if constexpr (S == 8) {
+                v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+                v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+            }
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(data + i), v);
+        }
+#elif defined(__ARM_NEON)
+        for (; i + 16 <= bytes; i += 16) {
+            uint8x16_t v = vld1q_u8(data + i);
+            if constexpr (S == 2) {
+                v = vrev16q_u8(v);
+            } else if constexpr (S == 4) {
+                v = vrev32q_u8(v);
+            } else {
+                v = vrev64q_u8(v);
+            }
+            vst1q_u8(data + i, v);
+        }
+#endif
+        for (; i < bytes; i += S) {
+            for (size_t lo = i, hi = i + S - 1; lo < hi; lo++, hi--) {
+                uint8_t tmp = data[lo];
+                data[lo] = data[hi];
+                data[hi] = tmp;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Converts `count` numbers of type T at `data` between host and wire
+ * byte order in place. Does nothing on little-endian hosts.
+ *
+ */
+template <typename T>
+inline void convert_wire_array(uint8_t *data, size_t count) {
+    static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
+    if constexpr (!WIRE_IS_NATIVE) {
+        byteswap_array<sizeof(T)>(data, count);
+    }
+}
+
+}  // namespace detail
+}  // namespace msg
+}  // namespace rix
@@ -1,3 +1,4 @@
+// Generated by tools/rixmsg.py from msg/geometry/Pose2D.msg. Do not edit.
 #pragma once
 
 #include <cstdint>
@@ -5,10 +6,12 @@
 #include <array>
 #include <map>
 #include <string>
+#include <string_view>
 #include <cstring>
 
 #include "rix/msg/serialization.hpp"
 #include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
 
 namespace rix {
 namespace msg {
@@ -16,41 +19,133 @@ namespace geometry {
 
 class Pose2D : public Message {
   public:
-    float x;
-    float y;
-    float theta;
+    float x{};
+    float y{};
+    float theta{};
 
     Pose2D() = default;
     Pose2D(const Pose2D &other) = default;
     ~Pose2D() = default;
 
+    static constexpr size_t FIXED_SIZE = detail::fixed_size_of<float, float, float>();
+    static constexpr std::array<uint64_t, 2> HASH = {0x52d8d9fbbd54c154ULL, 0x1f1a56f8a6169382ULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            X = 0,
+            Y = 1,
+            THETA = 2,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 3;
+
     size_t size() const override {
-        using namespace detail;
-        size_t size = 0;
-        size += size_number(x);
-        size += size_number(y);
-        size += size_number(theta);
-        return size;
+        return static_size();
     }
 
     std::array<uint64_t, 2> hash() const override {
-        return {0xe6921cbc9b9f8376ULL, 0x5ab0f8a78d45b88fULL};
+        return HASH;
     }
 
     void serialize(uint8_t *dst, size_t &offset) const override {
-        using namespace detail;
-        serialize_number(dst, offset, x);
-        serialize_number(dst, offset, y);
-        serialize_number(dst, offset, theta);
+        static_serialize(dst, offset);
     }
 
     bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
+        return FIXED_SIZE;
+    }
+
+    void static_serialize(uint8_t *dst, size_t &offset) const {
+        using namespace detail;
+        serialize_fixed(dst, offset, x, y, theta);
+    }
+
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        write_fixed(dst, x, y, theta);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
         using namespace detail;
-        if (!deserialize_number(x, src, size, offset)) { return false; };
-        if (!deserialize_number(y, src, size, offset)) { return false; };
-        if (!deserialize_number(theta, src, size, offset)) { return false; };
+        return deserialize_fixed(src, size, offset, x, y, theta);
+    }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_number(x, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_number(y, src, size, offset)) { return false; };
+        if (fields > 2 && !deserialize_number(theta, src, size, offset)) { return false; };
         return true;
     }
+
+    /**
+     * @brief Increments `offset` past a serialized Pose2D without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        return view_skip(FIXED_SIZE, size, offset);
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized Pose2D to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field < 3) {
+            static constexpr size_t offsets[] = {0, 4, 8};
+            return view_skip(offsets[field - 0], size, offset);
+        }
+        if (!view_skip(12, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized Pose2D. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_number<float>(x_, src, size, offset)) { return false; };
+            if (!view_number<float>(y_, src, size, offset)) { return false; };
+            if (!view_number<float>(theta_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        float x() const { return detail::load_number<float>(src_, x_); }
+
+        float y() const { return detail::load_number<float>(src_, y_); }
+
+        float theta() const { return detail::load_number<float>(src_, theta_); }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        size_t x_ = 0;
+        size_t y_ = 0;
+        size_t theta_ = 0;
+    };
 };
 
 } // namespace geometry
@@ -1,3 +1,4 @@
+// Generated by tools/rixmsg.py from msg/geometry/Pose2DStamped.msg. Do not edit.
 #pragma once
 
 #include <cstdint>
@@ -5,12 +6,14 @@
 #include <array>
 #include <map>
 #include <string>
+#include <string_view>
 #include <cstring>
 
 #include "rix/msg/serialization.hpp"
 #include "rix/msg/message.hpp"
-#include "rix/msg/geometry/Pose2D.hpp"
+#include "rix/msg/view.hpp"
 #include "rix/msg/standard/Header.hpp"
+#include "rix/msg/geometry/Pose2D.hpp"
 
 namespace rix {
 namespace msg {
@@ -18,14 +21,48 @@ namespace geometry {
 
 class Pose2DStamped : public Message {
   public:
-    standard::Header header;
-    geometry::Pose2D pose;
+    standard::Header header{};
+    geometry::Pose2D pose{};
 
     Pose2DStamped() = default;
     Pose2DStamped(const Pose2DStamped &other) = default;
     ~Pose2DStamped() = default;
 
+    static constexpr std::array<uint64_t, 2> HASH = {0x01a251a1a8edc420ULL, 0xc190ddcf847b410cULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            HEADER = 0,
+            POSE = 1,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 2;
+
     size_t size() const override {
+        return static_size();
+    }
+
+    std::array<uint64_t, 2> hash() const override {
+        return HASH;
+    }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        static_serialize(dst, offset);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
         using namespace detail;
         size_t size = 0;
         size += size_message(header);
@@ -33,22 +70,85 @@ class Pose2DStamped : public Message {
         return size;
     }
 
-    std::array<uint64_t, 2> hash() const override {
-        return {0xe069dc53bf23a3f1ULL, 0x60fb73a105836636ULL};
-    }
-
-    void serialize(uint8_t *dst, size_t &offset) const override {
+    void static_serialize(uint8_t *dst, size_t &offset) const {
         using namespace detail;
         serialize_message(dst, offset, header);
         serialize_message(dst, offset, pose);
     }
 
-    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        write_message(dst, header);
+        write_message(dst, pose);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
         using namespace detail;
         if (!deserialize_message(header, src, size, offset)) { return false; };
         if (!deserialize_message(pose, src, size, offset)) { return false; };
         return true;
     }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_message(header, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_message(pose, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` past a serialized Pose2DStamped without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!skip_message<standard::Header>(src, size, offset)) { return false; };
+        if (!view_skip(12, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized Pose2DStamped to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field == 0) { return true; };
+        if (!skip_message<standard::Header>(src, size, offset)) { return false; };
+        if (field == 1) { return true; };
+        if (!view_skip(12, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized Pose2DStamped. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_message(header_, src, size, offset)) { return false; };
+            if (!view_message(pose_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        const standard::Header::View &header() const { return header_; }
+
+        const geometry::Pose2D::View &pose() const { return pose_; }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        standard::Header::View header_{};
+        geometry::Pose2D::View pose_{};
+    };
 };
 
 } // namespace geometry
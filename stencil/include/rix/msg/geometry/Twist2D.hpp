@@ -1,3 +1,4 @@
+// Generated by tools/rixmsg.py from msg/geometry/Twist2D.msg. Do not edit.
 #pragma once
 
 #include <cstdint>
@@ -5,10 +6,12 @@
 #include <array>
 #include <map>
 #include <string>
+#include <string_view>
 #include <cstring>
 
 #include "rix/msg/serialization.hpp"
 #include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
 
 namespace rix {
 namespace msg {
@@ -24,33 +27,125 @@ class Twist2D : public Message {
     Twist2D(const Twist2D &other) = default;
     ~Twist2D() = default;
 
+    static constexpr size_t FIXED_SIZE = detail::fixed_size_of<float, float, float>();
+    static constexpr std::array<uint64_t, 2> HASH = {0x14d0ebd10e0e9d10ULL, 0xba2ea794d8968602ULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            VX = 0,
+            VY = 1,
+            WZ = 2,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 3;
+
     size_t size() const override {
-        using namespace detail;
-        size_t size = 0;
-        size += size_number(vx);
-        size += size_number(vy);
-        size += size_number(wz);
-        return size;
+        return static_size();
     }
 
     std::array<uint64_t, 2> hash() const override {
-        return {0x5b9303e27c7b02c0ULL, 0x761ea21c80ce8d68ULL};
+        return HASH;
     }
 
     void serialize(uint8_t *dst, size_t &offset) const override {
-        using namespace detail;
-        serialize_number(dst, offset, vx);
-        serialize_number(dst, offset, vy);
-        serialize_number(dst, offset, wz);
+        static_serialize(dst, offset);
     }
 
     bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
+        return FIXED_SIZE;
+    }
+
+    void static_serialize(uint8_t *dst, size_t &offset) const {
+        using namespace detail;
+        serialize_fixed(dst, offset, vx, vy, wz);
+    }
+
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        write_fixed(dst, vx, vy, wz);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
         using namespace detail;
-        if (!deserialize_number(vx, src, size, offset)) { return false; };
-        if (!deserialize_number(vy, src, size, offset)) { return false; };
-        if (!deserialize_number(wz, src, size, offset)) { return false; };
+        return deserialize_fixed(src, size, offset, vx, vy, wz);
+    }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_number(vx, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_number(vy, src, size, offset)) { return false; };
+        if (fields > 2 && !deserialize_number(wz, src, size, offset)) { return false; };
         return true;
     }
+
+    /**
+     * @brief Increments `offset` past a serialized Twist2D without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        return view_skip(FIXED_SIZE, size, offset);
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized Twist2D to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field < 3) {
+            static constexpr size_t offsets[] = {0, 4, 8};
+            return view_skip(offsets[field - 0], size, offset);
+        }
+        if (!view_skip(12, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized Twist2D. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_number<float>(vx_, src, size, offset)) { return false; };
+            if (!view_number<float>(vy_, src, size, offset)) { return false; };
+            if (!view_number<float>(wz_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        float vx() const { return detail::load_number<float>(src_, vx_); }
+
+        float vy() const { return detail::load_number<float>(src_, vy_); }
+
+        float wz() const { return detail::load_number<float>(src_, wz_); }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        size_t vx_ = 0;
+        size_t vy_ = 0;
+        size_t wz_ = 0;
+    };
 };
 
 } // namespace geometry
@@ -1,3 +1,4 @@
+// Generated by tools/rixmsg.py from msg/geometry/Twist2DStamped.msg. Do not edit.
 #pragma once
 
 #include <cstdint>
@@ -5,12 +6,14 @@
 #include <array>
 #include <map>
 #include <string>
+#include <string_view>
 #include <cstring>
 
 #include "rix/msg/serialization.hpp"
 #include "rix/msg/message.hpp"
-#include "rix/msg/geometry/Twist2D.hpp"
+#include "rix/msg/view.hpp"
 #include "rix/msg/standard/Header.hpp"
+#include "rix/msg/geometry/Twist2D.hpp"
 
 namespace rix {
 namespace msg {
@@ -25,7 +28,41 @@ class Twist2DStamped : public Message {
     Twist2DStamped(const Twist2DStamped &other) = default;
     ~Twist2DStamped() = default;
 
+    static constexpr std::array<uint64_t, 2> HASH = {0x79362f03e28aef30ULL, 0xae042c4b08c0fc40ULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            HEADER = 0,
+            TWIST = 1,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 2;
+
     size_t size() const override {
+        return static_size();
+    }
+
+    std::array<uint64_t, 2> hash() const override {
+        return HASH;
+    }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        static_serialize(dst, offset);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
         using namespace detail;
         size_t size = 0;
         size += size_message(header);
@@ -33,22 +70,85 @@ class Twist2DStamped : public Message {
         return size;
     }
 
-    std::array<uint64_t, 2> hash() const override {
-        return {0x463cb851594cfdbeULL, 0x9be7d269b40e97b6ULL};
-    }
-
-    void serialize(uint8_t *dst, size_t &offset) const override {
+    void static_serialize(uint8_t *dst, size_t &offset) const {
         using namespace detail;
         serialize_message(dst, offset, header);
         serialize_message(dst, offset, twist);
     }
 
-    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        write_message(dst, header);
+        write_message(dst, twist);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
         using namespace detail;
         if (!deserialize_message(header, src, size, offset)) { return false; };
         if (!deserialize_message(twist, src, size, offset)) { return false; };
         return true;
     }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_message(header, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_message(twist, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` past a serialized Twist2DStamped without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!skip_message<standard::Header>(src, size, offset)) { return false; };
+        if (!view_skip(12, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized Twist2DStamped to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field == 0) { return true; };
+        if (!skip_message<standard::Header>(src, size, offset)) { return false; };
+        if (field == 1) { return true; };
+        if (!view_skip(12, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized Twist2DStamped. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_message(header_, src, size, offset)) { return false; };
+            if (!view_message(twist_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        const standard::Header::View &header() const { return header_; }
+
+        const geometry::Twist2D::View &twist() const { return twist_; }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        standard::Header::View header_{};
+        geometry::Twist2D::View twist_{};
+    };
 };
 
 } // namespace geometry
@@ -1,3 +1,4 @@
+// Generated by tools/rixmsg.py from msg/mediator/Endpoint.msg. Do not edit.
 #pragma once
 
 #include <cstdint>
@@ -5,10 +6,12 @@
 #include <array>
 #include <map>
 #include <string>
+#include <string_view>
 #include <cstring>
 
 #include "rix/msg/serialization.hpp"
 #include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
 
 namespace rix {
 namespace msg {
@@ -16,14 +19,48 @@ namespace mediator {
 
 class Endpoint : public Message {
   public:
-    uint16_t port;
-    std::string address;
+    uint16_t port{};
+    std::string address{};
 
     Endpoint() = default;
     Endpoint(const Endpoint &other) = default;
     ~Endpoint() = default;
 
+    static constexpr std::array<uint64_t, 2> HASH = {0x1a1060e6539927f3ULL, 0x33f9c1156179fdb4ULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            PORT = 0,
+            ADDRESS = 1,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 2;
+
     size_t size() const override {
+        return static_size();
+    }
+
+    std::array<uint64_t, 2> hash() const override {
+        return HASH;
+    }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        static_serialize(dst, offset);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
         using namespace detail;
         size_t size = 0;
         size += size_number(port);
@@ -31,22 +68,87 @@ class Endpoint : public Message {
         return size;
     }
 
-    std::array<uint64_t, 2> hash() const override {
-        return {0x90624384b177200dULL, 0xe9ef37ae73ed079fULL};
-    }
-
-    void serialize(uint8_t *dst, size_t &offset) const override {
+    void static_serialize(uint8_t *dst, size_t &offset) const {
         using namespace detail;
         serialize_number(dst, offset, port);
         serialize_string(dst, offset, address);
     }
 
-    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        uint8_t *run = dst.extend(size_number(port) + size_string(address));
+        size_t offset = 0;
+        serialize_number(run, offset, port);
+        serialize_string(run, offset, address);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
         using namespace detail;
         if (!deserialize_number(port, src, size, offset)) { return false; };
         if (!deserialize_string(address, src, size, offset)) { return false; };
         return true;
     }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_number(port, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_string(address, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` past a serialized Endpoint without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!view_skip(2, size, offset)) { return false; };
+        if (!skip_string(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized Endpoint to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field == 0) { return true; };
+        if (!view_skip(2, size, offset)) { return false; };
+        if (field == 1) { return true; };
+        if (!skip_string(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized Endpoint. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_number<uint16_t>(port_, src, size, offset)) { return false; };
+            if (!view_string(address_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        uint16_t port() const { return detail::load_number<uint16_t>(src_, port_); }
+
+        const std::string_view &address() const { return address_; }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        size_t port_ = 0;
+        std::string_view address_{};
+    };
 };
 
 } // namespace mediator
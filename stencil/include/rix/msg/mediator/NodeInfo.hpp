@@ -1,3 +1,4 @@
+// Generated by tools/rixmsg.py from msg/mediator/NodeInfo.msg. Do not edit.
 #pragma once
 
 #include <cstdint>
@@ -5,10 +6,12 @@
 #include <array>
 #include <map>
 #include <string>
+#include <string_view>
 #include <cstring>
 
 #include "rix/msg/serialization.hpp"
 #include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
 #include "rix/msg/mediator/Endpoint.hpp"
 
 namespace rix {
@@ -17,17 +20,54 @@ namespace mediator {
 
 class NodeInfo : public Message {
   public:
-    std::string name;
-    uint64_t id;
-    uint64_t machine_id;
-    uint8_t protocol;
-    mediator::Endpoint endpoint;
+    std::string name{};
+    uint64_t id{};
+    uint64_t machine_id{};
+    uint8_t protocol{};
+    mediator::Endpoint endpoint{};
 
     NodeInfo() = default;
     NodeInfo(const NodeInfo &other) = default;
     ~NodeInfo() = default;
 
+    static constexpr std::array<uint64_t, 2> HASH = {0xa0ac46feda943eabULL, 0x31375d6d8493336aULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            NAME = 0,
+            ID = 1,
+            MACHINE_ID = 2,
+            PROTOCOL = 3,
+            ENDPOINT = 4,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 5;
+
     size_t size() const override {
+        return static_size();
+    }
+
+    std::array<uint64_t, 2> hash() const override {
+        return HASH;
+    }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        static_serialize(dst, offset);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
         using namespace detail;
         size_t size = 0;
         size += size_string(name);
@@ -38,11 +78,7 @@ class NodeInfo : public Message {
         return size;
     }
 
-    std::array<uint64_t, 2> hash() const override {
-        return {0x4fade8c3f2179b5eULL, 0x9d84b6c6e3719a8aULL};
-    }
-
-    void serialize(uint8_t *dst, size_t &offset) const override {
+    void static_serialize(uint8_t *dst, size_t &offset) const {
         using namespace detail;
         serialize_string(dst, offset, name);
         serialize_number(dst, offset, id);
@@ -51,7 +87,19 @@ class NodeInfo : public Message {
         serialize_message(dst, offset, endpoint);
     }
 
-    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        uint8_t *run = dst.extend(size_string(name) + size_number(id) + size_number(machine_id) +
+                                  size_number(protocol));
+        size_t offset = 0;
+        serialize_string(run, offset, name);
+        serialize_number(run, offset, id);
+        serialize_number(run, offset, machine_id);
+        serialize_number(run, offset, protocol);
+        write_message(dst, endpoint);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
         using namespace detail;
         if (!deserialize_string(name, src, size, offset)) { return false; };
         if (!deserialize_number(id, src, size, offset)) { return false; };
@@ -60,6 +108,88 @@ class NodeInfo : public Message {
         if (!deserialize_message(endpoint, src, size, offset)) { return false; };
         return true;
     }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_string(name, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_number(id, src, size, offset)) { return false; };
+        if (fields > 2 && !deserialize_number(machine_id, src, size, offset)) { return false; };
+        if (fields > 3 && !deserialize_number(protocol, src, size, offset)) { return false; };
+        if (fields > 4 && !deserialize_message(endpoint, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` past a serialized NodeInfo without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!skip_string(src, size, offset)) { return false; };
+        if (!view_skip(17, size, offset)) { return false; };
+        if (!skip_message<mediator::Endpoint>(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized NodeInfo to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field == 0) { return true; };
+        if (!skip_string(src, size, offset)) { return false; };
+        if (field < 4) {
+            static constexpr size_t offsets[] = {0, 8, 16};
+            return view_skip(offsets[field - 1], size, offset);
+        }
+        if (!view_skip(17, size, offset)) { return false; };
+        if (field == 4) { return true; };
+        if (!skip_message<mediator::Endpoint>(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized NodeInfo. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_string(name_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(id_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(machine_id_, src, size, offset)) { return false; };
+            if (!view_number<uint8_t>(protocol_, src, size, offset)) { return false; };
+            if (!view_message(endpoint_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        const std::string_view &name() const { return name_; }
+
+        uint64_t id() const { return detail::load_number<uint64_t>(src_, id_); }
+
+        uint64_t machine_id() const { return detail::load_number<uint64_t>(src_, machine_id_); }
+
+        uint8_t protocol() const { return detail::load_number<uint8_t>(src_, protocol_); }
+
+        const mediator::Endpoint::View &endpoint() const { return endpoint_; }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        std::string_view name_{};
+        size_t id_ = 0;
+        size_t machine_id_ = 0;
+        size_t protocol_ = 0;
+        mediator::Endpoint::View endpoint_{};
+    };
 };
 
 } // namespace mediator
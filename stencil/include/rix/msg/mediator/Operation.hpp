@@ -1,3 +1,4 @@
+// Generated by tools/rixmsg.py from msg/mediator/Operation.msg. Do not edit.
 #pragma once
 
 #include <cstdint>
@@ -5,10 +6,12 @@
 #include <array>
 #include <map>
 #include <string>
+#include <string_view>
 #include <cstring>
 
 #include "rix/msg/serialization.hpp"
 #include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
 
 namespace rix {
 namespace msg {
@@ -16,37 +19,126 @@ namespace mediator {
 
 class Operation : public Message {
   public:
-    uint32_t len;
-    uint8_t opcode;
+    uint32_t len{};
+    uint8_t opcode{};
 
     Operation() = default;
     Operation(const Operation &other) = default;
     ~Operation() = default;
 
+    static constexpr size_t FIXED_SIZE = detail::fixed_size_of<uint32_t, uint8_t>();
+    static constexpr std::array<uint64_t, 2> HASH = {0xbe319f580926a762ULL, 0xfaee928b6a2a8a4aULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            LEN = 0,
+            OPCODE = 1,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 2;
+
     size_t size() const override {
-        using namespace detail;
-        size_t size = 0;
-        size += size_number(len);
-        size += size_number(opcode);
-        return size;
+        return static_size();
     }
 
     std::array<uint64_t, 2> hash() const override {
-        return {0x86699b36c0a476cbULL, 0x3538e0260620e597ULL};
+        return HASH;
     }
 
     void serialize(uint8_t *dst, size_t &offset) const override {
-        using namespace detail;
-        serialize_number(dst, offset, len);
-        serialize_number(dst, offset, opcode);
+        static_serialize(dst, offset);
     }
 
     bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
+        return FIXED_SIZE;
+    }
+
+    void static_serialize(uint8_t *dst, size_t &offset) const {
+        using namespace detail;
+        serialize_fixed(dst, offset, len, opcode);
+    }
+
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        write_fixed(dst, len, opcode);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        return deserialize_fixed(src, size, offset, len, opcode);
+    }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
         using namespace detail;
-        if (!deserialize_number(len, src, size, offset)) { return false; };
-        if (!deserialize_number(opcode, src, size, offset)) { return false; };
+        if (fields > 0 && !deserialize_number(len, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_number(opcode, src, size, offset)) { return false; };
         return true;
     }
+
+    /**
+     * @brief Increments `offset` past a serialized Operation without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        return view_skip(FIXED_SIZE, size, offset);
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized Operation to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field < 2) {
+            static constexpr size_t offsets[] = {0, 4};
+            return view_skip(offsets[field - 0], size, offset);
+        }
+        if (!view_skip(5, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized Operation. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_number<uint32_t>(len_, src, size, offset)) { return false; };
+            if (!view_number<uint8_t>(opcode_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        uint32_t len() const { return detail::load_number<uint32_t>(src_, len_); }
+
+        uint8_t opcode() const { return detail::load_number<uint8_t>(src_, opcode_); }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        size_t len_ = 0;
+        size_t opcode_ = 0;
+    };
 };
 
 } // namespace mediator
@@ -1,3 +1,4 @@
+// Generated by tools/rixmsg.py from msg/mediator/PubInfo.msg. Do not edit.
 #pragma once
 
 #include <cstdint>
@@ -5,12 +6,14 @@
 #include <array>
 #include <map>
 #include <string>
+#include <string_view>
 #include <cstring>
 
 #include "rix/msg/serialization.hpp"
 #include "rix/msg/message.hpp"
-#include "rix/msg/mediator/Endpoint.hpp"
+#include "rix/msg/view.hpp"
 #include "rix/msg/mediator/TopicInfo.hpp"
+#include "rix/msg/mediator/Endpoint.hpp"
 
 namespace rix {
 namespace msg {
@@ -18,17 +21,54 @@ namespace mediator {
 
 class PubInfo : public Message {
   public:
-    uint64_t id;
-    uint64_t node_id;
-    uint8_t protocol;
-    mediator::TopicInfo topic_info;
-    mediator::Endpoint endpoint;
+    uint64_t id{};
+    uint64_t node_id{};
+    uint8_t protocol{};
+    mediator::TopicInfo topic_info{};
+    mediator::Endpoint endpoint{};
 
     PubInfo() = default;
     PubInfo(const PubInfo &other) = default;
     ~PubInfo() = default;
 
+    static constexpr std::array<uint64_t, 2> HASH = {0x7a9a011b3ab626ebULL, 0xcb6796b38591606cULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            ID = 0,
+            NODE_ID = 1,
+            PROTOCOL = 2,
+            TOPIC_INFO = 3,
+            ENDPOINT = 4,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 5;
+
     size_t size() const override {
+        return static_size();
+    }
+
+    std::array<uint64_t, 2> hash() const override {
+        return HASH;
+    }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        static_serialize(dst, offset);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
         using namespace detail;
         size_t size = 0;
         size += size_number(id);
@@ -39,11 +79,7 @@ class PubInfo : public Message {
         return size;
     }
 
-    std::array<uint64_t, 2> hash() const override {
-        return {0x77fbde7d73a67b6cULL, 0xf920af1abea2993bULL};
-    }
-
-    void serialize(uint8_t *dst, size_t &offset) const override {
+    void static_serialize(uint8_t *dst, size_t &offset) const {
         using namespace detail;
         serialize_number(dst, offset, id);
         serialize_number(dst, offset, node_id);
@@ -52,7 +88,18 @@ class PubInfo : public Message {
         serialize_message(dst, offset, endpoint);
     }
 
-    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        uint8_t *run = dst.extend(size_number(id) + size_number(node_id) + size_number(protocol));
+        size_t offset = 0;
+        serialize_number(run, offset, id);
+        serialize_number(run, offset, node_id);
+        serialize_number(run, offset, protocol);
+        write_message(dst, topic_info);
+        write_message(dst, endpoint);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
         using namespace detail;
         if (!deserialize_number(id, src, size, offset)) { return false; };
         if (!deserialize_number(node_id, src, size, offset)) { return false; };
@@ -61,6 +108,88 @@ class PubInfo : public Message {
         if (!deserialize_message(endpoint, src, size, offset)) { return false; };
         return true;
     }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_number(id, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_number(node_id, src, size, offset)) { return false; };
+        if (fields > 2 && !deserialize_number(protocol, src, size, offset)) { return false; };
+        if (fields > 3 && !deserialize_message(topic_info, src, size, offset)) { return false; };
+        if (fields > 4 && !deserialize_message(endpoint, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` past a serialized PubInfo without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!view_skip(17, size, offset)) { return false; };
+        if (!skip_message<mediator::TopicInfo>(src, size, offset)) { return false; };
+        if (!skip_message<mediator::Endpoint>(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized PubInfo to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field < 3) {
+            static constexpr size_t offsets[] = {0, 8, 16};
+            return view_skip(offsets[field - 0], size, offset);
+        }
+        if (!view_skip(17, size, offset)) { return false; };
+        if (field == 3) { return true; };
+        if (!skip_message<mediator::TopicInfo>(src, size, offset)) { return false; };
+        if (field == 4) { return true; };
+        if (!skip_message<mediator::Endpoint>(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized PubInfo. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_number<uint64_t>(id_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(node_id_, src, size, offset)) { return false; };
+            if (!view_number<uint8_t>(protocol_, src, size, offset)) { return false; };
+            if (!view_message(topic_info_, src, size, offset)) { return false; };
+            if (!view_message(endpoint_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        uint64_t id() const { return detail::load_number<uint64_t>(src_, id_); }
+
+        uint64_t node_id() const { return detail::load_number<uint64_t>(src_, node_id_); }
+
+        uint8_t protocol() const { return detail::load_number<uint8_t>(src_, protocol_); }
+
+        const mediator::TopicInfo::View &topic_info() const { return topic_info_; }
+
+        const mediator::Endpoint::View &endpoint() const { return endpoint_; }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        size_t id_ = 0;
+        size_t node_id_ = 0;
+        size_t protocol_ = 0;
+        mediator::TopicInfo::View topic_info_{};
+        mediator::Endpoint::View endpoint_{};
+    };
 };
 
 } // namespace mediator
@@ -0,0 +1,226 @@
+// Generated by tools/rixmsg.py from msg/mediator/SrvInfo.msg. Do not edit.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <map>
+#include <string>
+#include <string_view>
+#include <cstring>
+
+#include "rix/msg/serialization.hpp"
+#include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
+#include "rix/msg/mediator/Endpoint.hpp"
+
+namespace rix {
+namespace msg {
+namespace mediator {
+
+class SrvInfo : public Message {
+  public:
+    uint64_t id{};
+    uint64_t node_id{};
+    uint8_t protocol{};
+    std::string name{};
+    std::array<uint64_t, 2> request_hash{};
+    std::array<uint64_t, 2> response_hash{};
+    mediator::Endpoint endpoint{};
+
+    SrvInfo() = default;
+    SrvInfo(const SrvInfo &other) = default;
+    ~SrvInfo() = default;
+
+    static constexpr std::array<uint64_t, 2> HASH = {0xf316e18e00156ac7ULL, 0x57cc1984ce57bd2eULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            ID = 0,
+            NODE_ID = 1,
+            PROTOCOL = 2,
+            NAME = 3,
+            REQUEST_HASH = 4,
+            RESPONSE_HASH = 5,
+            ENDPOINT = 6,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 7;
+
+    size_t size() const override {
+        return static_size();
+    }
+
+    std::array<uint64_t, 2> hash() const override {
+        return HASH;
+    }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        static_serialize(dst, offset);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
+        using namespace detail;
+        size_t size = 0;
+        size += size_number(id);
+        size += size_number(node_id);
+        size += size_number(protocol);
+        size += size_string(name);
+        size += size_number_array(request_hash);
+        size += size_number_array(response_hash);
+        size += size_message(endpoint);
+        return size;
+    }
+
+    void static_serialize(uint8_t *dst, size_t &offset) const {
+        using namespace detail;
+        serialize_number(dst, offset, id);
+        serialize_number(dst, offset, node_id);
+        serialize_number(dst, offset, protocol);
+        serialize_string(dst, offset, name);
+        serialize_number_array(dst, offset, request_hash);
+        serialize_number_array(dst, offset, response_hash);
+        serialize_message(dst, offset, endpoint);
+    }
+
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        uint8_t *run = dst.extend(size_number(id) + size_number(node_id) + size_number(protocol) +
+                                  size_string(name) + size_number_array(request_hash) +
+                                  size_number_array(response_hash));
+        size_t offset = 0;
+        serialize_number(run, offset, id);
+        serialize_number(run, offset, node_id);
+        serialize_number(run, offset, protocol);
+        serialize_string(run, offset, name);
+        serialize_number_array(run, offset, request_hash);
+        serialize_number_array(run, offset, response_hash);
+        write_message(dst, endpoint);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!deserialize_number(id, src, size, offset)) { return false; };
+        if (!deserialize_number(node_id, src, size, offset)) { return false; };
+        if (!deserialize_number(protocol, src, size, offset)) { return false; };
+        if (!deserialize_string(name, src, size, offset)) { return false; };
+        if (!deserialize_number_array(request_hash, src, size, offset)) { return false; };
+        if (!deserialize_number_array(response_hash, src, size, offset)) { return false; };
+        if (!deserialize_message(endpoint, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_number(id, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_number(node_id, src, size, offset)) { return false; };
+        if (fields > 2 && !deserialize_number(protocol, src, size, offset)) { return false; };
+        if (fields > 3 && !deserialize_string(name, src, size, offset)) { return false; };
+        if (fields > 4 && !deserialize_number_array(request_hash, src, size, offset)) { return false; };
+        if (fields > 5 && !deserialize_number_array(response_hash, src, size, offset)) { return false; };
+        if (fields > 6 && !deserialize_message(endpoint, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` past a serialized SrvInfo without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!view_skip(17, size, offset)) { return false; };
+        if (!skip_string(src, size, offset)) { return false; };
+        if (!view_skip(32, size, offset)) { return false; };
+        if (!skip_message<mediator::Endpoint>(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized SrvInfo to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field < 3) {
+            static constexpr size_t offsets[] = {0, 8, 16};
+            return view_skip(offsets[field - 0], size, offset);
+        }
+        if (!view_skip(17, size, offset)) { return false; };
+        if (field == 3) { return true; };
+        if (!skip_string(src, size, offset)) { return false; };
+        if (field < 6) {
+            static constexpr size_t offsets[] = {0, 16};
+            return view_skip(offsets[field - 4], size, offset);
+        }
+        if (!view_skip(32, size, offset)) { return false; };
+        if (field == 6) { return true; };
+        if (!skip_message<mediator::Endpoint>(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized SrvInfo. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_number<uint64_t>(id_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(node_id_, src, size, offset)) { return false; };
+            if (!view_number<uint8_t>(protocol_, src, size, offset)) { return false; };
+            if (!view_string(name_, src, size, offset)) { return false; };
+            if (!view_number_array<uint64_t, 2>(request_hash_, src, size, offset)) { return false; };
+            if (!view_number_array<uint64_t, 2>(response_hash_, src, size, offset)) { return false; };
+            if (!view_message(endpoint_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        uint64_t id() const { return detail::load_number<uint64_t>(src_, id_); }
+
+        uint64_t node_id() const { return detail::load_number<uint64_t>(src_, node_id_); }
+
+        uint8_t protocol() const { return detail::load_number<uint8_t>(src_, protocol_); }
+
+        const std::string_view &name() const { return name_; }
+
+        const NumberSpan<uint64_t> &request_hash() const { return request_hash_; }
+
+        const NumberSpan<uint64_t> &response_hash() const { return response_hash_; }
+
+        const mediator::Endpoint::View &endpoint() const { return endpoint_; }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        size_t id_ = 0;
+        size_t node_id_ = 0;
+        size_t protocol_ = 0;
+        std::string_view name_{};
+        NumberSpan<uint64_t> request_hash_{};
+        NumberSpan<uint64_t> response_hash_{};
+        mediator::Endpoint::View endpoint_{};
+    };
+};
+
+} // namespace mediator
+} // namespace msg
+} // namespace rix
\ No newline at end of file
@@ -1,3 +1,4 @@
+// Generated by tools/rixmsg.py from msg/mediator/Status.msg. Do not edit.
 #pragma once
 
 #include <cstdint>
@@ -5,10 +6,12 @@
 #include <array>
 #include <map>
 #include <string>
+#include <string_view>
 #include <cstring>
 
 #include "rix/msg/serialization.hpp"
 #include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
 
 namespace rix {
 namespace msg {
@@ -16,37 +19,126 @@ namespace mediator {
 
 class Status : public Message {
   public:
-    uint64_t id;
-    uint8_t error;
+    uint64_t id{};
+    uint8_t error{};
 
     Status() = default;
     Status(const Status &other) = default;
     ~Status() = default;
 
+    static constexpr size_t FIXED_SIZE = detail::fixed_size_of<uint64_t, uint8_t>();
+    static constexpr std::array<uint64_t, 2> HASH = {0x41019c9daf6bb108ULL, 0x35ab29c38ce735d7ULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            ID = 0,
+            ERROR = 1,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 2;
+
     size_t size() const override {
-        using namespace detail;
-        size_t size = 0;
-        size += size_number(id);
-        size += size_number(error);
-        return size;
+        return static_size();
     }
 
     std::array<uint64_t, 2> hash() const override {
-        return {0x7fb8fd2b37424f48ULL, 0xab387927011d828bULL};
+        return HASH;
     }
 
     void serialize(uint8_t *dst, size_t &offset) const override {
-        using namespace detail;
-        serialize_number(dst, offset, id);
-        serialize_number(dst, offset, error);
+        static_serialize(dst, offset);
     }
 
     bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
+        return FIXED_SIZE;
+    }
+
+    void static_serialize(uint8_t *dst, size_t &offset) const {
+        using namespace detail;
+        serialize_fixed(dst, offset, id, error);
+    }
+
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        write_fixed(dst, id, error);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        return deserialize_fixed(src, size, offset, id, error);
+    }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
         using namespace detail;
-        if (!deserialize_number(id, src, size, offset)) { return false; };
-        if (!deserialize_number(error, src, size, offset)) { return false; };
+        if (fields > 0 && !deserialize_number(id, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_number(error, src, size, offset)) { return false; };
         return true;
     }
+
+    /**
+     * @brief Increments `offset` past a serialized Status without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        return view_skip(FIXED_SIZE, size, offset);
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized Status to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field < 2) {
+            static constexpr size_t offsets[] = {0, 8};
+            return view_skip(offsets[field - 0], size, offset);
+        }
+        if (!view_skip(9, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized Status. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_number<uint64_t>(id_, src, size, offset)) { return false; };
+            if (!view_number<uint8_t>(error_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        uint64_t id() const { return detail::load_number<uint64_t>(src_, id_); }
+
+        uint8_t error() const { return detail::load_number<uint8_t>(src_, error_); }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        size_t id_ = 0;
+        size_t error_ = 0;
+    };
 };
 
 } // namespace mediator
@@ -1,3 +1,4 @@
+// Generated by tools/rixmsg.py from msg/mediator/SubNotify.msg. Do not edit.
 #pragma once
 
 #include <cstdint>
@@ -5,10 +6,12 @@
 #include <array>
 #include <map>
 #include <string>
+#include <string_view>
 #include <cstring>
 
 #include "rix/msg/serialization.hpp"
 #include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
 #include "rix/msg/mediator/PubInfo.hpp"
 
 namespace rix {
@@ -17,16 +20,52 @@ namespace mediator {
 
 class SubNotify : public Message {
   public:
-    uint64_t id;
-    bool connect;
-    uint8_t error;
-    std::vector<mediator::PubInfo> publishers;
+    uint64_t id{};
+    bool connect{};
+    uint8_t error{};
+    std::vector<mediator::PubInfo> publishers{};
 
     SubNotify() = default;
     SubNotify(const SubNotify &other) = default;
     ~SubNotify() = default;
 
+    static constexpr std::array<uint64_t, 2> HASH = {0xec410caa1ca21a81ULL, 0x1162e01d6a54500eULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            ID = 0,
+            CONNECT = 1,
+            ERROR = 2,
+            PUBLISHERS = 3,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 4;
+
     size_t size() const override {
+        return static_size();
+    }
+
+    std::array<uint64_t, 2> hash() const override {
+        return HASH;
+    }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        static_serialize(dst, offset);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
         using namespace detail;
         size_t size = 0;
         size += size_number(id);
@@ -36,11 +75,7 @@ class SubNotify : public Message {
         return size;
     }
 
-    std::array<uint64_t, 2> hash() const override {
-        return {0xbd39de770bc7b08dULL, 0x40ae21673af29472ULL};
-    }
-
-    void serialize(uint8_t *dst, size_t &offset) const override {
+    void static_serialize(uint8_t *dst, size_t &offset) const {
         using namespace detail;
         serialize_number(dst, offset, id);
         serialize_number(dst, offset, connect);
@@ -48,7 +83,17 @@ class SubNotify : public Message {
         serialize_message_vector(dst, offset, publishers);
     }
 
-    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        uint8_t *run = dst.extend(size_number(id) + size_number(connect) + size_number(error));
+        size_t offset = 0;
+        serialize_number(run, offset, id);
+        serialize_number(run, offset, connect);
+        serialize_number(run, offset, error);
+        write_message_vector(dst, publishers);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
         using namespace detail;
         if (!deserialize_number(id, src, size, offset)) { return false; };
         if (!deserialize_number(connect, src, size, offset)) { return false; };
@@ -56,6 +101,80 @@ class SubNotify : public Message {
         if (!deserialize_message_vector(publishers, src, size, offset)) { return false; };
         return true;
     }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_number(id, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_number(connect, src, size, offset)) { return false; };
+        if (fields > 2 && !deserialize_number(error, src, size, offset)) { return false; };
+        if (fields > 3 && !deserialize_message_vector(publishers, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` past a serialized SubNotify without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!view_skip(10, size, offset)) { return false; };
+        if (!skip_message_vector<mediator::PubInfo>(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized SubNotify to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field < 3) {
+            static constexpr size_t offsets[] = {0, 8, 9};
+            return view_skip(offsets[field - 0], size, offset);
+        }
+        if (!view_skip(10, size, offset)) { return false; };
+        if (field == 3) { return true; };
+        if (!skip_message_vector<mediator::PubInfo>(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized SubNotify. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_number<uint64_t>(id_, src, size, offset)) { return false; };
+            if (!view_number<bool>(connect_, src, size, offset)) { return false; };
+            if (!view_number<uint8_t>(error_, src, size, offset)) { return false; };
+            if (!view_message_vector<mediator::PubInfo::View>(publishers_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        uint64_t id() const { return detail::load_number<uint64_t>(src_, id_); }
+
+        bool connect() const { return detail::load_number<bool>(src_, connect_); }
+
+        uint8_t error() const { return detail::load_number<uint8_t>(src_, error_); }
+
+        const SequenceView<mediator::PubInfo::View> &publishers() const { return publishers_; }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        size_t id_ = 0;
+        size_t connect_ = 0;
+        size_t error_ = 0;
+        SequenceView<mediator::PubInfo::View> publishers_{};
+    };
 };
 
 } // namespace mediator
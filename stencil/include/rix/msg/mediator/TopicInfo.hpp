@@ -1,3 +1,4 @@
+// Generated by tools/rixmsg.py from msg/mediator/TopicInfo.msg. Do not edit.
 #pragma once
 
 #include <cstdint>
@@ -5,10 +6,12 @@
 #include <array>
 #include <map>
 #include <string>
+#include <string_view>
 #include <cstring>
 
 #include "rix/msg/serialization.hpp"
 #include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
 
 namespace rix {
 namespace msg {
@@ -16,37 +19,151 @@ namespace mediator {
 
 class TopicInfo : public Message {
   public:
-    std::string name;
-    std::array<uint64_t, 2> message_hash;
+    std::string name{};
+    std::array<uint64_t, 2> message_hash{};
+    uint8_t encoding{};
 
     TopicInfo() = default;
     TopicInfo(const TopicInfo &other) = default;
     ~TopicInfo() = default;
 
+    static constexpr std::array<uint64_t, 2> HASH = {0xda307adb6d934774ULL, 0x9986b3c2da00745eULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            NAME = 0,
+            MESSAGE_HASH = 1,
+            ENCODING = 2,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 3;
+
     size_t size() const override {
+        return static_size();
+    }
+
+    std::array<uint64_t, 2> hash() const override {
+        return HASH;
+    }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        static_serialize(dst, offset);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
         using namespace detail;
         size_t size = 0;
         size += size_string(name);
         size += size_number_array(message_hash);
+        size += size_number(encoding);
         return size;
     }
 
-    std::array<uint64_t, 2> hash() const override {
-        return {0x8e64137b16fde8adULL, 0xe27995f7c4f32229ULL};
-    }
-
-    void serialize(uint8_t *dst, size_t &offset) const override {
+    void static_serialize(uint8_t *dst, size_t &offset) const {
         using namespace detail;
         serialize_string(dst, offset, name);
         serialize_number_array(dst, offset, message_hash);
+        serialize_number(dst, offset, encoding);
     }
 
-    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        uint8_t *run = dst.extend(size_string(name) + size_number_array(message_hash) +
+                                  size_number(encoding));
+        size_t offset = 0;
+        serialize_string(run, offset, name);
+        serialize_number_array(run, offset, message_hash);
+        serialize_number(run, offset, encoding);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
         using namespace detail;
         if (!deserialize_string(name, src, size, offset)) { return false; };
         if (!deserialize_number_array(message_hash, src, size, offset)) { return false; };
+        if (!deserialize_number(encoding, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_string(name, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_number_array(message_hash, src, size, offset)) { return false; };
+        if (fields > 2 && !deserialize_number(encoding, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` past a serialized TopicInfo without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!skip_string(src, size, offset)) { return false; };
+        if (!view_skip(17, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized TopicInfo to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field == 0) { return true; };
+        if (!skip_string(src, size, offset)) { return false; };
+        if (field < 3) {
+            static constexpr size_t offsets[] = {0, 16};
+            return view_skip(offsets[field - 1], size, offset);
+        }
+        if (!view_skip(17, size, offset)) { return false; };
         return true;
     }
+
+    /**
+     * @brief Read-only view of a serialized TopicInfo. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_string(name_, src, size, offset)) { return false; };
+            if (!view_number_array<uint64_t, 2>(message_hash_, src, size, offset)) { return false; };
+            if (!view_number<uint8_t>(encoding_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        const std::string_view &name() const { return name_; }
+
+        const NumberSpan<uint64_t> &message_hash() const { return message_hash_; }
+
+        uint8_t encoding() const { return detail::load_number<uint8_t>(src_, encoding_); }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        std::string_view name_{};
+        NumberSpan<uint64_t> message_hash_{};
+        size_t encoding_ = 0;
+    };
 };
 
 } // namespace mediator
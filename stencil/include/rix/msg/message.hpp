@@ -6,6 +6,8 @@
 #include <string>
 #include <vector>
 
+#include "rix/msg/writer.hpp"
+
 namespace rix {
 namespace msg {
 
@@ -15,6 +17,17 @@ class Message {
     virtual std::array<uint64_t, 2> hash() const = 0;
     virtual void serialize(uint8_t *dst, size_t &offset) const = 0;
     virtual bool deserialize(const uint8_t *src, size_t size, size_t &offset) = 0;
+
+    /**
+     * @brief Appends the serialized message to `dst`. Generated messages do
+     * this in a single pass; the default implementation sizes the message
+     * first.
+     *
+     */
+    virtual void serialize(Writer &dst) const {
+        size_t offset = 0;
+        serialize(dst.extend(size()), offset);
+    }
 };
 
 }  // namespace msg
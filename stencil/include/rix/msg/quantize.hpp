@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "rix/msg/endian.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace rix {
+namespace msg {
+namespace detail {
+
+/**
+ * @brief Conversion kernels between float arrays and the quantized arrays of
+ * compact encodings. Quantized values are round(value / scale), clamped to
+ * the range of the integer type, and are read and written in wire byte order.
+ * SSE2 converts 8 (uint16) or 16 (uint8) values per iteration, other targets
+ * use the scalar loops.
+ */
+inline constexpr uint16_t QUANTIZED_U16_MAX = 65534;
+inline constexpr uint16_t QUANTIZED_U16_INVALID = 65535; /**< Marks a value that was not finite */
+
+/**
+ * @brief Returns the largest finite value of `src`, or 0 if there is none.
+ *
+ */
+inline float max_finite(const float *src, size_t count) {
+    float max = 0.0f;
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    const __m128 abs = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    // Independent accumulators hide the latency of maxps
+    __m128 acc[4] = {_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+    for (; i + 16 <= count; i += 16) {
+        for (int j = 0; j < 4; j++) {
+            __m128 v = _mm_loadu_ps(src + i + 4 * j);
+            __m128 finite = _mm_cmplt_ps(_mm_and_ps(v, abs), inf);
+            acc[j] = _mm_max_ps(acc[j], _mm_and_ps(v, finite));
+        }
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, _mm_max_ps(_mm_max_ps(acc[0], acc[1]), _mm_max_ps(acc[2], acc[3])));
+    max = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+#endif
+    for (; i < count; i++) {
+        if (std::isfinite(src[i])) max = std::max(max, src[i]);
+    }
+    return max;
+}
+
+/**
+ * @brief Quantizes `count` floats to uint16 at `dst`. Values that are not
+ * finite are stored as QUANTIZED_U16_INVALID.
+ *
+ */
+inline void quantize_u16(const float *src, size_t count, float scale, uint8_t *dst) {
+    const float inv = 1.0f / scale;
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 inv_v = _mm_set1_ps(inv);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 max = _mm_set1_ps(QUANTIZED_U16_MAX);
+    const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    const __m128 abs = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128i invalid = _mm_set1_epi32(QUANTIZED_U16_INVALID);
+    const __m128i bias = _mm_set1_epi32(32768);
+    const __m128i flip = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+    auto convert = [&](__m128 v) {
+        __m128i finite = _mm_castps_si128(_mm_cmplt_ps(_mm_and_ps(v, abs), inf));
+        __m128i q = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(v, inv_v), zero), max));
+        q = _mm_or_si128(_mm_and_si128(finite, q), _mm_andnot_si128(finite, invalid));
+        // SSE2 only packs with signed saturation, so shift into the int16 range and back
+        return _mm_sub_epi32(q, bias);
+    };
+    for (; i + 8 <= count; i += 8) {
+        __m128i lo = convert(_mm_loadu_ps(src + i));
+        __m128i hi = convert(_mm_loadu_ps(src + i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 2 * i), _mm_xor_si128(_mm_packs_epi32(lo, hi), flip));
+    }
+#endif
+    for (; i < count; i++) {
+        uint16_t q = QUANTIZED_U16_INVALID;
+        if (std::isfinite(src[i])) {
+            q = static_cast<uint16_t>(std::lrint(std::clamp(src[i] * inv, 0.0f, float(QUANTIZED_U16_MAX))));
+        }
+        q = to_wire(q);
+        std::memcpy(dst + 2 * i, &q, sizeof(q));
+    }
+}
+
+/**
+ * @brief Converts `count` uint16 values at `src` back to floats.
+ * QUANTIZED_U16_INVALID becomes positive infinity.
+ *
+ */
+inline void dequantize_u16(const uint8_t *src, size_t count, float scale, float *dst) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 scale_v = _mm_set1_ps(scale);
+    const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i invalid = _mm_set1_epi32(QUANTIZED_U16_INVALID);
+    auto convert = [&](__m128i q) {
+        __m128 v = _mm_mul_ps(_mm_cvtepi32_ps(q), scale_v);
+        __m128 mask = _mm_castsi128_ps(_mm_cmpeq_epi32(q, invalid));
+        return _mm_or_ps(_mm_andnot_ps(mask, v), _mm_and_ps(mask, inf));
+    };
+    for (; i + 8 <= count; i += 8) {
+        __m128i q = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2 * i));
+        _mm_storeu_ps(dst + i, convert(_mm_unpacklo_epi16(q, zero)));
+        _mm_storeu_ps(dst + i + 4, convert(_mm_unpackhi_epi16(q, zero)));
+    }
+#endif
+    for (; i < count; i++) {
+        uint16_t q;
+        std::memcpy(&q, src + 2 * i, sizeof(q));
+        q = from_wire(q);
+        dst[i] = q == QUANTIZED_U16_INVALID ? std::numeric_limits<float>::infinity() : q * scale;
+    }
+}
+
+/**
+ * @brief Quantizes `count` floats to uint8 at `dst`. Values that are not
+ * finite are stored as 0.
+ *
+ */
+inline void quantize_u8(const float *src, size_t count, float scale, uint8_t *dst) {
+    const float inv = 1.0f / scale;
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 inv_v = _mm_set1_ps(inv);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 max = _mm_set1_ps(255.0f);
+    const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    const __m128 abs = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    auto convert = [&](const float *p) {
+        __m128 v = _mm_loadu_ps(p);
+        __m128 finite = _mm_cmplt_ps(_mm_and_ps(v, abs), inf);
+        v = _mm_and_ps(finite, _mm_min_ps(_mm_max_ps(_mm_mul_ps(v, inv_v), zero), max));
+        return _mm_cvtps_epi32(v);
+    };
+    for (; i + 16 <= count; i += 16) {
+        __m128i lo = _mm_packs_epi32(convert(src + i), convert(src + i + 4));
+        __m128i hi = _mm_packs_epi32(convert(src + i + 8), convert(src + i + 12));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for (; i < count; i++) {
+        dst[i] = std::isfinite(src[i]) ? static_cast<uint8_t>(std::lrint(std::clamp(src[i] * inv, 0.0f, 255.0f))) : 0;
+    }
+}
+
+/**
+ * @brief Converts `count` uint8 values at `src` back to floats.
+ *
+ */
+inline void dequantize_u8(const uint8_t *src, size_t count, float scale, float *dst) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 scale_v = _mm_set1_ps(scale);
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16) {
+        __m128i q = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i lo = _mm_unpacklo_epi8(q, zero);
+        __m128i hi = _mm_unpackhi_epi8(q, zero);
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale_v));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale_v));
+        _mm_storeu_ps(dst + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale_v));
+        _mm_storeu_ps(dst + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale_v));
+    }
+#endif
+    for (; i < count; i++) {
+        dst[i] = src[i] * scale;
+    }
+}
+
+}  // namespace detail
+}  // namespace msg
+}  // namespace rix
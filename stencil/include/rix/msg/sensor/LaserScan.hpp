@@ -1,3 +1,4 @@
+// Generated by tools/rixmsg.py from msg/sensor/LaserScan.msg. Do not edit.
 #pragma once
 
 #include <cstdint>
@@ -5,10 +6,12 @@
 #include <array>
 #include <map>
 #include <string>
+#include <string_view>
 #include <cstring>
 
 #include "rix/msg/serialization.hpp"
 #include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
 #include "rix/msg/standard/Header.hpp"
 
 namespace rix {
@@ -17,22 +20,64 @@ namespace sensor {
 
 class LaserScan : public Message {
   public:
-    standard::Header header;
-    float angle_min;
-    float angle_max;
-    float angle_increment;
-    float time_increment;
-    float scan_time;
-    float range_min;
-    float range_max;
-    std::vector<float> ranges;
-    std::vector<float> intensities;
+    standard::Header header{};
+    float angle_min{};
+    float angle_max{};
+    float angle_increment{};
+    float time_increment{};
+    float scan_time{};
+    float range_min{};
+    float range_max{};
+    std::vector<float> ranges{};
+    std::vector<float> intensities{};
 
     LaserScan() = default;
     LaserScan(const LaserScan &other) = default;
     ~LaserScan() = default;
 
+    static constexpr std::array<uint64_t, 2> HASH = {0xc3bd5eb7fd2f72ecULL, 0xb44055f1c69901bfULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            HEADER = 0,
+            ANGLE_MIN = 1,
+            ANGLE_MAX = 2,
+            ANGLE_INCREMENT = 3,
+            TIME_INCREMENT = 4,
+            SCAN_TIME = 5,
+            RANGE_MIN = 6,
+            RANGE_MAX = 7,
+            RANGES = 8,
+            INTENSITIES = 9,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 10;
+
     size_t size() const override {
+        return static_size();
+    }
+
+    std::array<uint64_t, 2> hash() const override {
+        return HASH;
+    }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        static_serialize(dst, offset);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
         using namespace detail;
         size_t size = 0;
         size += size_message(header);
@@ -48,11 +93,7 @@ class LaserScan : public Message {
         return size;
     }
 
-    std::array<uint64_t, 2> hash() const override {
-        return {0xc035b0c601092d80ULL, 0x3a3fb222f8dbb35bULL};
-    }
-
-    void serialize(uint8_t *dst, size_t &offset) const override {
+    void static_serialize(uint8_t *dst, size_t &offset) const {
         using namespace detail;
         serialize_message(dst, offset, header);
         serialize_number(dst, offset, angle_min);
@@ -66,7 +107,27 @@ class LaserScan : public Message {
         serialize_number_vector(dst, offset, intensities);
     }
 
-    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        write_message(dst, header);
+        uint8_t *run = dst.extend(size_number(angle_min) + size_number(angle_max) +
+                                  size_number(angle_increment) + size_number(time_increment) +
+                                  size_number(scan_time) + size_number(range_min) +
+                                  size_number(range_max) + size_number_vector(ranges) +
+                                  size_number_vector(intensities));
+        size_t offset = 0;
+        serialize_number(run, offset, angle_min);
+        serialize_number(run, offset, angle_max);
+        serialize_number(run, offset, angle_increment);
+        serialize_number(run, offset, time_increment);
+        serialize_number(run, offset, scan_time);
+        serialize_number(run, offset, range_min);
+        serialize_number(run, offset, range_max);
+        serialize_number_vector(run, offset, ranges);
+        serialize_number_vector(run, offset, intensities);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
         using namespace detail;
         if (!deserialize_message(header, src, size, offset)) { return false; };
         if (!deserialize_number(angle_min, src, size, offset)) { return false; };
@@ -80,6 +141,116 @@ class LaserScan : public Message {
         if (!deserialize_number_vector(intensities, src, size, offset)) { return false; };
         return true;
     }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_message(header, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_number(angle_min, src, size, offset)) { return false; };
+        if (fields > 2 && !deserialize_number(angle_max, src, size, offset)) { return false; };
+        if (fields > 3 && !deserialize_number(angle_increment, src, size, offset)) { return false; };
+        if (fields > 4 && !deserialize_number(time_increment, src, size, offset)) { return false; };
+        if (fields > 5 && !deserialize_number(scan_time, src, size, offset)) { return false; };
+        if (fields > 6 && !deserialize_number(range_min, src, size, offset)) { return false; };
+        if (fields > 7 && !deserialize_number(range_max, src, size, offset)) { return false; };
+        if (fields > 8 && !deserialize_number_vector(ranges, src, size, offset)) { return false; };
+        if (fields > 9 && !deserialize_number_vector(intensities, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` past a serialized LaserScan without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!skip_message<standard::Header>(src, size, offset)) { return false; };
+        if (!view_skip(28, size, offset)) { return false; };
+        if (!skip_number_vector<float>(src, size, offset)) { return false; };
+        if (!skip_number_vector<float>(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized LaserScan to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field == 0) { return true; };
+        if (!skip_message<standard::Header>(src, size, offset)) { return false; };
+        if (field < 8) {
+            static constexpr size_t offsets[] = {0, 4, 8, 12, 16, 20, 24};
+            return view_skip(offsets[field - 1], size, offset);
+        }
+        if (!view_skip(28, size, offset)) { return false; };
+        if (field == 8) { return true; };
+        if (!skip_number_vector<float>(src, size, offset)) { return false; };
+        if (field == 9) { return true; };
+        if (!skip_number_vector<float>(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized LaserScan. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_message(header_, src, size, offset)) { return false; };
+            if (!view_number<float>(angle_min_, src, size, offset)) { return false; };
+            if (!view_number<float>(angle_max_, src, size, offset)) { return false; };
+            if (!view_number<float>(angle_increment_, src, size, offset)) { return false; };
+            if (!view_number<float>(time_increment_, src, size, offset)) { return false; };
+            if (!view_number<float>(scan_time_, src, size, offset)) { return false; };
+            if (!view_number<float>(range_min_, src, size, offset)) { return false; };
+            if (!view_number<float>(range_max_, src, size, offset)) { return false; };
+            if (!view_number_vector<float>(ranges_, src, size, offset)) { return false; };
+            if (!view_number_vector<float>(intensities_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        const standard::Header::View &header() const { return header_; }
+
+        float angle_min() const { return detail::load_number<float>(src_, angle_min_); }
+
+        float angle_max() const { return detail::load_number<float>(src_, angle_max_); }
+
+        float angle_increment() const { return detail::load_number<float>(src_, angle_increment_); }
+
+        float time_increment() const { return detail::load_number<float>(src_, time_increment_); }
+
+        float scan_time() const { return detail::load_number<float>(src_, scan_time_); }
+
+        float range_min() const { return detail::load_number<float>(src_, range_min_); }
+
+        float range_max() const { return detail::load_number<float>(src_, range_max_); }
+
+        const NumberSpan<float> &ranges() const { return ranges_; }
+
+        const NumberSpan<float> &intensities() const { return intensities_; }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        standard::Header::View header_{};
+        size_t angle_min_ = 0;
+        size_t angle_max_ = 0;
+        size_t angle_increment_ = 0;
+        size_t time_increment_ = 0;
+        size_t scan_time_ = 0;
+        size_t range_min_ = 0;
+        size_t range_max_ = 0;
+        NumberSpan<float> ranges_{};
+        NumberSpan<float> intensities_{};
+    };
 };
 
 } // namespace sensor
@@ -0,0 +1,284 @@
+// Generated by tools/rixmsg.py from msg/sensor/QuantizedLaserScan.msg. Do not edit.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <map>
+#include <string>
+#include <string_view>
+#include <cstring>
+
+#include "rix/msg/serialization.hpp"
+#include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
+#include "rix/msg/standard/Header.hpp"
+
+namespace rix {
+namespace msg {
+namespace sensor {
+
+class QuantizedLaserScan : public Message {
+  public:
+    standard::Header header{};
+    float angle_min{};
+    float angle_max{};
+    float angle_increment{};
+    float time_increment{};
+    float scan_time{};
+    float range_min{};
+    float range_max{};
+    float range_scale{};
+    std::vector<uint16_t> ranges{};
+    float intensity_scale{};
+    std::vector<uint8_t> intensities{};
+
+    QuantizedLaserScan() = default;
+    QuantizedLaserScan(const QuantizedLaserScan &other) = default;
+    ~QuantizedLaserScan() = default;
+
+    static constexpr std::array<uint64_t, 2> HASH = {0x31b694e5c20b37ccULL, 0x0df71c59a200460bULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            HEADER = 0,
+            ANGLE_MIN = 1,
+            ANGLE_MAX = 2,
+            ANGLE_INCREMENT = 3,
+            TIME_INCREMENT = 4,
+            SCAN_TIME = 5,
+            RANGE_MIN = 6,
+            RANGE_MAX = 7,
+            RANGE_SCALE = 8,
+            RANGES = 9,
+            INTENSITY_SCALE = 10,
+            INTENSITIES = 11,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 12;
+
+    size_t size() const override {
+        return static_size();
+    }
+
+    std::array<uint64_t, 2> hash() const override {
+        return HASH;
+    }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        static_serialize(dst, offset);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
+        using namespace detail;
+        size_t size = 0;
+        size += size_message(header);
+        size += size_number(angle_min);
+        size += size_number(angle_max);
+        size += size_number(angle_increment);
+        size += size_number(time_increment);
+        size += size_number(scan_time);
+        size += size_number(range_min);
+        size += size_number(range_max);
+        size += size_number(range_scale);
+        size += size_number_vector(ranges);
+        size += size_number(intensity_scale);
+        size += size_number_vector(intensities);
+        return size;
+    }
+
+    void static_serialize(uint8_t *dst, size_t &offset) const {
+        using namespace detail;
+        serialize_message(dst, offset, header);
+        serialize_number(dst, offset, angle_min);
+        serialize_number(dst, offset, angle_max);
+        serialize_number(dst, offset, angle_increment);
+        serialize_number(dst, offset, time_increment);
+        serialize_number(dst, offset, scan_time);
+        serialize_number(dst, offset, range_min);
+        serialize_number(dst, offset, range_max);
+        serialize_number(dst, offset, range_scale);
+        serialize_number_vector(dst, offset, ranges);
+        serialize_number(dst, offset, intensity_scale);
+        serialize_number_vector(dst, offset, intensities);
+    }
+
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        write_message(dst, header);
+        uint8_t *run = dst.extend(size_number(angle_min) + size_number(angle_max) +
+                                  size_number(angle_increment) + size_number(time_increment) +
+                                  size_number(scan_time) + size_number(range_min) +
+                                  size_number(range_max) + size_number(range_scale) +
+                                  size_number_vector(ranges) + size_number(intensity_scale) +
+                                  size_number_vector(intensities));
+        size_t offset = 0;
+        serialize_number(run, offset, angle_min);
+        serialize_number(run, offset, angle_max);
+        serialize_number(run, offset, angle_increment);
+        serialize_number(run, offset, time_increment);
+        serialize_number(run, offset, scan_time);
+        serialize_number(run, offset, range_min);
+        serialize_number(run, offset, range_max);
+        serialize_number(run, offset, range_scale);
+        serialize_number_vector(run, offset, ranges);
+        serialize_number(run, offset, intensity_scale);
+        serialize_number_vector(run, offset, intensities);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!deserialize_message(header, src, size, offset)) { return false; };
+        if (!deserialize_number(angle_min, src, size, offset)) { return false; };
+        if (!deserialize_number(angle_max, src, size, offset)) { return false; };
+        if (!deserialize_number(angle_increment, src, size, offset)) { return false; };
+        if (!deserialize_number(time_increment, src, size, offset)) { return false; };
+        if (!deserialize_number(scan_time, src, size, offset)) { return false; };
+        if (!deserialize_number(range_min, src, size, offset)) { return false; };
+        if (!deserialize_number(range_max, src, size, offset)) { return false; };
+        if (!deserialize_number(range_scale, src, size, offset)) { return false; };
+        if (!deserialize_number_vector(ranges, src, size, offset)) { return false; };
+        if (!deserialize_number(intensity_scale, src, size, offset)) { return false; };
+        if (!deserialize_number_vector(intensities, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_message(header, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_number(angle_min, src, size, offset)) { return false; };
+        if (fields > 2 && !deserialize_number(angle_max, src, size, offset)) { return false; };
+        if (fields > 3 && !deserialize_number(angle_increment, src, size, offset)) { return false; };
+        if (fields > 4 && !deserialize_number(time_increment, src, size, offset)) { return false; };
+        if (fields > 5 && !deserialize_number(scan_time, src, size, offset)) { return false; };
+        if (fields > 6 && !deserialize_number(range_min, src, size, offset)) { return false; };
+        if (fields > 7 && !deserialize_number(range_max, src, size, offset)) { return false; };
+        if (fields > 8 && !deserialize_number(range_scale, src, size, offset)) { return false; };
+        if (fields > 9 && !deserialize_number_vector(ranges, src, size, offset)) { return false; };
+        if (fields > 10 && !deserialize_number(intensity_scale, src, size, offset)) { return false; };
+        if (fields > 11 && !deserialize_number_vector(intensities, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` past a serialized QuantizedLaserScan without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!skip_message<standard::Header>(src, size, offset)) { return false; };
+        if (!view_skip(32, size, offset)) { return false; };
+        if (!skip_number_vector<uint16_t>(src, size, offset)) { return false; };
+        if (!view_skip(4, size, offset)) { return false; };
+        if (!skip_number_vector<uint8_t>(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized QuantizedLaserScan to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field == 0) { return true; };
+        if (!skip_message<standard::Header>(src, size, offset)) { return false; };
+        if (field < 9) {
+            static constexpr size_t offsets[] = {0, 4, 8, 12, 16, 20, 24, 28};
+            return view_skip(offsets[field - 1], size, offset);
+        }
+        if (!view_skip(32, size, offset)) { return false; };
+        if (field == 9) { return true; };
+        if (!skip_number_vector<uint16_t>(src, size, offset)) { return false; };
+        if (field == 10) { return true; };
+        if (!view_skip(4, size, offset)) { return false; };
+        if (field == 11) { return true; };
+        if (!skip_number_vector<uint8_t>(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized QuantizedLaserScan. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_message(header_, src, size, offset)) { return false; };
+            if (!view_number<float>(angle_min_, src, size, offset)) { return false; };
+            if (!view_number<float>(angle_max_, src, size, offset)) { return false; };
+            if (!view_number<float>(angle_increment_, src, size, offset)) { return false; };
+            if (!view_number<float>(time_increment_, src, size, offset)) { return false; };
+            if (!view_number<float>(scan_time_, src, size, offset)) { return false; };
+            if (!view_number<float>(range_min_, src, size, offset)) { return false; };
+            if (!view_number<float>(range_max_, src, size, offset)) { return false; };
+            if (!view_number<float>(range_scale_, src, size, offset)) { return false; };
+            if (!view_number_vector<uint16_t>(ranges_, src, size, offset)) { return false; };
+            if (!view_number<float>(intensity_scale_, src, size, offset)) { return false; };
+            if (!view_number_vector<uint8_t>(intensities_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        const standard::Header::View &header() const { return header_; }
+
+        float angle_min() const { return detail::load_number<float>(src_, angle_min_); }
+
+        float angle_max() const { return detail::load_number<float>(src_, angle_max_); }
+
+        float angle_increment() const { return detail::load_number<float>(src_, angle_increment_); }
+
+        float time_increment() const { return detail::load_number<float>(src_, time_increment_); }
+
+        float scan_time() const { return detail::load_number<float>(src_, scan_time_); }
+
+        float range_min() const { return detail::load_number<float>(src_, range_min_); }
+
+        float range_max() const { return detail::load_number<float>(src_, range_max_); }
+
+        float range_scale() const { return detail::load_number<float>(src_, range_scale_); }
+
+        const NumberSpan<uint16_t> &ranges() const { return ranges_; }
+
+        float intensity_scale() const { return detail::load_number<float>(src_, intensity_scale_); }
+
+        const NumberSpan<uint8_t> &intensities() const { return intensities_; }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        standard::Header::View header_{};
+        size_t angle_min_ = 0;
+        size_t angle_max_ = 0;
+        size_t angle_increment_ = 0;
+        size_t time_increment_ = 0;
+        size_t scan_time_ = 0;
+        size_t range_min_ = 0;
+        size_t range_max_ = 0;
+        size_t range_scale_ = 0;
+        NumberSpan<uint16_t> ranges_{};
+        size_t intensity_scale_ = 0;
+        NumberSpan<uint8_t> intensities_{};
+    };
+};
+
+} // namespace sensor
+} // namespace msg
+} // namespace rix
\ No newline at end of file
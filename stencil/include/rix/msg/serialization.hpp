@@ -7,7 +7,9 @@
 #include <string>
 #include <vector>
 
+#include "rix/msg/endian.hpp"
 #include "rix/msg/message.hpp"
+#include "rix/msg/traits.hpp"
 
 namespace rix {
 namespace msg {
@@ -20,6 +22,10 @@ inline uint32_t size_number(const T &src) {
 }
 inline uint32_t size_string(const std::string &src) { return 4 + src.size(); }
 inline uint32_t size_message(const Message &src) { return src.size(); }
+template <StaticMessage T>
+inline uint32_t size_message(const T &src) {
+    return src.static_size();
+}
 template <typename T, size_t N>
 inline uint32_t size_number_array(const std::array<T, N> &src) {
     static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
@@ -70,7 +76,8 @@ template <typename T>
 inline void serialize_number(uint8_t *dst, size_t &offset, const T &src) {
     static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
     /**< TODO */
-    std::memcpy(dst + offset, &src, sizeof(T));
+    const T wire = to_wire(src);
+    std::memcpy(dst + offset, &wire, sizeof(T));
     offset += sizeof(T);
 }
 
@@ -86,8 +93,7 @@ inline void serialize_number(uint8_t *dst, size_t &offset, const T &src) {
 inline void serialize_string(uint8_t *dst, size_t &offset, const std::string &src) {
     /**< TODO */
     uint32_t size = src.size();
-    std::memcpy(dst + offset, &size, 4);
-    offset += 4;
+    serialize_number(dst, offset, size);
     std::memcpy(dst + offset, src.data(), size);
     offset += size;
 }
@@ -106,6 +112,15 @@ inline void serialize_message(uint8_t *dst, size_t &offset, const Message &src)
     src.serialize(dst, offset);
 }
 
+/**
+ * @brief Serializes a generated message `src` without a virtual call.
+ *
+ */
+template <StaticMessage T>
+inline void serialize_message(uint8_t *dst, size_t &offset, const T &src) {
+    src.static_serialize(dst, offset);
+}
+
 /**
  * @brief Serializes a number array `src` and stores it in the byte array `dst`
  * at `offset`. `offset` is incremented by the number of bytes written to `dst`.
@@ -124,6 +139,7 @@ inline void serialize_number_array(uint8_t *dst, size_t &offset,
     static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
     uint32_t size = N * sizeof(T);
     std::memcpy(dst + offset, src.data(), size);
+    convert_wire_array<T>(dst + offset, N);
     offset += size;
 }
 
@@ -180,9 +196,9 @@ inline void serialize_number_vector(uint8_t *dst, size_t &offset,
     /**< TODO */
     uint32_t size = src.size();
     serialize_number(dst, offset, size);
-    size *= sizeof(T);
-    std::memcpy(dst + offset, src.data(), size);
-    offset += size;
+    std::memcpy(dst + offset, src.data(), size * sizeof(T));
+    convert_wire_array<T>(dst + offset, size);
+    offset += size * sizeof(T);
 }
 
 /**
@@ -240,8 +256,9 @@ template <typename T>
 inline bool deserialize_number(T &dst, const uint8_t *src, size_t size, size_t &offset) {
     static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
     /**< TODO */
-    if (offset + sizeof(T) > size) return false;
-    dst = *reinterpret_cast<const T *>(src + offset);
+    if (size < offset || size - offset < sizeof(T)) return false;
+    std::memcpy(&dst, src + offset, sizeof(T));
+    dst = from_wire(dst);
     offset += sizeof(T);
     return true;
 }
@@ -263,7 +280,7 @@ inline bool deserialize_string(std::string &dst, const uint8_t *src, size_t size
     /**< TODO */
     uint32_t str_size;
     if (!deserialize_number(str_size, src, size, offset)) return false;
-    if (offset + str_size > size) return false;
+    if (size - offset < str_size) return false;
     dst.resize(str_size);
     std::memcpy(dst.data(), src + offset, str_size);
     offset += str_size;
@@ -288,6 +305,15 @@ inline bool deserialize_message(Message &dst, const uint8_t *src, size_t size,
     return dst.deserialize(src, size, offset);
 }
 
+/**
+ * @brief Deserializes a generated message `dst` without a virtual call.
+ *
+ */
+template <StaticMessage T>
+inline bool deserialize_message(T &dst, const uint8_t *src, size_t size, size_t &offset) {
+    return dst.static_deserialize(src, size, offset);
+}
+
 /**
  * @brief Deserializes a string from the byte array `src` at `offset` and stores
  * it into `dst`. `src` must be at least `size` bytes long.
@@ -308,8 +334,9 @@ inline bool deserialize_number_array(std::array<T, N> &dst, const uint8_t *src,
     static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
     /**< TODO */
     uint32_t arr_size = N * sizeof(T);
-    if (offset + arr_size > size) return false;
+    if (size < offset || size - offset < arr_size) return false;
     std::memcpy(dst.data(), src + offset, arr_size);
+    convert_wire_array<T>(reinterpret_cast<uint8_t *>(dst.data()), N);
     offset += arr_size;
     return true;
 }
@@ -382,10 +409,11 @@ inline bool deserialize_number_vector(std::vector<T> &dst, const uint8_t *src,
     /**< TODO */
     uint32_t vec_size;
     if (!deserialize_number(vec_size, src, size, offset)) return false;
-    if (offset + vec_size > size) return false;
+    if ((size - offset) / sizeof(T) < vec_size) return false;
     dst.resize(vec_size);
     size_t size_bytes = vec_size * sizeof(T);
-    std::memcpy(dst.data(), src + offset, size_bytes);
+    if (size_bytes > 0) std::memcpy(dst.data(), src + offset, size_bytes);
+    convert_wire_array<T>(reinterpret_cast<uint8_t *>(dst.data()), vec_size);
     offset += size_bytes;
     return true;
 }
@@ -407,6 +435,9 @@ inline bool deserialize_string_vector(std::vector<std::string> &dst, const uint8
     /**< TODO */
     uint32_t vec_size;
     if (!deserialize_number(vec_size, src, size, offset)) return false;
+    // Every string takes at least its 4-byte length, so reject counts that
+    // cannot fit before allocating them
+    if (vec_size > (size - offset) / 4) return false;
     dst.resize(vec_size);
     for (auto &s : dst) {
         if (!deserialize_string(s, src, size, offset)) return false;
@@ -434,12 +465,181 @@ inline bool deserialize_message_vector(std::vector<T> &dst, const uint8_t *src,
     /**< TODO */
     uint32_t vec_size;
     if (!deserialize_number(vec_size, src, size, offset)) return false;
+    if constexpr (is_fixed_size_v<T>) {
+        // One bounds check for the whole vector
+        if (size < offset || (size - offset) / fixed_size<T>() < vec_size) return false;
+    } else {
+        // A variable-size message holds at least one 4-byte length
+        if (vec_size > (size - offset) / 4) return false;
+    }
     dst.resize(vec_size);
     for (auto &m : dst) {
         if (!deserialize_message(m, src, size, offset)) return false;
     }
     return true;
 }
+
+/**
+ * @brief Serializes a fixed-size field `src` into the byte array `dst` at
+ * `offset` without checking bounds. Nested fixed-size messages are serialized
+ * with a non-virtual call so that the compiler can inline them.
+ *
+ * @tparam T A fixed-size type
+ * @param dst The destination byte array
+ * @param offset The offset in the byte array at which to write (incremented by
+ * fixed_size<T>())
+ * @param src The source field
+ */
+template <typename T>
+inline void store_fixed(uint8_t *dst, size_t &offset, const T &src) {
+    static_assert(is_fixed_size_v<T>, "T must be a fixed-size type");
+    if constexpr (std::is_arithmetic_v<T>) {
+        serialize_number(dst, offset, src);
+    } else if constexpr (is_std_array<T>::value) {
+        if constexpr (std::is_arithmetic_v<typename T::value_type>) {
+            std::memcpy(dst + offset, src.data(), fixed_size<T>());
+            convert_wire_array<typename T::value_type>(dst + offset, src.size());
+            offset += fixed_size<T>();
+        } else {
+            for (const auto &e : src) store_fixed(dst, offset, e);
+        }
+    } else {
+        serialize_message(dst, offset, src);
+    }
+}
+
+/**
+ * @brief Deserializes a fixed-size field `dst` from the byte array `src` at
+ * `offset` without checking bounds. The caller must have checked that
+ * fixed_size<T>() bytes are available.
+ *
+ * @tparam T A fixed-size type
+ * @param dst The destination field
+ * @param src The source byte array
+ * @param offset The position in the source byte array to deserialize data from
+ */
+template <typename T>
+inline void load_fixed(T &dst, const uint8_t *src, size_t &offset) {
+    static_assert(is_fixed_size_v<T>, "T must be a fixed-size type");
+    if constexpr (std::is_arithmetic_v<T>) {
+        std::memcpy(&dst, src + offset, sizeof(T));
+        dst = from_wire(dst);
+        offset += sizeof(T);
+    } else if constexpr (is_std_array<T>::value) {
+        if constexpr (std::is_arithmetic_v<typename T::value_type>) {
+            std::memcpy(dst.data(), src + offset, fixed_size<T>());
+            convert_wire_array<typename T::value_type>(reinterpret_cast<uint8_t *>(dst.data()), dst.size());
+            offset += fixed_size<T>();
+        } else {
+            for (auto &e : dst) load_fixed(e, src, offset);
+        }
+    } else {
+        // The nested message's own bounds check is folded away
+        deserialize_message(dst, src, offset + fixed_size<T>(), offset);
+    }
+}
+
+/**
+ * @brief Serializes the fixed-size fields of a message into the byte array
+ * `dst` at `offset`. The fields are written back to back, so the compiler
+ * merges the copies into a single store of the message's FIXED_SIZE bytes.
+ *
+ * @param dst The destination byte array
+ * @param offset The offset in the byte array at which to write (incremented by
+ * number of bytes written)
+ * @param fields The fields of the message in declaration order
+ */
+template <typename... Ts>
+inline void serialize_fixed(uint8_t *dst, size_t &offset, const Ts &...fields) {
+    (store_fixed(dst, offset, fields), ...);
+}
+
+/**
+ * @brief Deserializes the fixed-size fields of a message from the byte array
+ * `src` at `offset` with a single bounds check.
+ *
+ * @param src The source byte array
+ * @param size The size of the byte array
+ * @param offset The position in the source byte array to deserialize data from
+ * @param fields The fields of the message in declaration order
+ * @return `false` if fewer than fixed_size_of<Ts...>() bytes are available in
+ * the source byte array. `true` otherwise.
+ */
+template <typename... Ts>
+inline bool deserialize_fixed(const uint8_t *src, size_t size, size_t &offset, Ts &...fields) {
+    if (size < offset || size - offset < fixed_size_of<Ts...>()) return false;
+    (load_fixed(fields, src, offset), ...);
+    return true;
+}
+
+/**
+ * @brief The write functions below append a field to the Writer `dst` in a
+ * single pass, growing it as needed. They produce the same bytes as the
+ * corresponding serialize functions.
+ */
+template <typename T>
+inline void write_number(Writer &dst, const T &src) {
+    size_t offset = 0;
+    serialize_number(dst.extend(sizeof(T)), offset, src);
+}
+
+inline void write_string(Writer &dst, const std::string &src) {
+    size_t offset = 0;
+    serialize_string(dst.extend(size_string(src)), offset, src);
+}
+
+inline void write_message(Writer &dst, const Message &src) { src.serialize(dst); }
+
+template <StaticMessage T>
+inline void write_message(Writer &dst, const T &src) {
+    src.static_serialize(dst);
+}
+
+template <typename T, size_t N>
+inline void write_number_array(Writer &dst, const std::array<T, N> &src) {
+    size_t offset = 0;
+    serialize_number_array(dst.extend(size_number_array(src)), offset, src);
+}
+
+template <size_t N>
+inline void write_string_array(Writer &dst, const std::array<std::string, N> &src) {
+    for (const auto &s : src) write_string(dst, s);
+}
+
+template <typename T, size_t N>
+inline void write_message_array(Writer &dst, const std::array<T, N> &src) {
+    static_assert(std::is_base_of<Message, T>::value, "T must derive from Message");
+    for (const auto &m : src) write_message(dst, m);
+}
+
+template <typename T>
+inline void write_number_vector(Writer &dst, const std::vector<T> &src) {
+    size_t offset = 0;
+    serialize_number_vector(dst.extend(size_number_vector(src)), offset, src);
+}
+
+inline void write_string_vector(Writer &dst, const std::vector<std::string> &src) {
+    write_number(dst, static_cast<uint32_t>(src.size()));
+    for (const auto &s : src) write_string(dst, s);
+}
+
+template <typename T>
+inline void write_message_vector(Writer &dst, const std::vector<T> &src) {
+    static_assert(std::is_base_of<Message, T>::value, "T must derive from Message");
+    write_number(dst, static_cast<uint32_t>(src.size()));
+    for (const auto &m : src) write_message(dst, m);
+}
+
+/**
+ * @brief Appends the fixed-size fields of a message to `dst` with a single
+ * capacity check.
+ *
+ */
+template <typename... Ts>
+inline void write_fixed(Writer &dst, const Ts &...fields) {
+    size_t offset = 0;
+    serialize_fixed(dst.extend(fixed_size_of<Ts...>()), offset, fields...);
+}
 }  // namespace detail
 }  // namespace msg
 }  // namespace rix
\ No newline at end of file
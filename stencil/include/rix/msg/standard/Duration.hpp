@@ -1,3 +1,4 @@
+// Generated by tools/rixmsg.py from msg/standard/Duration.msg. Do not edit.
 #pragma once
 
 #include <cstdint>
@@ -5,10 +6,12 @@
 #include <array>
 #include <map>
 #include <string>
+#include <string_view>
 #include <cstring>
 
 #include "rix/msg/serialization.hpp"
 #include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
 
 namespace rix {
 namespace msg {
@@ -16,37 +19,126 @@ namespace standard {
 
 class Duration : public Message {
   public:
-    int32_t sec;
-    int32_t nsec;
+    int32_t sec{};
+    int32_t nsec{};
 
     Duration() = default;
     Duration(const Duration &other) = default;
     ~Duration() = default;
 
+    static constexpr size_t FIXED_SIZE = detail::fixed_size_of<int32_t, int32_t>();
+    static constexpr std::array<uint64_t, 2> HASH = {0x82517d8e133732a2ULL, 0xf977ae897f4af097ULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            SEC = 0,
+            NSEC = 1,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 2;
+
     size_t size() const override {
-        using namespace detail;
-        size_t size = 0;
-        size += size_number(sec);
-        size += size_number(nsec);
-        return size;
+        return static_size();
     }
 
     std::array<uint64_t, 2> hash() const override {
-        return {0x3cfabdd6930400b6ULL, 0x2301ecce2a9d00f6ULL};
+        return HASH;
     }
 
     void serialize(uint8_t *dst, size_t &offset) const override {
-        using namespace detail;
-        serialize_number(dst, offset, sec);
-        serialize_number(dst, offset, nsec);
+        static_serialize(dst, offset);
     }
 
     bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
+        return FIXED_SIZE;
+    }
+
+    void static_serialize(uint8_t *dst, size_t &offset) const {
+        using namespace detail;
+        serialize_fixed(dst, offset, sec, nsec);
+    }
+
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        write_fixed(dst, sec, nsec);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        return deserialize_fixed(src, size, offset, sec, nsec);
+    }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
         using namespace detail;
-        if (!deserialize_number(sec, src, size, offset)) { return false; };
-        if (!deserialize_number(nsec, src, size, offset)) { return false; };
+        if (fields > 0 && !deserialize_number(sec, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_number(nsec, src, size, offset)) { return false; };
         return true;
     }
+
+    /**
+     * @brief Increments `offset` past a serialized Duration without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        return view_skip(FIXED_SIZE, size, offset);
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized Duration to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field < 2) {
+            static constexpr size_t offsets[] = {0, 4};
+            return view_skip(offsets[field - 0], size, offset);
+        }
+        if (!view_skip(8, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized Duration. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_number<int32_t>(sec_, src, size, offset)) { return false; };
+            if (!view_number<int32_t>(nsec_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        int32_t sec() const { return detail::load_number<int32_t>(src_, sec_); }
+
+        int32_t nsec() const { return detail::load_number<int32_t>(src_, nsec_); }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        size_t sec_ = 0;
+        size_t nsec_ = 0;
+    };
 };
 
 } // namespace standard
@@ -1,3 +1,4 @@
+// Generated by tools/rixmsg.py from msg/standard/Header.msg. Do not edit.
 #pragma once
 
 #include <cstdint>
@@ -5,10 +6,12 @@
 #include <array>
 #include <map>
 #include <string>
+#include <string_view>
 #include <cstring>
 
 #include "rix/msg/serialization.hpp"
 #include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
 #include "rix/msg/standard/Time.hpp"
 
 namespace rix {
@@ -25,7 +28,42 @@ class Header : public Message {
     Header(const Header &other) = default;
     ~Header() = default;
 
+    static constexpr std::array<uint64_t, 2> HASH = {0x84221f3b3c76ff01ULL, 0x3472de8bb6eff9caULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            SEQ = 0,
+            STAMP = 1,
+            FRAME_ID = 2,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 3;
+
     size_t size() const override {
+        return static_size();
+    }
+
+    std::array<uint64_t, 2> hash() const override {
+        return HASH;
+    }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        static_serialize(dst, offset);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
         using namespace detail;
         size_t size = 0;
         size += size_number(seq);
@@ -34,24 +72,100 @@ class Header : public Message {
         return size;
     }
 
-    std::array<uint64_t, 2> hash() const override {
-        return {0x5c6e963f7b8b9afeULL, 0x9b53bcf470f873c6ULL};
-    }
-
-    void serialize(uint8_t *dst, size_t &offset) const override {
+    void static_serialize(uint8_t *dst, size_t &offset) const {
         using namespace detail;
         serialize_number(dst, offset, seq);
         serialize_message(dst, offset, stamp);
         serialize_string(dst, offset, frame_id);
     }
 
-    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        uint8_t *run = dst.extend(size_number(seq));
+        size_t offset = 0;
+        serialize_number(run, offset, seq);
+        write_message(dst, stamp);
+        run = dst.extend(size_string(frame_id));
+        offset = 0;
+        serialize_string(run, offset, frame_id);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
         using namespace detail;
         if (!deserialize_number(seq, src, size, offset)) { return false; };
         if (!deserialize_message(stamp, src, size, offset)) { return false; };
         if (!deserialize_string(frame_id, src, size, offset)) { return false; };
         return true;
     }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_number(seq, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_message(stamp, src, size, offset)) { return false; };
+        if (fields > 2 && !deserialize_string(frame_id, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` past a serialized Header without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!view_skip(12, size, offset)) { return false; };
+        if (!skip_string(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized Header to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field < 2) {
+            static constexpr size_t offsets[] = {0, 4};
+            return view_skip(offsets[field - 0], size, offset);
+        }
+        if (!view_skip(12, size, offset)) { return false; };
+        if (field == 2) { return true; };
+        if (!skip_string(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized Header. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_number<uint32_t>(seq_, src, size, offset)) { return false; };
+            if (!view_message(stamp_, src, size, offset)) { return false; };
+            if (!view_string(frame_id_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        uint32_t seq() const { return detail::load_number<uint32_t>(src_, seq_); }
+
+        const standard::Time::View &stamp() const { return stamp_; }
+
+        const std::string_view &frame_id() const { return frame_id_; }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        size_t seq_ = 0;
+        standard::Time::View stamp_{};
+        std::string_view frame_id_{};
+    };
 };
 
 } // namespace standard
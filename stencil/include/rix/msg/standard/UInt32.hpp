@@ -1,3 +1,4 @@
+// Generated by tools/rixmsg.py from msg/standard/UInt32.msg. Do not edit.
 #pragma once
 
 #include <cstdint>
@@ -5,10 +6,12 @@
 #include <array>
 #include <map>
 #include <string>
+#include <string_view>
 #include <cstring>
 
 #include "rix/msg/serialization.hpp"
 #include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
 
 namespace rix {
 namespace msg {
@@ -22,27 +25,110 @@ class UInt32 : public Message {
     UInt32(const UInt32 &other) = default;
     ~UInt32() = default;
 
+    static constexpr size_t FIXED_SIZE = detail::fixed_size_of<uint32_t>();
+    static constexpr std::array<uint64_t, 2> HASH = {0x2a16025896f2e259ULL, 0x4c8a128707bfa1e5ULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            DATA = 0,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 1;
+
     size_t size() const override {
-        using namespace detail;
-        size_t size = 0;
-        size += size_number(data);
-        return size;
+        return static_size();
     }
 
     std::array<uint64_t, 2> hash() const override {
-        return {0x55aa2bc284c5d8d8ULL, 0x59a88852ffabad79ULL};
+        return HASH;
     }
 
     void serialize(uint8_t *dst, size_t &offset) const override {
-        using namespace detail;
-        serialize_number(dst, offset, data);
+        static_serialize(dst, offset);
     }
 
     bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
+        return FIXED_SIZE;
+    }
+
+    void static_serialize(uint8_t *dst, size_t &offset) const {
         using namespace detail;
-        if (!deserialize_number(data, src, size, offset)) { return false; };
+        serialize_fixed(dst, offset, data);
+    }
+
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        write_fixed(dst, data);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        return deserialize_fixed(src, size, offset, data);
+    }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_number(data, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` past a serialized UInt32 without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        return view_skip(FIXED_SIZE, size, offset);
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized UInt32 to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field == 0) { return true; };
+        if (!view_skip(4, size, offset)) { return false; };
         return true;
     }
+
+    /**
+     * @brief Read-only view of a serialized UInt32. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_number<uint32_t>(data_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        uint32_t data() const { return detail::load_number<uint32_t>(src_, data_); }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        size_t data_ = 0;
+    };
 };
 
 } // namespace standard
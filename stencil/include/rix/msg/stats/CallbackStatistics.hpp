@@ -0,0 +1,254 @@
+// Generated by tools/rixmsg.py from msg/stats/CallbackStatistics.msg. Do not edit.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <map>
+#include <string>
+#include <string_view>
+#include <cstring>
+
+#include "rix/msg/serialization.hpp"
+#include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
+
+namespace rix {
+namespace msg {
+namespace stats {
+
+class CallbackStatistics : public Message {
+  public:
+    uint8_t kind{};
+    std::string name{};
+    uint64_t nominal_period{};
+    uint64_t calls{};
+    uint64_t overruns{};
+    uint64_t execution_mean{};
+    uint64_t execution_p99{};
+    uint64_t execution_max{};
+    uint64_t period_mean{};
+    uint64_t jitter_p99{};
+
+    CallbackStatistics() = default;
+    CallbackStatistics(const CallbackStatistics &other) = default;
+    ~CallbackStatistics() = default;
+
+    static constexpr std::array<uint64_t, 2> HASH = {0xbb5aa350d802ad71ULL, 0x727e4d7566fdef54ULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            KIND = 0,
+            NAME = 1,
+            NOMINAL_PERIOD = 2,
+            CALLS = 3,
+            OVERRUNS = 4,
+            EXECUTION_MEAN = 5,
+            EXECUTION_P99 = 6,
+            EXECUTION_MAX = 7,
+            PERIOD_MEAN = 8,
+            JITTER_P99 = 9,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 10;
+
+    size_t size() const override {
+        return static_size();
+    }
+
+    std::array<uint64_t, 2> hash() const override {
+        return HASH;
+    }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        static_serialize(dst, offset);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
+        using namespace detail;
+        size_t size = 0;
+        size += size_number(kind);
+        size += size_string(name);
+        size += size_number(nominal_period);
+        size += size_number(calls);
+        size += size_number(overruns);
+        size += size_number(execution_mean);
+        size += size_number(execution_p99);
+        size += size_number(execution_max);
+        size += size_number(period_mean);
+        size += size_number(jitter_p99);
+        return size;
+    }
+
+    void static_serialize(uint8_t *dst, size_t &offset) const {
+        using namespace detail;
+        serialize_number(dst, offset, kind);
+        serialize_string(dst, offset, name);
+        serialize_number(dst, offset, nominal_period);
+        serialize_number(dst, offset, calls);
+        serialize_number(dst, offset, overruns);
+        serialize_number(dst, offset, execution_mean);
+        serialize_number(dst, offset, execution_p99);
+        serialize_number(dst, offset, execution_max);
+        serialize_number(dst, offset, period_mean);
+        serialize_number(dst, offset, jitter_p99);
+    }
+
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        uint8_t *run = dst.extend(size_number(kind) + size_string(name) +
+                                  size_number(nominal_period) + size_number(calls) +
+                                  size_number(overruns) + size_number(execution_mean) +
+                                  size_number(execution_p99) + size_number(execution_max) +
+                                  size_number(period_mean) + size_number(jitter_p99));
+        size_t offset = 0;
+        serialize_number(run, offset, kind);
+        serialize_string(run, offset, name);
+        serialize_number(run, offset, nominal_period);
+        serialize_number(run, offset, calls);
+        serialize_number(run, offset, overruns);
+        serialize_number(run, offset, execution_mean);
+        serialize_number(run, offset, execution_p99);
+        serialize_number(run, offset, execution_max);
+        serialize_number(run, offset, period_mean);
+        serialize_number(run, offset, jitter_p99);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!deserialize_number(kind, src, size, offset)) { return false; };
+        if (!deserialize_string(name, src, size, offset)) { return false; };
+        if (!deserialize_number(nominal_period, src, size, offset)) { return false; };
+        if (!deserialize_number(calls, src, size, offset)) { return false; };
+        if (!deserialize_number(overruns, src, size, offset)) { return false; };
+        if (!deserialize_number(execution_mean, src, size, offset)) { return false; };
+        if (!deserialize_number(execution_p99, src, size, offset)) { return false; };
+        if (!deserialize_number(execution_max, src, size, offset)) { return false; };
+        if (!deserialize_number(period_mean, src, size, offset)) { return false; };
+        if (!deserialize_number(jitter_p99, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_number(kind, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_string(name, src, size, offset)) { return false; };
+        if (fields > 2 && !deserialize_number(nominal_period, src, size, offset)) { return false; };
+        if (fields > 3 && !deserialize_number(calls, src, size, offset)) { return false; };
+        if (fields > 4 && !deserialize_number(overruns, src, size, offset)) { return false; };
+        if (fields > 5 && !deserialize_number(execution_mean, src, size, offset)) { return false; };
+        if (fields > 6 && !deserialize_number(execution_p99, src, size, offset)) { return false; };
+        if (fields > 7 && !deserialize_number(execution_max, src, size, offset)) { return false; };
+        if (fields > 8 && !deserialize_number(period_mean, src, size, offset)) { return false; };
+        if (fields > 9 && !deserialize_number(jitter_p99, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` past a serialized CallbackStatistics without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!view_skip(1, size, offset)) { return false; };
+        if (!skip_string(src, size, offset)) { return false; };
+        if (!view_skip(64, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized CallbackStatistics to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field == 0) { return true; };
+        if (!view_skip(1, size, offset)) { return false; };
+        if (field == 1) { return true; };
+        if (!skip_string(src, size, offset)) { return false; };
+        if (field < 10) {
+            static constexpr size_t offsets[] = {0, 8, 16, 24, 32, 40, 48, 56};
+            return view_skip(offsets[field - 2], size, offset);
+        }
+        if (!view_skip(64, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized CallbackStatistics. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_number<uint8_t>(kind_, src, size, offset)) { return false; };
+            if (!view_string(name_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(nominal_period_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(calls_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(overruns_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(execution_mean_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(execution_p99_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(execution_max_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(period_mean_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(jitter_p99_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        uint8_t kind() const { return detail::load_number<uint8_t>(src_, kind_); }
+
+        const std::string_view &name() const { return name_; }
+
+        uint64_t nominal_period() const { return detail::load_number<uint64_t>(src_, nominal_period_); }
+
+        uint64_t calls() const { return detail::load_number<uint64_t>(src_, calls_); }
+
+        uint64_t overruns() const { return detail::load_number<uint64_t>(src_, overruns_); }
+
+        uint64_t execution_mean() const { return detail::load_number<uint64_t>(src_, execution_mean_); }
+
+        uint64_t execution_p99() const { return detail::load_number<uint64_t>(src_, execution_p99_); }
+
+        uint64_t execution_max() const { return detail::load_number<uint64_t>(src_, execution_max_); }
+
+        uint64_t period_mean() const { return detail::load_number<uint64_t>(src_, period_mean_); }
+
+        uint64_t jitter_p99() const { return detail::load_number<uint64_t>(src_, jitter_p99_); }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        size_t kind_ = 0;
+        std::string_view name_{};
+        size_t nominal_period_ = 0;
+        size_t calls_ = 0;
+        size_t overruns_ = 0;
+        size_t execution_mean_ = 0;
+        size_t execution_p99_ = 0;
+        size_t execution_max_ = 0;
+        size_t period_mean_ = 0;
+        size_t jitter_p99_ = 0;
+    };
+};
+
+} // namespace stats
+} // namespace msg
+} // namespace rix
\ No newline at end of file
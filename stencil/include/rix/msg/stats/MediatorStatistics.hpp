@@ -0,0 +1,264 @@
+// Generated by tools/rixmsg.py from msg/stats/MediatorStatistics.msg. Do not edit.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <map>
+#include <string>
+#include <string_view>
+#include <cstring>
+
+#include "rix/msg/serialization.hpp"
+#include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
+#include "rix/msg/standard/Header.hpp"
+
+namespace rix {
+namespace msg {
+namespace stats {
+
+class MediatorStatistics : public Message {
+  public:
+    standard::Header header{};
+    uint32_t nodes{};
+    uint32_t publishers{};
+    uint32_t subscribers{};
+    uint32_t services{};
+    uint32_t topics{};
+    uint64_t registrations{};
+    uint64_t failures{};
+    uint64_t registration_latency_p50{};
+    uint64_t registration_latency_p99{};
+    uint64_t registration_latency_max{};
+
+    MediatorStatistics() = default;
+    MediatorStatistics(const MediatorStatistics &other) = default;
+    ~MediatorStatistics() = default;
+
+    static constexpr std::array<uint64_t, 2> HASH = {0x12b20c126bb8270eULL, 0x284ddbbc0cfe1e72ULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            HEADER = 0,
+            NODES = 1,
+            PUBLISHERS = 2,
+            SUBSCRIBERS = 3,
+            SERVICES = 4,
+            TOPICS = 5,
+            REGISTRATIONS = 6,
+            FAILURES = 7,
+            REGISTRATION_LATENCY_P50 = 8,
+            REGISTRATION_LATENCY_P99 = 9,
+            REGISTRATION_LATENCY_MAX = 10,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 11;
+
+    size_t size() const override {
+        return static_size();
+    }
+
+    std::array<uint64_t, 2> hash() const override {
+        return HASH;
+    }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        static_serialize(dst, offset);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
+        using namespace detail;
+        size_t size = 0;
+        size += size_message(header);
+        size += size_number(nodes);
+        size += size_number(publishers);
+        size += size_number(subscribers);
+        size += size_number(services);
+        size += size_number(topics);
+        size += size_number(registrations);
+        size += size_number(failures);
+        size += size_number(registration_latency_p50);
+        size += size_number(registration_latency_p99);
+        size += size_number(registration_latency_max);
+        return size;
+    }
+
+    void static_serialize(uint8_t *dst, size_t &offset) const {
+        using namespace detail;
+        serialize_message(dst, offset, header);
+        serialize_number(dst, offset, nodes);
+        serialize_number(dst, offset, publishers);
+        serialize_number(dst, offset, subscribers);
+        serialize_number(dst, offset, services);
+        serialize_number(dst, offset, topics);
+        serialize_number(dst, offset, registrations);
+        serialize_number(dst, offset, failures);
+        serialize_number(dst, offset, registration_latency_p50);
+        serialize_number(dst, offset, registration_latency_p99);
+        serialize_number(dst, offset, registration_latency_max);
+    }
+
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        write_message(dst, header);
+        uint8_t *run = dst.extend(size_number(nodes) + size_number(publishers) +
+                                  size_number(subscribers) + size_number(services) +
+                                  size_number(topics) + size_number(registrations) +
+                                  size_number(failures) + size_number(registration_latency_p50) +
+                                  size_number(registration_latency_p99) +
+                                  size_number(registration_latency_max));
+        size_t offset = 0;
+        serialize_number(run, offset, nodes);
+        serialize_number(run, offset, publishers);
+        serialize_number(run, offset, subscribers);
+        serialize_number(run, offset, services);
+        serialize_number(run, offset, topics);
+        serialize_number(run, offset, registrations);
+        serialize_number(run, offset, failures);
+        serialize_number(run, offset, registration_latency_p50);
+        serialize_number(run, offset, registration_latency_p99);
+        serialize_number(run, offset, registration_latency_max);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!deserialize_message(header, src, size, offset)) { return false; };
+        if (!deserialize_number(nodes, src, size, offset)) { return false; };
+        if (!deserialize_number(publishers, src, size, offset)) { return false; };
+        if (!deserialize_number(subscribers, src, size, offset)) { return false; };
+        if (!deserialize_number(services, src, size, offset)) { return false; };
+        if (!deserialize_number(topics, src, size, offset)) { return false; };
+        if (!deserialize_number(registrations, src, size, offset)) { return false; };
+        if (!deserialize_number(failures, src, size, offset)) { return false; };
+        if (!deserialize_number(registration_latency_p50, src, size, offset)) { return false; };
+        if (!deserialize_number(registration_latency_p99, src, size, offset)) { return false; };
+        if (!deserialize_number(registration_latency_max, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_message(header, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_number(nodes, src, size, offset)) { return false; };
+        if (fields > 2 && !deserialize_number(publishers, src, size, offset)) { return false; };
+        if (fields > 3 && !deserialize_number(subscribers, src, size, offset)) { return false; };
+        if (fields > 4 && !deserialize_number(services, src, size, offset)) { return false; };
+        if (fields > 5 && !deserialize_number(topics, src, size, offset)) { return false; };
+        if (fields > 6 && !deserialize_number(registrations, src, size, offset)) { return false; };
+        if (fields > 7 && !deserialize_number(failures, src, size, offset)) { return false; };
+        if (fields > 8 && !deserialize_number(registration_latency_p50, src, size, offset)) { return false; };
+        if (fields > 9 && !deserialize_number(registration_latency_p99, src, size, offset)) { return false; };
+        if (fields > 10 && !deserialize_number(registration_latency_max, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` past a serialized MediatorStatistics without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!skip_message<standard::Header>(src, size, offset)) { return false; };
+        if (!view_skip(60, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized MediatorStatistics to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field == 0) { return true; };
+        if (!skip_message<standard::Header>(src, size, offset)) { return false; };
+        if (field < 11) {
+            static constexpr size_t offsets[] = {0, 4, 8, 12, 16, 20, 28, 36, 44, 52};
+            return view_skip(offsets[field - 1], size, offset);
+        }
+        if (!view_skip(60, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized MediatorStatistics. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_message(header_, src, size, offset)) { return false; };
+            if (!view_number<uint32_t>(nodes_, src, size, offset)) { return false; };
+            if (!view_number<uint32_t>(publishers_, src, size, offset)) { return false; };
+            if (!view_number<uint32_t>(subscribers_, src, size, offset)) { return false; };
+            if (!view_number<uint32_t>(services_, src, size, offset)) { return false; };
+            if (!view_number<uint32_t>(topics_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(registrations_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(failures_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(registration_latency_p50_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(registration_latency_p99_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(registration_latency_max_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        const standard::Header::View &header() const { return header_; }
+
+        uint32_t nodes() const { return detail::load_number<uint32_t>(src_, nodes_); }
+
+        uint32_t publishers() const { return detail::load_number<uint32_t>(src_, publishers_); }
+
+        uint32_t subscribers() const { return detail::load_number<uint32_t>(src_, subscribers_); }
+
+        uint32_t services() const { return detail::load_number<uint32_t>(src_, services_); }
+
+        uint32_t topics() const { return detail::load_number<uint32_t>(src_, topics_); }
+
+        uint64_t registrations() const { return detail::load_number<uint64_t>(src_, registrations_); }
+
+        uint64_t failures() const { return detail::load_number<uint64_t>(src_, failures_); }
+
+        uint64_t registration_latency_p50() const { return detail::load_number<uint64_t>(src_, registration_latency_p50_); }
+
+        uint64_t registration_latency_p99() const { return detail::load_number<uint64_t>(src_, registration_latency_p99_); }
+
+        uint64_t registration_latency_max() const { return detail::load_number<uint64_t>(src_, registration_latency_max_); }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        standard::Header::View header_{};
+        size_t nodes_ = 0;
+        size_t publishers_ = 0;
+        size_t subscribers_ = 0;
+        size_t services_ = 0;
+        size_t topics_ = 0;
+        size_t registrations_ = 0;
+        size_t failures_ = 0;
+        size_t registration_latency_p50_ = 0;
+        size_t registration_latency_p99_ = 0;
+        size_t registration_latency_max_ = 0;
+    };
+};
+
+} // namespace stats
+} // namespace msg
+} // namespace rix
\ No newline at end of file
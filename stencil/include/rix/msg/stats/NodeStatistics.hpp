@@ -0,0 +1,187 @@
+// Generated by tools/rixmsg.py from msg/stats/NodeStatistics.msg. Do not edit.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <map>
+#include <string>
+#include <string_view>
+#include <cstring>
+
+#include "rix/msg/serialization.hpp"
+#include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
+#include "rix/msg/standard/Header.hpp"
+#include "rix/msg/stats/TopicStatistics.hpp"
+#include "rix/msg/stats/CallbackStatistics.hpp"
+
+namespace rix {
+namespace msg {
+namespace stats {
+
+class NodeStatistics : public Message {
+  public:
+    standard::Header header{};
+    std::string node{};
+    std::vector<stats::TopicStatistics> topics{};
+    std::vector<stats::CallbackStatistics> callbacks{};
+
+    NodeStatistics() = default;
+    NodeStatistics(const NodeStatistics &other) = default;
+    ~NodeStatistics() = default;
+
+    static constexpr std::array<uint64_t, 2> HASH = {0xf933080d8adf6359ULL, 0x6cedcc88b5622964ULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            HEADER = 0,
+            NODE = 1,
+            TOPICS = 2,
+            CALLBACKS = 3,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 4;
+
+    size_t size() const override {
+        return static_size();
+    }
+
+    std::array<uint64_t, 2> hash() const override {
+        return HASH;
+    }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        static_serialize(dst, offset);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
+        using namespace detail;
+        size_t size = 0;
+        size += size_message(header);
+        size += size_string(node);
+        size += size_message_vector(topics);
+        size += size_message_vector(callbacks);
+        return size;
+    }
+
+    void static_serialize(uint8_t *dst, size_t &offset) const {
+        using namespace detail;
+        serialize_message(dst, offset, header);
+        serialize_string(dst, offset, node);
+        serialize_message_vector(dst, offset, topics);
+        serialize_message_vector(dst, offset, callbacks);
+    }
+
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        write_message(dst, header);
+        uint8_t *run = dst.extend(size_string(node));
+        size_t offset = 0;
+        serialize_string(run, offset, node);
+        write_message_vector(dst, topics);
+        write_message_vector(dst, callbacks);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!deserialize_message(header, src, size, offset)) { return false; };
+        if (!deserialize_string(node, src, size, offset)) { return false; };
+        if (!deserialize_message_vector(topics, src, size, offset)) { return false; };
+        if (!deserialize_message_vector(callbacks, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_message(header, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_string(node, src, size, offset)) { return false; };
+        if (fields > 2 && !deserialize_message_vector(topics, src, size, offset)) { return false; };
+        if (fields > 3 && !deserialize_message_vector(callbacks, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` past a serialized NodeStatistics without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!skip_message<standard::Header>(src, size, offset)) { return false; };
+        if (!skip_string(src, size, offset)) { return false; };
+        if (!skip_message_vector<stats::TopicStatistics>(src, size, offset)) { return false; };
+        if (!skip_message_vector<stats::CallbackStatistics>(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized NodeStatistics to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field == 0) { return true; };
+        if (!skip_message<standard::Header>(src, size, offset)) { return false; };
+        if (field == 1) { return true; };
+        if (!skip_string(src, size, offset)) { return false; };
+        if (field == 2) { return true; };
+        if (!skip_message_vector<stats::TopicStatistics>(src, size, offset)) { return false; };
+        if (field == 3) { return true; };
+        if (!skip_message_vector<stats::CallbackStatistics>(src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized NodeStatistics. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_message(header_, src, size, offset)) { return false; };
+            if (!view_string(node_, src, size, offset)) { return false; };
+            if (!view_message_vector<stats::TopicStatistics::View>(topics_, src, size, offset)) { return false; };
+            if (!view_message_vector<stats::CallbackStatistics::View>(callbacks_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        const standard::Header::View &header() const { return header_; }
+
+        const std::string_view &node() const { return node_; }
+
+        const SequenceView<stats::TopicStatistics::View> &topics() const { return topics_; }
+
+        const SequenceView<stats::CallbackStatistics::View> &callbacks() const { return callbacks_; }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        standard::Header::View header_{};
+        std::string_view node_{};
+        SequenceView<stats::TopicStatistics::View> topics_{};
+        SequenceView<stats::CallbackStatistics::View> callbacks_{};
+    };
+};
+
+} // namespace stats
+} // namespace msg
+} // namespace rix
\ No newline at end of file
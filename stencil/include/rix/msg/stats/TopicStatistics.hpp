@@ -0,0 +1,366 @@
+// Generated by tools/rixmsg.py from msg/stats/TopicStatistics.msg. Do not edit.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <map>
+#include <string>
+#include <string_view>
+#include <cstring>
+
+#include "rix/msg/serialization.hpp"
+#include "rix/msg/message.hpp"
+#include "rix/msg/view.hpp"
+
+namespace rix {
+namespace msg {
+namespace stats {
+
+class TopicStatistics : public Message {
+  public:
+    std::string topic{};
+    bool publisher{};
+    uint32_t connections{};
+    uint64_t messages{};
+    uint64_t bytes{};
+    uint64_t drops{};
+    uint64_t write_failures{};
+    uint64_t lost{};
+    uint64_t duplicates{};
+    uint64_t reordered{};
+    uint64_t queued_bytes{};
+    float message_rate{};
+    float byte_rate{};
+    uint64_t latency_p50{};
+    uint64_t latency_p99{};
+    uint64_t latency_max{};
+    uint64_t delivery_p50{};
+    uint64_t delivery_p99{};
+    uint64_t queueing_p50{};
+    uint64_t queueing_p99{};
+
+    TopicStatistics() = default;
+    TopicStatistics(const TopicStatistics &other) = default;
+    ~TopicStatistics() = default;
+
+    static constexpr std::array<uint64_t, 2> HASH = {0xbed3b3df67a85fcaULL, 0xd1197baa4445eb0bULL};
+
+    /**
+     * @brief Indices of the fields in serialization order, for
+     * deserialize_prefix() and seek().
+     */
+    struct FIELD {
+        enum INDEX : size_t {
+            TOPIC = 0,
+            PUBLISHER = 1,
+            CONNECTIONS = 2,
+            MESSAGES = 3,
+            BYTES = 4,
+            DROPS = 5,
+            WRITE_FAILURES = 6,
+            LOST = 7,
+            DUPLICATES = 8,
+            REORDERED = 9,
+            QUEUED_BYTES = 10,
+            MESSAGE_RATE = 11,
+            BYTE_RATE = 12,
+            LATENCY_P50 = 13,
+            LATENCY_P99 = 14,
+            LATENCY_MAX = 15,
+            DELIVERY_P50 = 16,
+            DELIVERY_P99 = 17,
+            QUEUEING_P50 = 18,
+            QUEUEING_P99 = 19,
+        };
+    };
+    static constexpr size_t FIELD_COUNT = 20;
+
+    size_t size() const override {
+        return static_size();
+    }
+
+    std::array<uint64_t, 2> hash() const override {
+        return HASH;
+    }
+
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        static_serialize(dst, offset);
+    }
+
+    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {
+        return static_deserialize(src, size, offset);
+    }
+
+    void serialize(Writer &dst) const override {
+        static_serialize(dst);
+    }
+
+    size_t static_size() const {
+        using namespace detail;
+        size_t size = 0;
+        size += size_string(topic);
+        size += size_number(publisher);
+        size += size_number(connections);
+        size += size_number(messages);
+        size += size_number(bytes);
+        size += size_number(drops);
+        size += size_number(write_failures);
+        size += size_number(lost);
+        size += size_number(duplicates);
+        size += size_number(reordered);
+        size += size_number(queued_bytes);
+        size += size_number(message_rate);
+        size += size_number(byte_rate);
+        size += size_number(latency_p50);
+        size += size_number(latency_p99);
+        size += size_number(latency_max);
+        size += size_number(delivery_p50);
+        size += size_number(delivery_p99);
+        size += size_number(queueing_p50);
+        size += size_number(queueing_p99);
+        return size;
+    }
+
+    void static_serialize(uint8_t *dst, size_t &offset) const {
+        using namespace detail;
+        serialize_string(dst, offset, topic);
+        serialize_number(dst, offset, publisher);
+        serialize_number(dst, offset, connections);
+        serialize_number(dst, offset, messages);
+        serialize_number(dst, offset, bytes);
+        serialize_number(dst, offset, drops);
+        serialize_number(dst, offset, write_failures);
+        serialize_number(dst, offset, lost);
+        serialize_number(dst, offset, duplicates);
+        serialize_number(dst, offset, reordered);
+        serialize_number(dst, offset, queued_bytes);
+        serialize_number(dst, offset, message_rate);
+        serialize_number(dst, offset, byte_rate);
+        serialize_number(dst, offset, latency_p50);
+        serialize_number(dst, offset, latency_p99);
+        serialize_number(dst, offset, latency_max);
+        serialize_number(dst, offset, delivery_p50);
+        serialize_number(dst, offset, delivery_p99);
+        serialize_number(dst, offset, queueing_p50);
+        serialize_number(dst, offset, queueing_p99);
+    }
+
+    void static_serialize(Writer &dst) const {
+        using namespace detail;
+        uint8_t *run = dst.extend(size_string(topic) + size_number(publisher) +
+                                  size_number(connections) + size_number(messages) +
+                                  size_number(bytes) + size_number(drops) +
+                                  size_number(write_failures) + size_number(lost) +
+                                  size_number(duplicates) + size_number(reordered) +
+                                  size_number(queued_bytes) + size_number(message_rate) +
+                                  size_number(byte_rate) + size_number(latency_p50) +
+                                  size_number(latency_p99) + size_number(latency_max) +
+                                  size_number(delivery_p50) + size_number(delivery_p99) +
+                                  size_number(queueing_p50) + size_number(queueing_p99));
+        size_t offset = 0;
+        serialize_string(run, offset, topic);
+        serialize_number(run, offset, publisher);
+        serialize_number(run, offset, connections);
+        serialize_number(run, offset, messages);
+        serialize_number(run, offset, bytes);
+        serialize_number(run, offset, drops);
+        serialize_number(run, offset, write_failures);
+        serialize_number(run, offset, lost);
+        serialize_number(run, offset, duplicates);
+        serialize_number(run, offset, reordered);
+        serialize_number(run, offset, queued_bytes);
+        serialize_number(run, offset, message_rate);
+        serialize_number(run, offset, byte_rate);
+        serialize_number(run, offset, latency_p50);
+        serialize_number(run, offset, latency_p99);
+        serialize_number(run, offset, latency_max);
+        serialize_number(run, offset, delivery_p50);
+        serialize_number(run, offset, delivery_p99);
+        serialize_number(run, offset, queueing_p50);
+        serialize_number(run, offset, queueing_p99);
+    }
+
+    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!deserialize_string(topic, src, size, offset)) { return false; };
+        if (!deserialize_number(publisher, src, size, offset)) { return false; };
+        if (!deserialize_number(connections, src, size, offset)) { return false; };
+        if (!deserialize_number(messages, src, size, offset)) { return false; };
+        if (!deserialize_number(bytes, src, size, offset)) { return false; };
+        if (!deserialize_number(drops, src, size, offset)) { return false; };
+        if (!deserialize_number(write_failures, src, size, offset)) { return false; };
+        if (!deserialize_number(lost, src, size, offset)) { return false; };
+        if (!deserialize_number(duplicates, src, size, offset)) { return false; };
+        if (!deserialize_number(reordered, src, size, offset)) { return false; };
+        if (!deserialize_number(queued_bytes, src, size, offset)) { return false; };
+        if (!deserialize_number(message_rate, src, size, offset)) { return false; };
+        if (!deserialize_number(byte_rate, src, size, offset)) { return false; };
+        if (!deserialize_number(latency_p50, src, size, offset)) { return false; };
+        if (!deserialize_number(latency_p99, src, size, offset)) { return false; };
+        if (!deserialize_number(latency_max, src, size, offset)) { return false; };
+        if (!deserialize_number(delivery_p50, src, size, offset)) { return false; };
+        if (!deserialize_number(delivery_p99, src, size, offset)) { return false; };
+        if (!deserialize_number(queueing_p50, src, size, offset)) { return false; };
+        if (!deserialize_number(queueing_p99, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Deserializes only the first `fields` fields and leaves `offset` at
+     * the start of the next one. The remaining fields are not read.
+     */
+    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {
+        using namespace detail;
+        if (fields > 0 && !deserialize_string(topic, src, size, offset)) { return false; };
+        if (fields > 1 && !deserialize_number(publisher, src, size, offset)) { return false; };
+        if (fields > 2 && !deserialize_number(connections, src, size, offset)) { return false; };
+        if (fields > 3 && !deserialize_number(messages, src, size, offset)) { return false; };
+        if (fields > 4 && !deserialize_number(bytes, src, size, offset)) { return false; };
+        if (fields > 5 && !deserialize_number(drops, src, size, offset)) { return false; };
+        if (fields > 6 && !deserialize_number(write_failures, src, size, offset)) { return false; };
+        if (fields > 7 && !deserialize_number(lost, src, size, offset)) { return false; };
+        if (fields > 8 && !deserialize_number(duplicates, src, size, offset)) { return false; };
+        if (fields > 9 && !deserialize_number(reordered, src, size, offset)) { return false; };
+        if (fields > 10 && !deserialize_number(queued_bytes, src, size, offset)) { return false; };
+        if (fields > 11 && !deserialize_number(message_rate, src, size, offset)) { return false; };
+        if (fields > 12 && !deserialize_number(byte_rate, src, size, offset)) { return false; };
+        if (fields > 13 && !deserialize_number(latency_p50, src, size, offset)) { return false; };
+        if (fields > 14 && !deserialize_number(latency_p99, src, size, offset)) { return false; };
+        if (fields > 15 && !deserialize_number(latency_max, src, size, offset)) { return false; };
+        if (fields > 16 && !deserialize_number(delivery_p50, src, size, offset)) { return false; };
+        if (fields > 17 && !deserialize_number(delivery_p99, src, size, offset)) { return false; };
+        if (fields > 18 && !deserialize_number(queueing_p50, src, size, offset)) { return false; };
+        if (fields > 19 && !deserialize_number(queueing_p99, src, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` past a serialized TopicStatistics without decoding it.
+     */
+    static bool skip(const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (!skip_string(src, size, offset)) { return false; };
+        if (!view_skip(133, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Increments `offset` from the start of a serialized TopicStatistics to the
+     * start of `field` (or to its end for FIELD_COUNT) without decoding the
+     * fields before it. Offsets within runs of fixed-size fields are constant.
+     */
+    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {
+        using namespace detail;
+        if (field > FIELD_COUNT) { return false; };
+        if (field == 0) { return true; };
+        if (!skip_string(src, size, offset)) { return false; };
+        if (field < 20) {
+            static constexpr size_t offsets[] = {0, 1, 5, 13, 21, 29, 37, 45, 53, 61, 69, 73, 77, 85, 93, 101, 109, 117, 125};
+            return view_skip(offsets[field - 1], size, offset);
+        }
+        if (!view_skip(133, size, offset)) { return false; };
+        return true;
+    }
+
+    /**
+     * @brief Read-only view of a serialized TopicStatistics. parse() checks the bytes
+     * once, after which the accessors read fields in place without copying.
+     * The viewed bytes must outlive the View.
+     */
+    class View {
+      public:
+        bool parse(const uint8_t *src, size_t size, size_t &offset) {
+            using namespace detail;
+            src_ = src;
+            if (!view_string(topic_, src, size, offset)) { return false; };
+            if (!view_number<bool>(publisher_, src, size, offset)) { return false; };
+            if (!view_number<uint32_t>(connections_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(messages_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(bytes_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(drops_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(write_failures_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(lost_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(duplicates_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(reordered_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(queued_bytes_, src, size, offset)) { return false; };
+            if (!view_number<float>(message_rate_, src, size, offset)) { return false; };
+            if (!view_number<float>(byte_rate_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(latency_p50_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(latency_p99_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(latency_max_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(delivery_p50_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(delivery_p99_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(queueing_p50_, src, size, offset)) { return false; };
+            if (!view_number<uint64_t>(queueing_p99_, src, size, offset)) { return false; };
+            return true;
+        }
+
+        const std::string_view &topic() const { return topic_; }
+
+        bool publisher() const { return detail::load_number<bool>(src_, publisher_); }
+
+        uint32_t connections() const { return detail::load_number<uint32_t>(src_, connections_); }
+
+        uint64_t messages() const { return detail::load_number<uint64_t>(src_, messages_); }
+
+        uint64_t bytes() const { return detail::load_number<uint64_t>(src_, bytes_); }
+
+        uint64_t drops() const { return detail::load_number<uint64_t>(src_, drops_); }
+
+        uint64_t write_failures() const { return detail::load_number<uint64_t>(src_, write_failures_); }
+
+        uint64_t lost() const { return detail::load_number<uint64_t>(src_, lost_); }
+
+        uint64_t duplicates() const { return detail::load_number<uint64_t>(src_, duplicates_); }
+
+        uint64_t reordered() const { return detail::load_number<uint64_t>(src_, reordered_); }
+
+        uint64_t queued_bytes() const { return detail::load_number<uint64_t>(src_, queued_bytes_); }
+
+        float message_rate() const { return detail::load_number<float>(src_, message_rate_); }
+
+        float byte_rate() const { return detail::load_number<float>(src_, byte_rate_); }
+
+        uint64_t latency_p50() const { return detail::load_number<uint64_t>(src_, latency_p50_); }
+
+        uint64_t latency_p99() const { return detail::load_number<uint64_t>(src_, latency_p99_); }
+
+        uint64_t latency_max() const { return detail::load_number<uint64_t>(src_, latency_max_); }
+
+        uint64_t delivery_p50() const { return detail::load_number<uint64_t>(src_, delivery_p50_); }
+
+        uint64_t delivery_p99() const { return detail::load_number<uint64_t>(src_, delivery_p99_); }
+
+        uint64_t queueing_p50() const { return detail::load_number<uint64_t>(src_, queueing_p50_); }
+
+        uint64_t queueing_p99() const { return detail::load_number<uint64_t>(src_, queueing_p99_); }
+
+      private:
+        const uint8_t *src_ = nullptr;
+        std::string_view topic_{};
+        size_t publisher_ = 0;
+        size_t connections_ = 0;
+        size_t messages_ = 0;
+        size_t bytes_ = 0;
+        size_t drops_ = 0;
+        size_t write_failures_ = 0;
+        size_t lost_ = 0;
+        size_t duplicates_ = 0;
+        size_t reordered_ = 0;
+        size_t queued_bytes_ = 0;
+        size_t message_rate_ = 0;
+        size_t byte_rate_ = 0;
+        size_t latency_p50_ = 0;
+        size_t latency_p99_ = 0;
+        size_t latency_max_ = 0;
+        size_t delivery_p50_ = 0;
+        size_t delivery_p99_ = 0;
+        size_t queueing_p50_ = 0;
+        size_t queueing_p99_ = 0;
+    };
+};
+
+} // namespace stats
+} // namespace msg
+} // namespace rix
\ No newline at end of file
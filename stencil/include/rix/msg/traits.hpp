@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+#include "rix/msg/message.hpp"
+
+namespace rix {
+namespace msg {
+
+/**
+ * @brief Compile-time traits of message fields.
+ *
+ * @details A type is fixed-size if its serialized form always has the same
+ * number of bytes. Numbers are fixed-size, a message is fixed-size if it
+ * declares a `static constexpr size_t FIXED_SIZE`, and a std::array is
+ * fixed-size if its elements are. Messages made only of fixed-size fields
+ * declare FIXED_SIZE as the sum of the sizes of their fields, so nested
+ * fixed-size messages are folded into a single constant:
+ *
+ *     static constexpr size_t FIXED_SIZE = detail::fixed_size_of<float, float, float>();
+ */
+template <typename T, typename = void>
+struct is_fixed_size : std::is_arithmetic<T> {};
+
+template <typename T>
+struct is_fixed_size<T, std::void_t<decltype(T::FIXED_SIZE)>> : std::true_type {};
+
+template <typename T, size_t N>
+struct is_fixed_size<std::array<T, N>, void> : is_fixed_size<T> {};
+
+template <typename T>
+inline constexpr bool is_fixed_size_v = is_fixed_size<T>::value;
+
+/**
+ * @brief Generated messages implement the Message interface with non-virtual
+ * static_size, static_serialize and static_deserialize functions and a
+ * constexpr HASH. Serialization helpers call these directly when the type of a
+ * field is known, so nested messages are inlined instead of going through
+ * virtual calls.
+ */
+template <typename T>
+concept StaticMessage = std::is_base_of_v<Message, T> &&
+                        requires(const T &msg, T &dst, uint8_t *out, Writer &writer, const uint8_t *in, size_t size,
+                                 size_t &offset) {
+                            { T::HASH } -> std::convertible_to<std::array<uint64_t, 2>>;
+                            { msg.static_size() } -> std::convertible_to<size_t>;
+                            msg.static_serialize(out, offset);
+                            msg.static_serialize(writer);
+                            { dst.static_deserialize(in, size, offset) } -> std::same_as<bool>;
+                        };
+
+namespace detail {
+
+template <typename T>
+struct is_std_array : std::false_type {};
+
+template <typename T, size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {};
+
+}  // namespace detail
+
+/**
+ * @brief Returns the number of bytes of a serialized fixed-size type.
+ *
+ * @tparam T A fixed-size type
+ */
+template <typename T>
+constexpr size_t fixed_size() {
+    static_assert(is_fixed_size_v<T>, "T must be a fixed-size type");
+    if constexpr (std::is_arithmetic_v<T>) {
+        return sizeof(T);
+    } else if constexpr (detail::is_std_array<T>::value) {
+        return std::tuple_size_v<T> * fixed_size<typename T::value_type>();
+    } else {
+        return T::FIXED_SIZE;
+    }
+}
+
+template <typename T>
+inline constexpr size_t fixed_size_v = fixed_size<T>();
+
+namespace detail {
+
+/**
+ * @brief Returns the sum of the serialized sizes of the fixed-size types `Ts`.
+ *
+ */
+template <typename... Ts>
+constexpr size_t fixed_size_of() {
+    return (fixed_size<Ts>() + ... + 0);
+}
+
+}  // namespace detail
+
+}  // namespace msg
+}  // namespace rix
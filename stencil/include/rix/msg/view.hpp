@@ -0,0 +1,324 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "rix/msg/endian.hpp"
+
+namespace rix {
+namespace msg {
+
+/**
+ * @brief Read-only view of a serialized number array or vector. Elements are
+ * loaded with memcpy and converted from wire byte order, so the bytes do not
+ * need to be aligned.
+ *
+ * @tparam T The element type (must be an arithmetic type)
+ */
+template <typename T>
+class NumberSpan {
+    static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
+
+   public:
+    NumberSpan() = default;
+    NumberSpan(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief Returns the serialized bytes of the elements.
+     *
+     */
+    const uint8_t *data() const { return data_; }
+
+    T operator[](size_t i) const {
+        T value;
+        std::memcpy(&value, data_ + i * sizeof(T), sizeof(T));
+        return detail::from_wire(value);
+    }
+
+    /**
+     * @brief Copies the elements into `dst`, which must hold size() elements.
+     *
+     */
+    void copy_to(T *dst) const {
+        if (size_ == 0) return;
+        std::memcpy(dst, data_, size_ * sizeof(T));
+        detail::convert_wire_array<T>(reinterpret_cast<uint8_t *>(dst), size_);
+    }
+
+    std::vector<T> to_vector() const {
+        std::vector<T> result(size_);
+        copy_to(result.data());
+        return result;
+    }
+
+   private:
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+namespace detail {
+
+inline bool view_element(std::string_view &dst, const uint8_t *src, size_t size, size_t &offset);
+
+template <typename V>
+inline bool view_element(V &dst, const uint8_t *src, size_t size, size_t &offset) {
+    return dst.parse(src, size, offset);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Read-only view of a serialized array or vector of strings or
+ * messages. The elements have variable sizes, so they are parsed one after
+ * another while iterating.
+ *
+ * @tparam V The element view (std::string_view or the View of a message)
+ */
+template <typename V>
+class SequenceView {
+   public:
+    class iterator {
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = V;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const V *;
+        using reference = const V &;
+
+        iterator() = default;
+        iterator(const uint8_t *src, size_t size, size_t offset, size_t remaining)
+            : src_(src), size_(size), offset_(offset), remaining_(remaining) {
+            load();
+        }
+
+        reference operator*() const { return value_; }
+        pointer operator->() const { return &value_; }
+
+        iterator &operator++() {
+            offset_ = next_;
+            remaining_--;
+            load();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator it = *this;
+            ++*this;
+            return it;
+        }
+
+        bool operator==(const iterator &other) const { return remaining_ == other.remaining_; }
+        bool operator!=(const iterator &other) const { return remaining_ != other.remaining_; }
+
+       private:
+        void load() {
+            if (remaining_ == 0) return;
+            next_ = offset_;
+            detail::view_element(value_, src_, size_, next_);
+        }
+
+        const uint8_t *src_ = nullptr;
+        size_t size_ = 0;
+        size_t offset_ = 0;
+        size_t next_ = 0;
+        size_t remaining_ = 0;
+        V value_{};
+    };
+
+    SequenceView() = default;
+    SequenceView(const uint8_t *src, size_t size, size_t offset, size_t count)
+        : src_(src), size_(size), offset_(offset), count_(count) {}
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    iterator begin() const { return iterator(src_, size_, offset_, count_); }
+    iterator end() const { return iterator(); }
+
+   private:
+    const uint8_t *src_ = nullptr;
+    size_t size_ = 0;
+    size_t offset_ = 0;
+    size_t count_ = 0;
+};
+
+namespace detail {
+
+/**
+ * @brief The functions below are used by the View classes of generated
+ * messages. Each one checks that a field fits in the byte array `src` of
+ * length `size` at `offset`, records where it is and increments `offset` past
+ * it. They return `false` if the field does not fit, so that a View that
+ * parsed successfully can read its fields without further checks.
+ */
+inline bool view_skip(size_t bytes, size_t size, size_t &offset) {
+    if (size < offset || size - offset < bytes) return false;
+    offset += bytes;
+    return true;
+}
+
+inline bool view_count(uint32_t &count, const uint8_t *src, size_t size, size_t &offset) {
+    if (size < offset || size - offset < sizeof(count)) return false;
+    std::memcpy(&count, src + offset, sizeof(count));
+    count = from_wire(count);
+    offset += sizeof(count);
+    return true;
+}
+
+template <typename T>
+inline T load_number(const uint8_t *src, size_t pos) {
+    T value;
+    std::memcpy(&value, src + pos, sizeof(T));
+    return from_wire(value);
+}
+
+template <typename T>
+inline bool view_number(size_t &pos, const uint8_t *src, size_t size, size_t &offset) {
+    pos = offset;
+    return view_skip(sizeof(T), size, offset);
+}
+
+inline bool view_string(std::string_view &dst, const uint8_t *src, size_t size, size_t &offset) {
+    uint32_t len;
+    if (!view_count(len, src, size, offset)) return false;
+    const size_t pos = offset;
+    if (!view_skip(len, size, offset)) return false;
+    dst = std::string_view(reinterpret_cast<const char *>(src + pos), len);
+    return true;
+}
+
+template <typename V>
+inline bool view_message(V &dst, const uint8_t *src, size_t size, size_t &offset) {
+    return dst.parse(src, size, offset);
+}
+
+template <typename T, size_t N>
+inline bool view_number_array(NumberSpan<T> &dst, const uint8_t *src, size_t size, size_t &offset) {
+    const size_t pos = offset;
+    if (!view_skip(N * sizeof(T), size, offset)) return false;
+    dst = NumberSpan<T>(src + pos, N);
+    return true;
+}
+
+template <typename T>
+inline bool view_number_vector(NumberSpan<T> &dst, const uint8_t *src, size_t size, size_t &offset) {
+    uint32_t count;
+    if (!view_count(count, src, size, offset)) return false;
+    const size_t pos = offset;
+    if ((size - offset) / sizeof(T) < count) return false;
+    offset += count * sizeof(T);
+    dst = NumberSpan<T>(src + pos, count);
+    return true;
+}
+
+template <typename V>
+inline bool view_sequence(SequenceView<V> &dst, size_t count, const uint8_t *src, size_t size, size_t &offset) {
+    const size_t pos = offset;
+    V element{};
+    for (size_t i = 0; i < count; i++) {
+        if (!view_element(element, src, size, offset)) return false;
+    }
+    dst = SequenceView<V>(src, size, pos, count);
+    return true;
+}
+
+template <size_t N>
+inline bool view_string_array(SequenceView<std::string_view> &dst, const uint8_t *src, size_t size, size_t &offset) {
+    return view_sequence(dst, N, src, size, offset);
+}
+
+inline bool view_string_vector(SequenceView<std::string_view> &dst, const uint8_t *src, size_t size,
+                               size_t &offset) {
+    uint32_t count;
+    if (!view_count(count, src, size, offset)) return false;
+    return view_sequence(dst, count, src, size, offset);
+}
+
+template <typename V, size_t N>
+inline bool view_message_array(SequenceView<V> &dst, const uint8_t *src, size_t size, size_t &offset) {
+    return view_sequence(dst, N, src, size, offset);
+}
+
+template <typename V>
+inline bool view_message_vector(SequenceView<V> &dst, const uint8_t *src, size_t size, size_t &offset) {
+    uint32_t count;
+    if (!view_count(count, src, size, offset)) return false;
+    return view_sequence(dst, count, src, size, offset);
+}
+
+inline bool view_element(std::string_view &dst, const uint8_t *src, size_t size, size_t &offset) {
+    return view_string(dst, src, size, offset);
+}
+
+/**
+ * @brief The skip functions below are used by the skip() and seek() functions
+ * of generated messages. Each one checks that a field fits in the byte array
+ * `src` of length `size` at `offset` and increments `offset` past it, without
+ * decoding it. Numbers and number arrays have a fixed size, so generated code
+ * skips runs of them with a single call to view_skip.
+ */
+inline bool skip_string(const uint8_t *src, size_t size, size_t &offset) {
+    uint32_t len;
+    return view_count(len, src, size, offset) && view_skip(len, size, offset);
+}
+
+template <typename M>
+inline bool skip_message(const uint8_t *src, size_t size, size_t &offset) {
+    return M::skip(src, size, offset);
+}
+
+template <typename T>
+inline bool skip_number_vector(const uint8_t *src, size_t size, size_t &offset) {
+    uint32_t count;
+    if (!view_count(count, src, size, offset)) return false;
+    if ((size - offset) / sizeof(T) < count) return false;
+    offset += count * sizeof(T);
+    return true;
+}
+
+template <size_t N>
+inline bool skip_string_array(const uint8_t *src, size_t size, size_t &offset) {
+    for (size_t i = 0; i < N; i++) {
+        if (!skip_string(src, size, offset)) return false;
+    }
+    return true;
+}
+
+inline bool skip_string_vector(const uint8_t *src, size_t size, size_t &offset) {
+    uint32_t count;
+    if (!view_count(count, src, size, offset)) return false;
+    for (size_t i = 0; i < count; i++) {
+        if (!skip_string(src, size, offset)) return false;
+    }
+    return true;
+}
+
+template <typename M, size_t N>
+inline bool skip_message_array(const uint8_t *src, size_t size, size_t &offset) {
+    for (size_t i = 0; i < N; i++) {
+        if (!M::skip(src, size, offset)) return false;
+    }
+    return true;
+}
+
+template <typename M>
+inline bool skip_message_vector(const uint8_t *src, size_t size, size_t &offset) {
+    uint32_t count;
+    if (!view_count(count, src, size, offset)) return false;
+    for (size_t i = 0; i < count; i++) {
+        if (!M::skip(src, size, offset)) return false;
+    }
+    return true;
+}
+
+}  // namespace detail
+
+}  // namespace msg
+}  // namespace rix
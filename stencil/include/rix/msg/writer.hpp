@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "rix/msg/endian.hpp"
+
+namespace rix {
+namespace msg {
+
+/**
+ * @brief A growable byte buffer that messages are serialized into in a single
+ * pass.
+ *
+ * @details Serializing into a plain byte array needs its size up front, so
+ * each message is walked twice: once by size() and once by serialize(). A
+ * Writer grows as it is written instead. It is meant to be reused. clear()
+ * and consume() keep the allocation, so once the buffer has grown to the
+ * largest message it is not reallocated. A length prefix that is only known
+ * after the payload has been written is reserved with skip() and filled in
+ * with patch().
+ */
+class Writer {
+   public:
+    Writer() = default;
+    explicit Writer(size_t capacity) : buffer_(capacity) {}
+
+    uint8_t *data() { return buffer_.data(); }
+    const uint8_t *data() const { return buffer_.data(); }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return buffer_.size(); }
+
+    /**
+     * @brief Discards the contents and keeps the allocation.
+     *
+     */
+    void clear() { size_ = 0; }
+
+    /**
+     * @brief Sets the size of the contents. New bytes are not initialized.
+     *
+     */
+    void resize(size_t size) {
+        if (size > buffer_.size()) grow(size);
+        size_ = size;
+    }
+
+    /**
+     * @brief Appends `n` bytes and returns a pointer to them. The pointer is
+     * valid until the next call that appends.
+     *
+     */
+    uint8_t *extend(size_t n) {
+        if (n > buffer_.size() - size_) grow(size_ + n);
+        uint8_t *dst = buffer_.data() + size_;
+        size_ += n;
+        return dst;
+    }
+
+    /**
+     * @brief Appends `n` bytes from `src`.
+     *
+     */
+    void append(const uint8_t *src, size_t n) {
+        if (n > 0) std::memcpy(extend(n), src, n);
+    }
+
+    /**
+     * @brief Removes the first `n` bytes, e.g. after they have been written to
+     * a connection.
+     *
+     */
+    void consume(size_t n) {
+        n = std::min(n, size_);
+        std::memmove(buffer_.data(), buffer_.data() + n, size_ - n);
+        size_ -= n;
+    }
+
+    /**
+     * @brief Reserves room for a number of type T that is written later with
+     * patch().
+     *
+     * @return size_t The position of the number
+     */
+    template <typename T>
+    size_t skip() {
+        size_t pos = size_;
+        extend(sizeof(T));
+        return pos;
+    }
+
+    /**
+     * @brief Writes a number at a position returned by skip().
+     *
+     */
+    template <typename T>
+    void patch(size_t pos, T value) {
+        value = detail::to_wire(value);
+        std::memcpy(buffer_.data() + pos, &value, sizeof(T));
+    }
+
+   private:
+    void grow(size_t size) { buffer_.resize(std::max({size, 2 * buffer_.size(), size_t(64)})); }
+
+    std::vector<uint8_t> buffer_;
+    size_t size_ = 0;
+};
+
+}  // namespace msg
+}  // namespace rix
@@ -0,0 +1,487 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "rix/msg/endian.hpp"
+#include "rix/util/log.hpp"
+
+namespace rix {
+namespace util {
+
+/**
+ * @brief The file format of binary logs.
+ *
+ * @details A binary log starts with HEADER_SIZE bytes holding MAGIC and the
+ * NUL-padded name of the process, followed by records. Every record starts
+ * with a RECORD_HEADER_SIZE header and its size is a multiple of 8:
+ *
+ *     [uint32 size][uint16 format][uint16 0][int64 time (ns since the epoch)]
+ *
+ * A record with format FORMAT_RECORD defines a format:
+ *
+ *     [uint16 id][uint8 level][uint8 count][count TYPE codes][text]
+ *
+ * Any other record is an event of that format, followed by its arguments:
+ * bool as 1 byte, integers as 8 bytes, floating point numbers as a float64,
+ * and strings as [uint16 length][bytes]. All numbers are little-endian. A
+ * record with size 0 marks the end of the log.
+ */
+namespace binary_log {
+inline constexpr char MAGIC[8] = {'R', 'I', 'X', 'B', 'L', 'O', 'G', '1'};
+inline constexpr size_t HEADER_SIZE = 64;
+inline constexpr size_t RECORD_HEADER_SIZE = 16;
+inline constexpr uint16_t FORMAT_RECORD = 0;
+inline constexpr size_t DEFAULT_CAPACITY = size_t(64) << 20;
+
+enum TYPE : uint8_t {
+    BOOL = 'b',
+    INT = 'i',
+    UINT = 'u',
+    FLOAT = 'f',
+    STRING = 's',
+};
+
+template <typename T>
+constexpr TYPE type_of() {
+    if constexpr (std::is_same_v<T, bool>) {
+        return TYPE::BOOL;
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        return TYPE::INT;
+    } else if constexpr (std::is_integral_v<T>) {
+        return TYPE::UINT;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return TYPE::FLOAT;
+    } else {
+        static_assert(std::is_same_v<T, std::string_view>, "Binary log arguments must be numbers or std::string_view");
+        return TYPE::STRING;
+    }
+}
+}  // namespace binary_log
+
+/**
+ * @brief A binary log for high-rate logging.
+ *
+ * @details Text logging formats every argument on the calling thread. A
+ * binary log instead writes a timestamp and the raw arguments of a record to
+ * a memory-mapped file, and the text is rendered offline by the rixlog tool
+ * (see BinaryLog::decode). Each call site registers its format once:
+ *
+ *     static const auto fmt = BinaryLog::format<uint32_t, double>(Log::INFO, "spin {} took {} ms");
+ *     BinaryLog::write(fmt, seq, elapsed);
+ *
+ * Every "{}" in the text is replaced by the next argument. Writing reserves
+ * space with a single atomic add, so threads log concurrently without locks.
+ * When the file is full, records are dropped and counted. Records below
+ * RIX_UTIL_LOG_LEVEL are not written. Nothing is written until open() is
+ * called.
+ */
+class BinaryLog {
+   public:
+    /**
+     * @brief A registered format, returned by BinaryLog::format.
+     *
+     * @tparam Args The types of the arguments of its records
+     */
+    template <typename... Args>
+    class Format {
+       public:
+        uint16_t id() const { return id_; }
+        Log::Level level() const { return level_; }
+
+       private:
+        friend class BinaryLog;
+        Format(uint16_t id, Log::Level level) : id_(id), level_(level) {}
+
+        uint16_t id_;
+        Log::Level level_;
+    };
+
+    /**
+     * @brief Registers a format. Call once per call site, e.g. to initialize
+     * a static variable.
+     *
+     * @tparam Args The types of the arguments (numbers or std::string_view)
+     * @param level The level of its records
+     * @param text The text of its records, with "{}" for each argument
+     */
+    template <typename... Args>
+    static Format<Args...> format(Log::Level level, const std::string &text);
+
+    /**
+     * @brief Writes a record. Does nothing if the log is not open.
+     *
+     */
+    template <typename... Args>
+    static void write(const Format<Args...> &format, const std::type_identity_t<Args> &...args);
+
+    /**
+     * @brief Opens the binary log of this process in ~/.rix/log/, next to
+     * the text logs of Log::init.
+     *
+     * @param name The name of the process
+     * @param capacity The size of the file. Records that do not fit are dropped.
+     * @return false if the file could not be created
+     */
+    static bool open(const std::string &name, size_t capacity = binary_log::DEFAULT_CAPACITY);
+
+    /**
+     * @brief Opens the binary log at `path`.
+     *
+     */
+    static bool open_file(const std::string &path, const std::string &name,
+                          size_t capacity = binary_log::DEFAULT_CAPACITY);
+
+    /**
+     * @brief Truncates the file to the records written and unmaps it. No
+     * thread may write while the log is closed.
+     *
+     */
+    static void close();
+
+    /**
+     * @brief Returns the number of records dropped because the log was full.
+     *
+     */
+    static uint64_t dropped();
+
+    /**
+     * @brief Renders the records of a binary log as text, one line per record,
+     * with the same header as plain text logs.
+     *
+     * @return false if the file is not a binary log
+     */
+    static bool decode(const std::string &path, std::ostream &out);
+
+   private:
+    struct FormatInfo {
+        uint8_t level;
+        std::vector<uint8_t> types;
+        std::string text;
+    };
+
+    struct State {
+        std::atomic<uint8_t *> base{nullptr};
+        size_t capacity = 0;
+        std::atomic<size_t> offset{0};
+        std::atomic<uint64_t> dropped{0};
+        int fd = -1;
+        std::mutex mutex; /**< Protects formats, open and close */
+        std::vector<FormatInfo> formats;
+
+        ~State() { BinaryLog::close(); }
+    };
+
+    static State &state() {
+        static State s;
+        return s;
+    }
+
+    /**
+     * @brief Reserves a record of `size` bytes (a multiple of 8), or returns
+     * nullptr if the log is closed or full.
+     *
+     */
+    static uint8_t *reserve(size_t size);
+
+    /**
+     * @brief Fills in the header of a reserved record. The size is stored
+     * last, so a record is complete once its size is set.
+     *
+     */
+    static void commit(uint8_t *record, size_t size, uint16_t format, int64_t time);
+
+    static void write_format(uint16_t id, const FormatInfo &info);
+
+    static int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+
+    template <typename T>
+    static size_t arg_size(const T &arg) {
+        if constexpr (binary_log::type_of<T>() == binary_log::STRING) {
+            return sizeof(uint16_t) + std::min<size_t>(arg.size(), UINT16_MAX);
+        } else if constexpr (binary_log::type_of<T>() == binary_log::BOOL) {
+            return 1;
+        } else {
+            return 8;
+        }
+    }
+
+    template <typename T>
+    static uint8_t *put_arg(uint8_t *dst, const T &arg) {
+        using rix::msg::detail::to_wire;
+        constexpr binary_log::TYPE type = binary_log::type_of<T>();
+        if constexpr (type == binary_log::STRING) {
+            uint16_t len = static_cast<uint16_t>(std::min<size_t>(arg.size(), UINT16_MAX));
+            uint16_t wire = to_wire(len);
+            std::memcpy(dst, &wire, sizeof(wire));
+            std::memcpy(dst + sizeof(wire), arg.data(), len);
+            return dst + sizeof(wire) + len;
+        } else if constexpr (type == binary_log::BOOL) {
+            *dst = arg ? 1 : 0;
+            return dst + 1;
+        } else {
+            using Wide = std::conditional_t<type == binary_log::INT, int64_t,
+                                            std::conditional_t<type == binary_log::UINT, uint64_t, double>>;
+            Wide value = to_wire(static_cast<Wide>(arg));
+            std::memcpy(dst, &value, sizeof(value));
+            return dst + sizeof(value);
+        }
+    }
+};
+
+template <typename... Args>
+BinaryLog::Format<Args...> BinaryLog::format(Log::Level level, const std::string &text) {
+    auto &s = state();
+    std::lock_guard<std::mutex> guard(s.mutex);
+    FormatInfo info{static_cast<uint8_t>(level), {binary_log::type_of<Args>()...}, text};
+    s.formats.push_back(info);
+    uint16_t id = static_cast<uint16_t>(s.formats.size());
+    if (s.base.load()) {
+        write_format(id, info);
+    }
+    return Format<Args...>(id, level);
+}
+
+template <typename... Args>
+void BinaryLog::write(const Format<Args...> &format, const std::type_identity_t<Args> &...args) {
+    if (format.level_ < RIX_UTIL_LOG_LEVEL) {
+        return;
+    }
+    const size_t size = (binary_log::RECORD_HEADER_SIZE + (size_t(0) + ... + arg_size(args)) + 7) & ~size_t(7);
+    uint8_t *record = reserve(size);
+    if (!record) {
+        return;
+    }
+    uint8_t *dst = record + binary_log::RECORD_HEADER_SIZE;
+    ((dst = put_arg(dst, args)), ...);
+    commit(record, size, format.id_, now());
+}
+
+inline uint8_t *BinaryLog::reserve(size_t size) {
+    auto &s = state();
+    uint8_t *base = s.base.load(std::memory_order_acquire);
+    if (!base) {
+        return nullptr;
+    }
+    size_t offset = s.offset.fetch_add(size, std::memory_order_relaxed);
+    if (offset + size > s.capacity) {
+        s.dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    return base + offset;
+}
+
+inline void BinaryLog::commit(uint8_t *record, size_t size, uint16_t format, int64_t time) {
+    using rix::msg::detail::to_wire;
+    uint16_t wire_format = to_wire(format);
+    uint16_t zero = 0;
+    int64_t wire_time = to_wire(time);
+    std::memcpy(record + 4, &wire_format, sizeof(wire_format));
+    std::memcpy(record + 6, &zero, sizeof(zero));
+    std::memcpy(record + 8, &wire_time, sizeof(wire_time));
+    std::atomic_ref<uint32_t>(*reinterpret_cast<uint32_t *>(record))
+        .store(to_wire(static_cast<uint32_t>(size)), std::memory_order_release);
+}
+
+inline void BinaryLog::write_format(uint16_t id, const FormatInfo &info) {
+    using rix::msg::detail::to_wire;
+    const size_t payload = sizeof(uint16_t) + 2 + info.types.size() + info.text.size();
+    const size_t size = (binary_log::RECORD_HEADER_SIZE + payload + 7) & ~size_t(7);
+    uint8_t *record = reserve(size);
+    if (!record) {
+        return;
+    }
+    uint8_t *dst = record + binary_log::RECORD_HEADER_SIZE;
+    uint16_t wire_id = to_wire(id);
+    std::memcpy(dst, &wire_id, sizeof(wire_id));
+    dst[2] = info.level;
+    dst[3] = static_cast<uint8_t>(info.types.size());
+    std::memcpy(dst + 4, info.types.data(), info.types.size());
+    std::memcpy(dst + 4 + info.types.size(), info.text.data(), info.text.size());
+    std::memset(dst + payload, 0, size - binary_log::RECORD_HEADER_SIZE - payload);
+    commit(record, size, binary_log::FORMAT_RECORD, now());
+}
+
+inline bool BinaryLog::open(const std::string &name, size_t capacity) {
+    const char *home = getenv("HOME");
+    if (home == NULL) {
+        home = getpwuid(getuid())->pw_dir;
+    }
+    std::string dir = std::string(home) + "/.rix/log/";
+    struct stat st;
+    if (stat(dir.c_str(), &st) < 0 && mkdir(dir.c_str(), S_IRWXU) < 0) {
+        Log::warn << "Failed to create " << dir << std::endl;
+        return false;
+    }
+    return open_file(dir + name + "_" + std::to_string(now()) + ".rixlog", name, capacity);
+}
+
+inline bool BinaryLog::open_file(const std::string &path, const std::string &name, size_t capacity) {
+    auto &s = state();
+    std::lock_guard<std::mutex> guard(s.mutex);
+    if (s.base.load() || capacity < binary_log::HEADER_SIZE) {
+        return false;
+    }
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ftruncate(fd, static_cast<off_t>(capacity)) < 0) {
+        Log::warn << "Failed to create binary log " << path << std::endl;
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+    void *base = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    if (base == MAP_FAILED) {
+        Log::warn << "Failed to map binary log " << path << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    uint8_t *header = static_cast<uint8_t *>(base);
+    std::memcpy(header, binary_log::MAGIC, sizeof(binary_log::MAGIC));
+    std::strncpy(reinterpret_cast<char *>(header + sizeof(binary_log::MAGIC)), name.c_str(),
+                 binary_log::HEADER_SIZE - sizeof(binary_log::MAGIC) - 1);
+
+    s.fd = fd;
+    s.capacity = capacity;
+    s.offset.store(binary_log::HEADER_SIZE);
+    s.dropped.store(0);
+    s.base.store(header, std::memory_order_release);
+    for (size_t i = 0; i < s.formats.size(); i++) {
+        write_format(static_cast<uint16_t>(i + 1), s.formats[i]);
+    }
+    return true;
+}
+
+inline void BinaryLog::close() {
+    auto &s = state();
+    std::lock_guard<std::mutex> guard(s.mutex);
+    uint8_t *base = s.base.exchange(nullptr);
+    if (!base) {
+        return;
+    }
+    munmap(base, s.capacity);
+    (void)ftruncate(s.fd, static_cast<off_t>(std::min(s.offset.load(), s.capacity)));
+    ::close(s.fd);
+    s.fd = -1;
+}
+
+inline uint64_t BinaryLog::dropped() { return state().dropped.load(std::memory_order_relaxed); }
+
+inline bool BinaryLog::decode(const std::string &path, std::ostream &out) {
+    using rix::msg::detail::from_wire;
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() < binary_log::HEADER_SIZE ||
+        std::memcmp(data.data(), binary_log::MAGIC, sizeof(binary_log::MAGIC)) != 0) {
+        return false;
+    }
+    std::string name(reinterpret_cast<const char *>(data.data() + sizeof(binary_log::MAGIC)));
+
+    auto load = [&](size_t pos, auto &value) {
+        std::memcpy(&value, data.data() + pos, sizeof(value));
+        value = from_wire(value);
+    };
+    static const char *levels[] = {"DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+    std::vector<FormatInfo> formats;
+    size_t pos = binary_log::HEADER_SIZE;
+    while (data.size() - pos >= binary_log::RECORD_HEADER_SIZE) {
+        uint32_t size;
+        uint16_t id;
+        int64_t time;
+        load(pos, size);
+        load(pos + 4, id);
+        load(pos + 8, time);
+        if (size < binary_log::RECORD_HEADER_SIZE || size > data.size() - pos) {
+            break;
+        }
+        const uint8_t *src = data.data() + pos + binary_log::RECORD_HEADER_SIZE;
+        const uint8_t *end = data.data() + pos + size;
+        pos += size;
+
+        if (id == binary_log::FORMAT_RECORD) {
+            if (end - src < 4 || end - src - 4 < src[3]) continue;
+            uint16_t format_id;
+            load(src - data.data(), format_id);
+            if (format_id == 0) continue;  // Corrupt, IDs start at 1
+            FormatInfo info{src[2], std::vector<uint8_t>(src + 4, src + 4 + src[3]), {}};
+            info.text.assign(reinterpret_cast<const char *>(src + 4 + src[3]), end - src - 4 - src[3]);
+            info.text.erase(info.text.find_last_not_of('\0') + 1);
+            if (formats.size() < format_id) formats.resize(format_id);
+            formats[format_id - 1] = info;
+            continue;
+        }
+
+        std::ostringstream line;
+        line << "[" << Time(Time::Type(std::chrono::nanoseconds(time))).to_string() << "] ";
+        if (id > formats.size() || formats[id - 1].text.empty()) {
+            line << "[?]     [" << name << "] <unknown format " << id << ">";
+            out << line.str() << std::endl;
+            continue;
+        }
+        const FormatInfo &info = formats[id - 1];
+        std::string level = std::string("[") + (info.level < 5 ? levels[info.level] : "?") + "] ";
+        line << std::setw(8) << std::left << level << "[" << name << "] ";
+
+        // Substitute the arguments for the placeholders
+        size_t text_pos = 0;
+        for (uint8_t type : info.types) {
+            size_t placeholder = info.text.find("{}", text_pos);
+            line << info.text.substr(text_pos, placeholder - text_pos);
+            text_pos = placeholder == std::string::npos ? info.text.size() : placeholder + 2;
+            size_t at = src - data.data();
+            if (type == binary_log::BOOL && end - src >= 1) {
+                line << (*src ? "true" : "false");
+                src += 1;
+            } else if (type == binary_log::INT && end - src >= 8) {
+                int64_t value;
+                load(at, value);
+                line << value;
+                src += 8;
+            } else if (type == binary_log::UINT && end - src >= 8) {
+                uint64_t value;
+                load(at, value);
+                line << value;
+                src += 8;
+            } else if (type == binary_log::FLOAT && end - src >= 8) {
+                double value;
+                load(at, value);
+                line << value;
+                src += 8;
+            } else if (type == binary_log::STRING && end - src >= 2) {
+                uint16_t len;
+                load(at, len);
+                len = static_cast<uint16_t>(std::min<size_t>(len, end - src - 2));
+                line << std::string_view(reinterpret_cast<const char *>(src + 2), len);
+                src += 2 + len;
+            } else {
+                line << "<invalid>";
+            }
+        }
+        line << info.text.substr(text_pos);
+        out << line.str() << std::endl;
+    }
+    return true;
+}
+
+}  // namespace util
+}  // namespace rix
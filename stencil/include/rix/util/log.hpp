@@ -9,13 +9,18 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include "rix/util/time.hpp"
 
@@ -92,6 +97,109 @@ class NullBuffer : public std::streambuf {
 
 inline int NullBuffer::overflow(int c) { return c; }
 
+/**
+ * @brief A log record of the asynchronous backend. The header of the line is
+ * formatted by the background thread from `time` and `level`.
+ *
+ */
+struct LogRecord {
+    static constexpr size_t TEXT_SIZE = 496; /**< Longer records are truncated */
+    int64_t time;                            /**< Nanoseconds since the epoch */
+    uint8_t level;
+    uint16_t size;
+    char text[TEXT_SIZE];
+};
+
+/**
+ * @brief Single producer, single consumer queue of log records. Every thread
+ * that logs asynchronously owns one, and the background thread of the Log
+ * drains all of them. The producer claims the next free record, writes into
+ * it in place and publishes it. If the queue is full, the record is dropped
+ * rather than blocking the producer.
+ *
+ */
+class LogQueue {
+   public:
+    static constexpr size_t CAPACITY = 256;
+
+    LogRecord *claim() {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == CAPACITY) return nullptr;
+        return &records_[tail % CAPACITY];
+    }
+    void publish() { tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+    void drop() { dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+    const LogRecord *front() const {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return nullptr;
+        return &records_[head % CAPACITY];
+    }
+    void pop() { head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    void close() { closed_.store(true, std::memory_order_release); }
+    bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+    uint64_t reported = 0; /**< Drops already reported by the consumer */
+
+   private:
+    std::array<LogRecord, CAPACITY> records_;
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> closed_{false};
+};
+
+/**
+ * @brief Stream buffer that writes into a claimed LogRecord. A record is
+ * started by begin() and published when the stream is flushed (e.g. by
+ * std::endl), or by the next begin().
+ *
+ */
+class LogRecordBuffer : public std::streambuf {
+   public:
+    explicit LogRecordBuffer(LogQueue &queue) : queue_(queue) {}
+
+    void begin(uint8_t level, int64_t time) {
+        if (record_) commit();
+        record_ = queue_.claim();
+        if (!record_) record_ = &discard_;
+        record_->level = level;
+        record_->time = time;
+        // The last byte is reserved for the newline of a truncated record
+        setp(record_->text, record_->text + LogRecord::TEXT_SIZE - 1);
+    }
+
+    int overflow(int c) override { return c; }  // Truncate
+
+    int sync() override {
+        if (record_) commit();
+        return 0;
+    }
+
+   private:
+    void commit() {
+        // Records end with a newline, even if it was truncated
+        if (pptr() == pbase() || pptr()[-1] != '\n') {
+            *pptr() = '\n';
+            pbump(1);
+        }
+        record_->size = static_cast<uint16_t>(pptr() - pbase());
+        if (record_ == &discard_) {
+            queue_.drop();
+        } else {
+            queue_.publish();
+        }
+        record_ = nullptr;
+        setp(nullptr, nullptr);
+    }
+
+    LogQueue &queue_;
+    LogRecord *record_ = nullptr;
+    LogRecord discard_;
+};
+
 }  // namespace detail
 
 /**
@@ -145,6 +253,33 @@ class Log {
    public:
     inline static void init(const std::string &name, bool logToFile = false);
 
+    /**
+     * @brief Enables or disables the asynchronous backend.
+     *
+     * @details By default, every log statement formats its header and writes
+     * to the console (and the log file) while holding a global mutex. With
+     * the asynchronous backend, a statement only takes a timestamp and streams
+     * its values into a record of a lock-free queue owned by the calling
+     * thread. A background thread formats the headers and writes the records.
+     * A record ends at std::endl (or any flush) or at the next log statement
+     * of the thread. It is truncated to 496 characters. If a thread logs
+     * faster than the background thread writes, its records are dropped and
+     * the number of drops is logged, so logging never blocks. Records of
+     * different threads may be written out of order.
+     *
+     * Disabling the backend writes the remaining records before returning.
+     *
+     * @param enabled Whether to log asynchronously
+     */
+    inline static void set_async(bool enabled);
+
+    /**
+     * @brief Writes the records of the asynchronous backend that have been
+     * published so far. Does nothing else if the backend is disabled.
+     *
+     */
+    inline static void flush();
+
     /**
      * The public LogStream objects. These are used to log inforamtion at the
      * corresponding level. If RIX_UTIL_LOG_LEVEL is greater than the template
@@ -166,6 +301,45 @@ class Log {
 
     inline static std::string get_color_code(Level level);
     inline static std::string get_level_string(Level level);
+    inline static std::string create_header(Level level, const Time &t);
+
+    /**
+     * @brief State of the asynchronous backend. The queues of logging threads
+     * are registered once per thread, so queues_mutex is not taken on the
+     * logging path.
+     *
+     */
+    struct AsyncState {
+        std::mutex queues_mutex;
+        std::vector<std::shared_ptr<detail::LogQueue>> queues;
+        std::mutex drain_mutex; /**< Serializes the consumers of the queues */
+        std::thread thread;
+        std::atomic<bool> running{false};
+
+        ~AsyncState();
+    };
+
+    inline static std::atomic<bool> async{false};
+
+    /**
+     * @brief Returns the state of the asynchronous backend. It is constructed
+     * on first use, so it is destroyed before the streams it writes to.
+     *
+     */
+    inline static AsyncState &async_state();
+
+    /**
+     * @brief Starts a record on the calling thread's queue and returns the
+     * stream that writes into it.
+     *
+     */
+    inline static std::ostream &async_stream(Level level);
+
+    /**
+     * @brief Writes all published records. drain_mutex must be held.
+     *
+     */
+    inline static void drain();
 };
 
 template <Log::Level level>
@@ -175,6 +349,10 @@ inline std::ostream &Log::LogStream<level>::operator<<(const T &val) {
         return null_stream;
     }
 
+    if (Log::async.load(std::memory_order_relaxed)) {
+        return Log::async_stream(level) << val;
+    }
+
     std::lock_guard<std::mutex> guard(mutex);
     std::string header = create_header(Time::now());
     return tee_stream << header << val;
@@ -182,6 +360,10 @@ inline std::ostream &Log::LogStream<level>::operator<<(const T &val) {
 
 template <Log::Level level>
 inline std::string Log::LogStream<level>::create_header(const Time &t) {
+    return Log::create_header(level, t);
+}
+
+inline std::string Log::create_header(Level level, const Time &t) {
     std::stringstream ss;
 
     // Date field
@@ -244,6 +426,107 @@ inline void Log::init(const std::string &name, bool logToFile) {
     is_init = true;
 }
 
+inline void Log::set_async(bool enabled) {
+    auto &state = async_state();
+    std::lock_guard<std::mutex> guard(mutex);
+    if (enabled == state.running.load()) {
+        return;
+    }
+    if (enabled) {
+        state.running.store(true);
+        state.thread = std::thread([&state]() {
+            while (state.running.load()) {
+                {
+                    std::lock_guard<std::mutex> g(state.drain_mutex);
+                    drain();
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        async.store(true);
+        return;
+    }
+    async.store(false);
+    state.running.store(false);
+    state.thread.join();
+    flush();
+}
+
+inline void Log::flush() {
+    auto &state = async_state();
+    std::lock_guard<std::mutex> guard(state.drain_mutex);
+    drain();
+}
+
+inline Log::AsyncState::~AsyncState() {
+    async.store(false);
+    if (thread.joinable()) {
+        running.store(false);
+        thread.join();
+    }
+    std::lock_guard<std::mutex> guard(drain_mutex);
+    drain();
+}
+
+inline Log::AsyncState &Log::async_state() {
+    static AsyncState state;
+    return state;
+}
+
+inline std::ostream &Log::async_stream(Level level) {
+    struct Producer {
+        std::shared_ptr<detail::LogQueue> queue;
+        detail::LogRecordBuffer buffer;
+        std::ostream stream;
+
+        Producer() : queue(std::make_shared<detail::LogQueue>()), buffer(*queue), stream(&buffer) {
+            auto &state = async_state();
+            std::lock_guard<std::mutex> guard(state.queues_mutex);
+            state.queues.push_back(queue);
+        }
+        ~Producer() {
+            stream.flush();
+            queue->close();
+        }
+    };
+    thread_local Producer producer;
+    producer.buffer.begin(static_cast<uint8_t>(level), Time::now().to_nanoseconds());
+    return producer.stream;
+}
+
+inline void Log::drain() {
+    auto &state = async_state();
+    auto &out = LogStream<Level::INFO>::tee_stream;
+    std::lock_guard<std::mutex> guard(state.queues_mutex);
+    bool wrote = false;
+    for (auto it = state.queues.begin(); it != state.queues.end();) {
+        auto &queue = **it;
+        // A queue is closed once its thread has exited, after its last record
+        const bool closed = queue.closed();
+        while (const detail::LogRecord *record = queue.front()) {
+            Time t{Time::Type(std::chrono::nanoseconds(record->time))};
+            out << create_header(static_cast<Level>(record->level), t);
+            out.write(record->text, record->size);
+            queue.pop();
+            wrote = true;
+        }
+        const uint64_t dropped = queue.dropped();
+        if (dropped != queue.reported) {
+            out << create_header(Level::WARN, Time::now()) << "Dropped " << dropped - queue.reported
+                       << " log records." << std::endl;
+            queue.reported = dropped;
+        }
+        if (closed) {
+            it = state.queues.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    if (wrote) {
+        out.flush();
+    }
+}
+
 inline std::string Log::get_color_code(Level level) {
     switch (level) {
         case Level::DEBUG:
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace rix {
+namespace util {
+
+/**
+ * @brief Fixed-capacity FIFO queue backed by contiguous storage.
+ *
+ * @details Storage is allocated once in the constructor. Pushing onto a full
+ * buffer overwrites the oldest element, so push, pop, front, back and indexed
+ * access are all O(1) and never allocate. Index 0 is the oldest element and
+ * index size() - 1 is the newest.
+ *
+ * @tparam T The element type (must be default constructible)
+ */
+template <typename T>
+class RingBuffer {
+   public:
+    /**
+     * @brief Construct a new RingBuffer.
+     *
+     * @param capacity The maximum number of elements held (at least 1)
+     */
+    explicit RingBuffer(size_t capacity = 1) : data_(capacity > 0 ? capacity : 1), head_(0), size_(0) {}
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return data_.size(); }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == data_.size(); }
+
+    /**
+     * @brief Appends an element. If the buffer is full, the oldest element is
+     * overwritten.
+     *
+     * @return `true` if an element was overwritten.
+     */
+    bool push(const T &value) {
+        bool overwrite = full();
+        data_[(head_ + size_) % data_.size()] = value;
+        if (overwrite) {
+            head_ = (head_ + 1) % data_.size();
+        } else {
+            size_++;
+        }
+        return overwrite;
+    }
+
+    bool push(T &&value) {
+        bool overwrite = full();
+        data_[(head_ + size_) % data_.size()] = std::move(value);
+        if (overwrite) {
+            head_ = (head_ + 1) % data_.size();
+        } else {
+            size_++;
+        }
+        return overwrite;
+    }
+
+    /**
+     * @brief Removes the oldest element. Does nothing if the buffer is empty.
+     * The slot keeps its value (and any capacity it owns) for reuse.
+     *
+     */
+    void pop() {
+        if (size_ == 0) return;
+        head_ = (head_ + 1) % data_.size();
+        size_--;
+    }
+
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+    }
+
+    T &front() { return data_[head_]; }
+    const T &front() const { return data_[head_]; }
+    T &back() { return data_[(head_ + size_ - 1) % data_.size()]; }
+    const T &back() const { return data_[(head_ + size_ - 1) % data_.size()]; }
+
+    T &operator[](size_t i) { return data_[(head_ + i) % data_.size()]; }
+    const T &operator[](size_t i) const { return data_[(head_ + i) % data_.size()]; }
+
+   private:
+    std::vector<T> data_;
+    size_t head_;
+    size_t size_;
+};
+
+}  // namespace util
+}  // namespace rix
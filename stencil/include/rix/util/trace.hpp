@@ -0,0 +1,200 @@
+#pragma once
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rix {
+namespace util {
+
+/**
+ * @brief Opt-in timeline tracing in the Chrome trace event format.
+ *
+ * @details While tracing is enabled, every Trace::Scope records a complete
+ * event (its name, an optional detail such as a topic, its start and its
+ * duration) into a ring buffer owned by the calling thread, so recording takes
+ * no locks. The ring buffers keep the most recent events of each thread. dump
+ * writes them as JSON that can be opened in chrome://tracing or
+ * ui.perfetto.dev. The spin loops of rix::core trace their callbacks, reads,
+ * writes and accepts:
+ *
+ *     rix::util::Trace::enable();
+ *     node->spin(notif);
+ *     rix::util::Trace::dump("/tmp/node.trace.json");
+ *
+ * While tracing is disabled, a Scope costs one relaxed atomic load.
+ */
+class Trace {
+   public:
+    /**
+     * @brief Records the time spent from its construction to its destruction
+     * as an event, if tracing is enabled at construction.
+     *
+     */
+    class Scope {
+       public:
+        /**
+         * @param name The name of the event. Must outlive the trace, e.g. a
+         * string literal.
+         * @param detail Shown as the argument of the event. Copied, and
+         * truncated to Event::DETAIL_SIZE - 1 characters.
+         */
+        explicit Scope(const char *name, std::string_view detail = {})
+            : name_(name), detail_(detail), start_(enabled() ? now() : 0) {}
+        ~Scope() {
+            if (start_ != 0) record(name_, detail_, start_, now());
+        }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+       private:
+        const char *name_;
+        std::string_view detail_;
+        int64_t start_;
+    };
+
+    struct Event {
+        static constexpr size_t DETAIL_SIZE = 40;
+        int64_t start; /**< steady clock, in nanoseconds */
+        int64_t duration;
+        const char *name;
+        char detail[DETAIL_SIZE];
+    };
+
+    /**
+     * @brief Starts tracing. Threads that trace for the first time allocate a
+     * ring buffer of `capacity` events.
+     *
+     */
+    static void enable(size_t capacity = 65536) {
+        capacity_.store(std::max<size_t>(capacity, 1), std::memory_order_relaxed);
+        enabled_.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Stops tracing. Recorded events are kept until clear() is called.
+     *
+     */
+    static void disable() { enabled_.store(false, std::memory_order_release); }
+
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Discards the recorded events of all threads.
+     *
+     */
+    static void clear() {
+        std::lock_guard<std::mutex> guard(registry().mutex);
+        for (auto &ring : registry().rings) ring->head.store(0, std::memory_order_release);
+    }
+
+    /**
+     * @brief Writes the recorded events of all threads, including threads that
+     * have exited, to `path` as a Chrome trace. Events recorded while dumping
+     * may be missing or torn, so disable tracing first for an exact timeline.
+     *
+     * @return false if the file could not be written
+     */
+    static bool dump(const std::string &path) {
+        std::ofstream out(path);
+        if (!out) {
+            return false;
+        }
+        const int pid = static_cast<int>(getpid());
+        out << "{\"traceEvents\":[";
+        bool first = true;
+        std::lock_guard<std::mutex> guard(registry().mutex);
+        for (const auto &ring : registry().rings) {
+            const uint64_t head = ring->head.load(std::memory_order_acquire);
+            const uint64_t count = std::min<uint64_t>(head, ring->events.size());
+            for (uint64_t i = head - count; i < head; i++) {
+                const Event &e = ring->events[i % ring->events.size()];
+                out << (first ? "\n" : ",\n") << "{\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << ring->tid
+                    << ",\"name\":\"" << e.name << "\",\"ts\":" << e.start / 1000 << "." << pad3(e.start % 1000)
+                    << ",\"dur\":" << e.duration / 1000 << "." << pad3(e.duration % 1000);
+                if (e.detail[0] != '\0') {
+                    out << ",\"args\":{\"detail\":\"" << escape(e.detail) << "\"}";
+                }
+                out << "}";
+                first = false;
+            }
+        }
+        out << "\n]}\n";
+        return static_cast<bool>(out);
+    }
+
+   private:
+    struct Ring {
+        std::vector<Event> events;
+        std::atomic<uint64_t> head{0}; /**< Number of events ever recorded */
+        long tid;
+    };
+
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<Ring>> rings;
+    };
+
+    inline static std::atomic<bool> enabled_{false};
+    inline static std::atomic<size_t> capacity_{65536};
+
+    static Registry &registry() {
+        static Registry r;
+        return r;
+    }
+
+    static int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    static void record(const char *name, std::string_view detail, int64_t start, int64_t end) {
+        // The registry keeps the ring of a thread alive after the thread exits
+        thread_local std::shared_ptr<Ring> ring;
+        if (!ring) {
+            ring = std::make_shared<Ring>();
+            ring->events.resize(capacity_.load(std::memory_order_relaxed));
+            ring->tid = syscall(SYS_gettid);
+            std::lock_guard<std::mutex> guard(registry().mutex);
+            registry().rings.push_back(ring);
+        }
+        const uint64_t head = ring->head.load(std::memory_order_relaxed);
+        Event &e = ring->events[head % ring->events.size()];
+        e.start = start;
+        e.duration = end - start;
+        e.name = name;
+        const size_t len = std::min(detail.size(), Event::DETAIL_SIZE - 1);
+        std::memcpy(e.detail, detail.data(), len);
+        e.detail[len] = '\0';
+        ring->head.store(head + 1, std::memory_order_release);
+    }
+
+    static std::string pad3(int64_t value) {
+        std::string s = std::to_string(value);
+        return std::string(3 - std::min<size_t>(s.size(), 3), '0') + s;
+    }
+
+    static std::string escape(const char *text) {
+        std::string s;
+        for (; *text; text++) {
+            if (*text == '"' || *text == '\\') s += '\\';
+            if (static_cast<unsigned char>(*text) >= 0x20) s += *text;
+        }
+        return s;
+    }
+};
+
+}  // namespace util
+}  // namespace rix
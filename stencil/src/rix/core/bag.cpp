@@ -0,0 +1,569 @@
+#include "rix/core/bag.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "rix/msg/serialization.hpp"
+#include "rix/util/log.hpp"
+
+namespace rix {
+namespace core {
+
+/**
+ * @brief Writes all `len` bytes to `fd`.
+ *
+ */
+static bool write_all(int fd, const uint8_t *data, size_t len) {
+    while (len > 0) {
+        ssize_t bytes = ::write(fd, data, len);
+        if (bytes < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += bytes;
+        len -= static_cast<size_t>(bytes);
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the size of a record of `len` bytes, a multiple of 8.
+ *
+ */
+static size_t record_size(size_t len) { return (bag::RECORD_HEADER_SIZE + len + 7) & ~size_t(7); }
+
+/**
+ * @brief Writes a record at `dst` and returns its size, a multiple of 8.
+ *
+ */
+static size_t write_record(uint8_t *dst, uint16_t topic, uint8_t kind, uint8_t encoding, int64_t time,
+                           const uint8_t *data, size_t len) {
+    const size_t record = record_size(len);
+    size_t offset = 0;
+    rix::msg::detail::serialize_number(dst, offset, static_cast<uint32_t>(len));
+    rix::msg::detail::serialize_number(dst, offset, topic);
+    rix::msg::detail::serialize_number(dst, offset, kind);
+    rix::msg::detail::serialize_number(dst, offset, encoding);
+    rix::msg::detail::serialize_number(dst, offset, time);
+    std::memcpy(dst + offset, data, len);
+    std::memset(dst + offset + len, 0, record - offset - len);
+    return record;
+}
+
+BagWriter::~BagWriter() { close(); }
+
+bool BagWriter::open(const std::string &path, size_t chunk_size, size_t max_pending) {
+    close();
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        rix::util::Log::warn << "Failed to create bag " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    std::vector<uint8_t> header(bag::HEADER_SIZE, 0);
+    std::memcpy(header.data(), bag::MAGIC, sizeof(bag::MAGIC));
+    size_t offset = sizeof(bag::MAGIC);
+    rix::msg::detail::serialize_number(header.data(), offset, uint64_t(0));  // No index
+    rix::msg::detail::serialize_number(header.data(), offset, uint64_t(chunk_size));
+    if (!write_all(fd_, header.data(), header.size())) {
+        rix::util::Log::warn << "Failed to write bag " << path << ": " << std::strerror(errno) << std::endl;
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    chunk_size_ = chunk_size;
+    max_pending_ = std::max<size_t>(max_pending, 1);
+    topics_ = 0;
+    messages_ = 0;
+    bytes_ = bag::HEADER_SIZE;
+    topic_records_.clear();
+    index_.clear();
+    chunk_ = Chunk{};
+    chunk_.data.resize(bag::CHUNK_HEADER_SIZE + chunk_size_);
+    chunk_.size = bag::CHUNK_HEADER_SIZE;
+    allocated_ = 1;
+    stop_ = false;
+    failed_ = false;
+    thread_ = std::thread([this]() { run(); });
+    return true;
+}
+
+bool BagWriter::ok() const { return fd_ >= 0 && !failed_.load(); }
+
+int BagWriter::add_topic(const rix::msg::mediator::TopicInfo &info) {
+    if (!ok() || topics_ == UINT16_MAX) {
+        return -1;
+    }
+    std::vector<uint8_t> buffer(info.size());
+    size_t offset = 0;
+    info.serialize(buffer.data(), offset);
+    uint16_t id = topics_++;
+    if (!append(id, bag::TOPIC, info.encoding, 0, buffer.data(), buffer.size())) {
+        return -1;
+    }
+    size_t end = topic_records_.size();
+    topic_records_.resize(end + record_size(buffer.size()));
+    write_record(topic_records_.data() + end, id, bag::TOPIC, info.encoding, 0, buffer.data(), buffer.size());
+    return id;
+}
+
+bool BagWriter::write(uint16_t topic, int64_t time, uint8_t encoding, const uint8_t *data, size_t len) {
+    if (!ok() || !append(topic, bag::MESSAGE, encoding, time, data, len)) {
+        return false;
+    }
+    if (chunk_.messages++ == 0) {
+        chunk_.first = time;
+    }
+    chunk_.last = time;
+    messages_++;
+    return true;
+}
+
+bool BagWriter::append(uint16_t topic, uint8_t kind, uint8_t encoding, int64_t time, const uint8_t *data,
+                       size_t len) {
+    if (len > UINT32_MAX) {
+        rix::util::Log::warn << "Message of " << len << " bytes is too large for a bag." << std::endl;
+        return false;
+    }
+    const size_t record = record_size(len);
+    if (chunk_.size + record > chunk_.data.size()) {
+        if (chunk_.count > 0) {
+            submit();
+        }
+        // A record larger than a chunk gets a chunk of its own
+        if (chunk_.size + record > chunk_.data.size()) {
+            chunk_.data.resize(chunk_.size + record);
+        }
+    }
+
+    write_record(chunk_.data.data() + chunk_.size, topic, kind, encoding, time, data, len);
+    chunk_.size += record;
+    bytes_ += chunk_.count++ == 0 ? bag::CHUNK_HEADER_SIZE + record : record;
+    return true;
+}
+
+void BagWriter::seal() {
+    bag::Chunk entry;
+    entry.offset = index_.empty() ? bag::HEADER_SIZE
+                                  : index_.back().offset + bag::CHUNK_HEADER_SIZE + index_.back().size;
+    entry.size = chunk_.size - bag::CHUNK_HEADER_SIZE;
+    entry.records = chunk_.count;
+    entry.messages = chunk_.messages;
+    entry.first = chunk_.first;
+    entry.last = chunk_.last;
+    index_.push_back(entry);
+
+    size_t offset = 0;
+    uint8_t *dst = chunk_.data.data();
+    rix::msg::detail::serialize_number(dst, offset, entry.size);
+    rix::msg::detail::serialize_number(dst, offset, entry.records);
+    rix::msg::detail::serialize_number(dst, offset, entry.messages);
+    rix::msg::detail::serialize_number(dst, offset, entry.first);
+    rix::msg::detail::serialize_number(dst, offset, entry.last);
+}
+
+void BagWriter::submit() {
+    seal();
+    std::unique_lock<std::mutex> lock(mutex_);
+    full_.push_back(std::move(chunk_));
+    cv_.notify_all();
+    if (free_.empty() && allocated_ <= max_pending_) {
+        allocated_++;
+        chunk_ = Chunk{};
+        chunk_.data.resize(bag::CHUNK_HEADER_SIZE + chunk_size_);
+    } else {
+        cv_.wait(lock, [this]() { return !free_.empty(); });
+        chunk_ = std::move(free_.back());
+        free_.pop_back();
+    }
+    chunk_.size = bag::CHUNK_HEADER_SIZE;
+    chunk_.count = 0;
+    chunk_.messages = 0;
+    chunk_.first = 0;
+    chunk_.last = 0;
+}
+
+void BagWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this]() { return stop_ || !full_.empty(); });
+        if (full_.empty()) {
+            return;  // Stopped and everything is written
+        }
+        Chunk chunk = std::move(full_.front());
+        full_.pop_front();
+        lock.unlock();
+        if (!failed_.load() && !write_all(fd_, chunk.data.data(), chunk.size)) {
+            rix::util::Log::warn << "Failed to write bag: " << std::strerror(errno) << std::endl;
+            failed_ = true;
+        }
+        lock.lock();
+        free_.push_back(std::move(chunk));
+        cv_.notify_all();
+    }
+}
+
+bool BagWriter::close() {
+    if (fd_ < 0) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (chunk_.count > 0) {
+            seal();
+            full_.push_back(std::move(chunk_));
+        }
+        stop_ = true;
+        cv_.notify_all();
+    }
+    thread_.join();
+    bool success = !failed_.load() && write_index();
+    if (::close(fd_) != 0) {
+        success = false;
+    }
+    fd_ = -1;
+    full_.clear();
+    free_.clear();
+    chunk_ = Chunk{};
+    return success;
+}
+
+bool BagWriter::write_index() {
+    const uint64_t index_offset =
+        index_.empty() ? bag::HEADER_SIZE : index_.back().offset + bag::CHUNK_HEADER_SIZE + index_.back().size;
+    std::vector<uint8_t> index(bag::INDEX_HEADER_SIZE + topic_records_.size() + index_.size() * bag::CHUNK_INDEX_SIZE);
+    uint8_t *dst = index.data();
+    size_t offset = 0;
+    rix::msg::detail::serialize_number(dst, offset, static_cast<uint64_t>(index_.size()));
+    rix::msg::detail::serialize_number(dst, offset, static_cast<uint32_t>(topics_));
+    rix::msg::detail::serialize_number(dst, offset, uint32_t(0));
+    std::memcpy(dst + offset, topic_records_.data(), topic_records_.size());
+    offset += topic_records_.size();
+    for (const auto &entry : index_) {
+        rix::msg::detail::serialize_number(dst, offset, entry.offset);
+        rix::msg::detail::serialize_number(dst, offset, entry.size);
+        rix::msg::detail::serialize_number(dst, offset, entry.records);
+        rix::msg::detail::serialize_number(dst, offset, entry.messages);
+        rix::msg::detail::serialize_number(dst, offset, entry.first);
+        rix::msg::detail::serialize_number(dst, offset, entry.last);
+    }
+
+    // The index offset is filled in last, so a bag is only indexed once its
+    // index is complete
+    uint8_t field[sizeof(uint64_t)];
+    offset = 0;
+    rix::msg::detail::serialize_number(field, offset, index_offset);
+    if (!write_all(fd_, index.data(), index.size()) ||
+        ::pwrite(fd_, field, sizeof(field), sizeof(bag::MAGIC)) != static_cast<ssize_t>(sizeof(field))) {
+        rix::util::Log::warn << "Failed to write bag index: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    bytes_ += index.size();
+    return true;
+}
+
+uint64_t BagWriter::messages() const { return messages_; }
+
+uint64_t BagWriter::bytes() const { return bytes_; }
+
+/**
+ * @brief Reads `len` bytes at `offset` of `fd`.
+ *
+ */
+static bool read_all(int fd, uint8_t *data, size_t len, uint64_t offset) {
+    while (len > 0) {
+        ssize_t bytes = ::pread(fd, data, len, static_cast<off_t>(offset));
+        if (bytes < 0 && errno == EINTR) continue;
+        if (bytes <= 0) return false;
+        data += bytes;
+        len -= static_cast<size_t>(bytes);
+        offset += static_cast<uint64_t>(bytes);
+    }
+    return true;
+}
+
+/**
+ * @brief Parses the record at `offset` of `data` and advances the offset to
+ * the next record.
+ *
+ */
+static bool read_record(const uint8_t *data, size_t size, size_t &offset, uint8_t &kind, BagReader::Message &msg) {
+    using rix::msg::detail::deserialize_number;
+    uint32_t len;
+    size_t off = offset;
+    if (!deserialize_number(len, data, size, off) || !deserialize_number(msg.topic, data, size, off) ||
+        !deserialize_number(kind, data, size, off) || !deserialize_number(msg.encoding, data, size, off) ||
+        !deserialize_number(msg.time, data, size, off) || size - off < len) {
+        return false;
+    }
+    msg.data = data + off;
+    msg.len = len;
+    offset = std::min(size, offset + record_size(len));
+    return true;
+}
+
+BagReader::~BagReader() { close(); }
+
+bool BagReader::open(const std::string &path) {
+    close();
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        rix::util::Log::warn << "Failed to open bag " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    uint8_t header[bag::HEADER_SIZE];
+    const off_t file_size = ::lseek(fd_, 0, SEEK_END);
+    uint64_t index_offset = 0;
+    size_t offset = sizeof(bag::MAGIC);
+    bool valid = file_size >= static_cast<off_t>(bag::HEADER_SIZE) && read_all(fd_, header, sizeof(header), 0) &&
+                 std::memcmp(header, bag::MAGIC, sizeof(bag::MAGIC)) == 0 &&
+                 rix::msg::detail::deserialize_number(index_offset, header, sizeof(header), offset);
+    if (valid) {
+        valid = index_offset != 0 ? read_index(index_offset, file_size) : scan(file_size);
+    }
+    if (!valid) {
+        rix::util::Log::warn << path << " is not a bag." << std::endl;
+        close();
+        return false;
+    }
+    messages_ = 0;
+    for (const auto &chunk : chunks_) {
+        messages_ += chunk.messages;
+    }
+    return true;
+}
+
+bool BagReader::read_index(uint64_t offset, uint64_t file_size) {
+    using rix::msg::detail::deserialize_number;
+    if (offset > file_size) {
+        return false;
+    }
+    std::vector<uint8_t> index(file_size - offset);
+    if (!read_all(fd_, index.data(), index.size(), offset)) {
+        return false;
+    }
+    uint64_t chunks;
+    uint32_t topics, reserved;
+    size_t off = 0;
+    if (!deserialize_number(chunks, index.data(), index.size(), off) ||
+        !deserialize_number(topics, index.data(), index.size(), off) ||
+        !deserialize_number(reserved, index.data(), index.size(), off)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < topics; i++) {
+        uint8_t kind;
+        Message record;
+        if (!read_record(index.data(), index.size(), off, kind, record) || kind != bag::TOPIC ||
+            !add_topic(record.topic, record.data, record.len)) {
+            return false;
+        }
+    }
+    if ((index.size() - off) / bag::CHUNK_INDEX_SIZE < chunks) {
+        return false;
+    }
+    chunks_.resize(chunks);
+    for (auto &chunk : chunks_) {
+        deserialize_number(chunk.offset, index.data(), index.size(), off);
+        deserialize_number(chunk.size, index.data(), index.size(), off);
+        deserialize_number(chunk.records, index.data(), index.size(), off);
+        deserialize_number(chunk.messages, index.data(), index.size(), off);
+        deserialize_number(chunk.first, index.data(), index.size(), off);
+        deserialize_number(chunk.last, index.data(), index.size(), off);
+        if (chunk.offset + bag::CHUNK_HEADER_SIZE + chunk.size > offset) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BagReader::scan(uint64_t file_size) {
+    using rix::msg::detail::deserialize_number;
+    uint8_t header[bag::CHUNK_HEADER_SIZE];
+    std::vector<uint8_t> records;
+    uint64_t pos = bag::HEADER_SIZE;
+    while (file_size - pos >= bag::CHUNK_HEADER_SIZE && read_all(fd_, header, sizeof(header), pos)) {
+        bag::Chunk chunk;
+        chunk.offset = pos;
+        size_t off = 0;
+        deserialize_number(chunk.size, header, sizeof(header), off);
+        deserialize_number(chunk.records, header, sizeof(header), off);
+        deserialize_number(chunk.messages, header, sizeof(header), off);
+        deserialize_number(chunk.first, header, sizeof(header), off);
+        deserialize_number(chunk.last, header, sizeof(header), off);
+        if (chunk.size > file_size - pos - bag::CHUNK_HEADER_SIZE) {
+            break;  // Truncated while it was written
+        }
+
+        // Topics are defined by records in the chunks
+        records.resize(chunk.size);
+        if (!read_all(fd_, records.data(), records.size(), pos + bag::CHUNK_HEADER_SIZE)) {
+            break;
+        }
+        off = 0;
+        uint8_t kind;
+        Message record;
+        uint32_t count = 0;
+        while (off < records.size() && read_record(records.data(), records.size(), off, kind, record)) {
+            if (kind == bag::TOPIC && !add_topic(record.topic, record.data, record.len)) {
+                return false;
+            }
+            count++;
+        }
+        if (off != records.size() || count != chunk.records) {
+            break;  // Not a chunk, e.g. an index that was not completed
+        }
+        chunks_.push_back(chunk);
+        pos += bag::CHUNK_HEADER_SIZE + chunk.size;
+    }
+    rix::util::Log::warn << "Bag has no index, read " << chunks_.size() << " chunks." << std::endl;
+    return true;
+}
+
+bool BagReader::add_topic(uint16_t id, const uint8_t *data, size_t len) {
+    if (id >= topics_.size()) {
+        topics_.resize(id + 1);
+    }
+    size_t offset = 0;
+    return topics_[id].deserialize(data, len, offset);
+}
+
+void BagReader::close() {
+    stop();
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    topics_.clear();
+    chunks_.clear();
+    messages_ = 0;
+    current_.clear();
+    offset_ = 0;
+    ready_.clear();
+    free_.clear();
+}
+
+const std::vector<rix::msg::mediator::TopicInfo> &BagReader::topics() const { return topics_; }
+
+const std::vector<bag::Chunk> &BagReader::chunks() const { return chunks_; }
+
+uint64_t BagReader::messages() const { return messages_; }
+
+int64_t BagReader::start_time() const {
+    for (const auto &chunk : chunks_) {
+        if (chunk.messages > 0) return chunk.first;
+    }
+    return 0;
+}
+
+int64_t BagReader::end_time() const {
+    for (auto it = chunks_.rbegin(); it != chunks_.rend(); ++it) {
+        if (it->messages > 0) return it->last;
+    }
+    return 0;
+}
+
+size_t BagReader::seek(int64_t time) const {
+    auto it = std::partition_point(chunks_.begin(), chunks_.end(),
+                                   [time](const bag::Chunk &chunk) { return chunk.messages == 0 || chunk.last < time; });
+    return static_cast<size_t>(it - chunks_.begin());
+}
+
+bool BagReader::start(size_t first, size_t read_ahead) {
+    stop();
+    if (fd_ < 0) {
+        return false;
+    }
+    current_.clear();
+    offset_ = 0;
+    read_ahead_ = std::max<size_t>(read_ahead, 1);
+    stop_ = false;
+    done_ = false;
+    thread_ = std::thread([this, first]() { run(first); });
+    return true;
+}
+
+bool BagReader::next(Message &msg) {
+    while (true) {
+        while (offset_ < current_.size()) {
+            uint8_t kind;
+            if (!read_record(current_.data(), current_.size(), offset_, kind, msg)) {
+                rix::util::Log::warn << "Bag has a malformed record." << std::endl;
+                offset_ = current_.size();
+                break;
+            }
+            if (kind == bag::MESSAGE) {
+                return true;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!current_.empty()) {
+            free_.push_back(std::move(current_));
+            cv_.notify_all();
+        }
+        current_.clear();
+        offset_ = 0;
+        cv_.wait(lock, [this]() { return !ready_.empty() || done_ || !thread_.joinable(); });
+        if (ready_.empty()) {
+            return false;
+        }
+        current_ = std::move(ready_.front());
+        ready_.pop_front();
+    }
+}
+
+void BagReader::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stop_ = true;
+        cv_.notify_all();
+    }
+    thread_.join();
+    while (!ready_.empty()) {
+        free_.push_back(std::move(ready_.front()));
+        ready_.pop_front();
+    }
+}
+
+void BagReader::run(size_t first) {
+    for (size_t i = first; i < chunks_.size(); i++) {
+        std::vector<uint8_t> buffer;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stop_ || ready_.size() < read_ahead_; });
+            if (stop_) {
+                return;
+            }
+            if (!free_.empty()) {
+                buffer = std::move(free_.back());
+                free_.pop_back();
+            }
+        }
+        const auto &chunk = chunks_[i];
+        buffer.resize(chunk.size);
+        bool ok = read_all(fd_, buffer.data(), buffer.size(), chunk.offset + bag::CHUNK_HEADER_SIZE);
+        if (!ok) {
+            rix::util::Log::warn << "Failed to read bag: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        std::lock_guard<std::mutex> guard(mutex_);
+        ready_.push_back(std::move(buffer));
+        cv_.notify_all();
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    done_ = true;
+    cv_.notify_all();
+}
+
+}  // namespace core
+}  // namespace rix
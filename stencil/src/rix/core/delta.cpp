@@ -0,0 +1,103 @@
+#include "rix/core/delta.hpp"
+
+#include <cstring>
+
+namespace rix {
+namespace core {
+
+static void write_varint(rix::msg::Writer &dst, size_t value) {
+    while (value >= 0x80) {
+        *dst.extend(1) = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *dst.extend(1) = static_cast<uint8_t>(value);
+}
+
+static bool read_varint(const uint8_t *src, size_t len, size_t &offset, size_t &value) {
+    value = 0;
+    for (int shift = 0; offset < len && shift < 64; shift += 7) {
+        uint8_t byte = src[offset++];
+        value |= static_cast<size_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+DeltaEncoder::DeltaEncoder(size_t keyframe_interval)
+    : keyframe_interval_(keyframe_interval), since_keyframe_(0), has_previous_(false) {}
+
+void DeltaEncoder::encode(const uint8_t *src, size_t len, rix::msg::Writer &dst) {
+    if (!has_previous_ || previous_.size() != len || since_keyframe_ + 1 >= keyframe_interval_) {
+        *dst.extend(1) = delta_frame::KEYFRAME;
+        dst.append(src, len);
+        previous_.assign(src, src + len);
+        has_previous_ = true;
+        since_keyframe_ = 0;
+        return;
+    }
+
+    *dst.extend(1) = delta_frame::DELTA;
+    const uint8_t *prev = previous_.data();
+    size_t i = 0;
+    while (i < len) {
+        size_t start = i;
+        while (i < len && src[i] == prev[i]) i++;
+        if (i == len) break;
+        size_t zeros = i - start;
+
+        // A changed run ends at two unchanged bytes in a row, since a single
+        // one costs less as a literal than as a new run
+        start = i;
+        while (i < len && (src[i] != prev[i] || (i + 1 < len && src[i + 1] != prev[i + 1]))) i++;
+        write_varint(dst, zeros);
+        write_varint(dst, i - start);
+        uint8_t *out = dst.extend(i - start);
+        for (size_t j = start; j < i; j++) *out++ = src[j] ^ prev[j];
+    }
+    std::memcpy(previous_.data(), src, len);
+    since_keyframe_++;
+}
+
+DeltaDecoder::DeltaDecoder() : has_keyframe_(false) {}
+
+bool DeltaDecoder::decode(const uint8_t *src, size_t len) {
+    if (len == 0) {
+        return false;
+    }
+    if (src[0] == delta_frame::KEYFRAME) {
+        message_.assign(src + 1, src + len);
+        has_keyframe_ = true;
+        return true;
+    }
+    if (src[0] != delta_frame::DELTA || !has_keyframe_) {
+        return false;
+    }
+
+    // The XOR is applied in place, so the previous message must be kept
+    // intact if the frame turns out to be invalid
+    size_t offset = 1;
+    size_t pos = 0;
+    while (offset < len) {
+        size_t zeros, count;
+        if (!read_varint(src, len, offset, zeros) || !read_varint(src, len, offset, count) ||
+            zeros > message_.size() - pos || count > message_.size() - pos - zeros || count > len - offset) {
+            return false;
+        }
+        pos += zeros + count;
+        offset += count;
+    }
+
+    offset = 1;
+    pos = 0;
+    while (offset < len) {
+        size_t zeros, count;
+        read_varint(src, len, offset, zeros);
+        read_varint(src, len, offset, count);
+        pos += zeros;
+        for (size_t j = 0; j < count; j++) message_[pos++] ^= src[offset++];
+    }
+    return true;
+}
+
+}  // namespace core
+}  // namespace rix
@@ -21,9 +21,18 @@ void Mediator::spin_once() {
     auto conn = wconn.lock();
     if (!conn) return;
 
+    // Record every request, however it returns
+    struct Recorder {
+        Mediator &mediator;
+        int64_t start;
+        ~Recorder() { mediator.record_request(start); }
+    } recorder{*this, CallbackStats::now()};
+
     // Read operation header
+    std::array<uint8_t, OPERATION_ARENA_SIZE> arena_buffer;
+    std::pmr::monotonic_buffer_resource arena(arena_buffer.data(), arena_buffer.size());
     rix::msg::mediator::Operation op;
-    std::vector<uint8_t> hdr(op.size());
+    std::pmr::vector<uint8_t> hdr(op.size(), &arena);
     ssize_t hbytes = conn->read(hdr.data(), hdr.size());
     size_t hoff = 0;
 
@@ -34,7 +43,7 @@ void Mediator::spin_once() {
         return;
     }
 
-    std::vector<uint8_t> payload(op.len);
+    std::pmr::vector<uint8_t> payload(op.len, &arena);
     ssize_t pbytes = conn->read(payload.data(), payload.size());
     if (pbytes != static_cast<ssize_t>(payload.size())) {
         rix::msg::mediator::Status status;
@@ -61,11 +70,12 @@ void Mediator::spin_once() {
             break;
         }
 
+        // Deregistrations are read in place, they only need the ID and name
         case OPCODE::NODE_DEREGISTER: {
-            rix::msg::mediator::NodeInfo info;
-            if (info.deserialize(payload.data(), payload.size(), poff)) {
-                nodes_.erase(info.id);
-                rix::util::Log::info << "[rixhub] Deregistered node \"" << info.name << "\"." << std::endl;
+            rix::msg::mediator::NodeInfo::View info;
+            if (info.parse(payload.data(), payload.size(), poff)) {
+                nodes_.erase(info.id());
+                rix::util::Log::info << "[rixhub] Deregistered node \"" << info.name() << "\"." << std::endl;
             }
             break;
         }
@@ -104,11 +114,11 @@ void Mediator::spin_once() {
         }
 
         case OPCODE::PUB_DEREGISTER: {
-            rix::msg::mediator::PubInfo info;
-            if (info.deserialize(payload.data(), payload.size(), poff)) {
-                publishers_.erase(info.id);
+            rix::msg::mediator::PubInfo::View info;
+            if (info.parse(payload.data(), payload.size(), poff)) {
+                publishers_.erase(info.id());
                 rix::util::Log::info << "[rixhub] Deregistered publisher on \""
-                                     << info.topic_info.name << "\"." << std::endl;
+                                     << info.topic_info().name() << "\"." << std::endl;
             }
             break;
         }
@@ -147,11 +157,92 @@ void Mediator::spin_once() {
         }
 
         case OPCODE::SUB_DEREGISTER: {
-            rix::msg::mediator::SubInfo info;
-            if (info.deserialize(payload.data(), payload.size(), poff)) {
-                subscribers_.erase(info.id);
+            rix::msg::mediator::SubInfo::View info;
+            if (info.parse(payload.data(), payload.size(), poff)) {
+                subscribers_.erase(info.id());
                 rix::util::Log::info << "[rixhub] Deregistered subscriber on \""
-                                     << info.topic_info.name << "\"." << std::endl;
+                                     << info.topic_info().name() << "\"." << std::endl;
+            }
+            break;
+        }
+
+        case OPCODE::SRV_REGISTER: {
+            rix::msg::mediator::SrvInfo info;
+            rix::msg::mediator::Status status;
+            status.error = 0;
+            if (!info.deserialize(payload.data(), payload.size(), poff)) {
+                status.error = 1;
+                send_status_message(conn, status);
+                return;
+            }
+            for (const auto &kv : services_) {
+                if (kv.second.name == info.name && kv.first != info.id) {
+                    rix::util::Log::warn << "[rixhub] Reject service (name in use): " << info.name << std::endl;
+                    status.error = 1;
+                    send_status_message(conn, status);
+                    return;
+                }
+            }
+
+            services_[info.id] = info;
+            rix::util::Log::info << "[rixhub] Registered service \"" << info.name << "\"." << std::endl;
+            send_status_message(conn, status);
+            break;
+        }
+
+        case OPCODE::SRV_LOOKUP: {
+            rix::msg::mediator::SrvInfo info;
+            rix::msg::mediator::Status status;
+            status.error = 1;
+            if (!info.deserialize(payload.data(), payload.size(), poff)) {
+                send_status_message(conn, status);
+                return;
+            }
+            auto it = services_.begin();
+            while (it != services_.end() && it->second.name != info.name) it++;
+            if (it == services_.end()) {
+                send_status_message(conn, status);
+                return;
+            }
+            if (it->second.request_hash != info.request_hash || it->second.response_hash != info.response_hash) {
+                rix::util::Log::warn << "[rixhub] Reject service lookup (type mismatch): " << info.name << std::endl;
+                send_status_message(conn, status);
+                return;
+            }
+            send_response_message(conn, it->second);
+            break;
+        }
+
+        case OPCODE::TOPIC_LOOKUP: {
+            rix::msg::mediator::TopicInfo info;
+            rix::msg::mediator::Status status;
+            status.error = 1;
+            if (!info.deserialize(payload.data(), payload.size(), poff)) {
+                send_status_message(conn, status);
+                return;
+            }
+            auto it = topic_hashes_.find(info.name);
+            if (it == topic_hashes_.end()) {
+                send_status_message(conn, status);
+                return;
+            }
+            info.message_hash = it->second;
+            info.encoding = ENCODING::RAW;
+            for (const auto &kv : publishers_) {
+                if (kv.second.topic_info.name == info.name) {
+                    info.encoding = kv.second.topic_info.encoding;
+                    break;
+                }
+            }
+            send_response_message(conn, info);
+            break;
+        }
+
+        case OPCODE::SRV_DEREGISTER: {
+            rix::msg::mediator::SrvInfo::View info;
+            if (info.parse(payload.data(), payload.size(), poff)) {
+                services_.erase(info.id());
+                rix::util::Log::info << "[rixhub] Deregistered service \"" << info.name() << "\"." << std::endl;
             }
             break;
         }
@@ -234,6 +325,55 @@ void Mediator::send_status_message(std::shared_ptr<rix::ipc::interfaces::Connect
     size_t offset = 0;
     status.serialize(buffer.data(), offset);
 
+    ssize_t bytes = conn->write(buffer.data(), buffer.size());
+    if (bytes != buffer.size()) {
+        rix::util::Log::warn << "Failed to write to rixhub." << std::endl;
+    }
+    if (status.error != 0) {
+        failures_.add();
+    }
+}
+
+void Mediator::record_request(int64_t start) {
+    registration_latency_.record(CallbackStats::now() - start);
+    registrations_.add();
+    const size_t sizes[] = {nodes_.size(), publishers_.size(), subscribers_.size(), services_.size(),
+                            topic_hashes_.size()};
+    for (size_t i = 0; i < registry_sizes_.size(); i++) {
+        registry_sizes_[i].store(static_cast<uint32_t>(sizes[i]), std::memory_order_relaxed);
+    }
+}
+
+rix::msg::stats::MediatorStatistics Mediator::stats() const {
+    rix::msg::stats::MediatorStatistics msg;
+    msg.header.stamp = rix::util::Time::now().to_msg();
+    msg.nodes = registry_sizes_[0].load(std::memory_order_relaxed);
+    msg.publishers = registry_sizes_[1].load(std::memory_order_relaxed);
+    msg.subscribers = registry_sizes_[2].load(std::memory_order_relaxed);
+    msg.services = registry_sizes_[3].load(std::memory_order_relaxed);
+    msg.topics = registry_sizes_[4].load(std::memory_order_relaxed);
+    msg.registrations = registrations_.load();
+    msg.failures = failures_.load();
+    auto latency = registration_latency_.snapshot();
+    msg.registration_latency_p50 = latency.percentile(0.5);
+    msg.registration_latency_p99 = latency.percentile(0.99);
+    msg.registration_latency_max = latency.max;
+    return msg;
+}
+
+void Mediator::send_response_message(std::shared_ptr<rix::ipc::interfaces::Connection> conn,
+                                     const rix::msg::Message &msg) {
+    rix::msg::mediator::Status status;
+    status.id = 0;
+    status.error = 0;
+
+    // Serialize in a single pass and fill in the size afterwards
+    rix::msg::Writer buffer;
+    status.serialize(buffer);
+    size_t size = buffer.skip<uint32_t>();
+    msg.serialize(buffer);
+    buffer.patch(size, static_cast<uint32_t>(buffer.size() - size - sizeof(uint32_t)));
+
     ssize_t bytes = conn->write(buffer.data(), buffer.size());
     if (bytes != buffer.size()) {
         rix::util::Log::warn << "Failed to write to rixhub." << std::endl;
@@ -18,25 +18,207 @@ bool Node::ok() const { return !shutdown_flag_; }
 void Node::shutdown() { shutdown_flag_ = true; }
 
 void Node::spin_once() {
-    // Spin all components, remove ones that are not 'ok'
-    auto it = components_.begin();
-    while (it != components_.end()) {
-        auto component = *it;
-        if (!component->ok()) {
-            it = components_.erase(it);
-            continue;
+    rix::util::Trace::Scope trace("Node::spin_once");
+
+    // Remove components that are not 'ok' and spin a copy of the rest, so
+    // that callbacks may create components and other threads may read them
+    {
+        std::lock_guard<std::mutex> guard(components_mutex_);
+        std::erase_if(components_, [](const auto &component) { return !component->ok(); });
+        spinning_.assign(components_.begin(), components_.end());
+    }
+    for (const auto &component : spinning_) {
+        if (component->ok()) {
+            component->spin_once();
+        }
+    }
+    spinning_.clear();
+
+    {
+        std::lock_guard<std::mutex> guard(components_mutex_);
+        for (auto pub = publishers_.begin(); pub != publishers_.end();) {
+            if (auto p = pub->lock()) {
+                p->flush_if_due();
+                ++pub;
+            } else {
+                pub = publishers_.erase(pub);
+            }
         }
-        component->spin_once();
-        it++;
     }
+    if (stats_publisher_ && rix::util::Time::now() - stats_last_ >= stats_period_) {
+        publish_stats();
+    }
+    transport_->spin_once();
+}
+
+std::vector<TopicStats::Snapshot> Node::stats() const {
+    std::vector<TopicStats::Snapshot> result;
+    std::lock_guard<std::mutex> guard(components_mutex_);
+    for (const auto &weak : publishers_) {
+        if (auto pub = weak.lock()) {
+            result.push_back(pub->stats().snapshot(pub->info_.topic_info.name, true));
+        }
+    }
+    for (const auto &weak : subscribers_) {
+        if (auto sub = weak.lock()) {
+            result.push_back(sub->stats().snapshot(sub->info_.topic_info.name, false));
+        }
+    }
+    return result;
+}
+
+std::vector<CallbackStats::Snapshot> Node::callback_stats() const {
+    std::vector<CallbackStats::Snapshot> result;
+    std::lock_guard<std::mutex> guard(components_mutex_);
+    for (const auto &component : components_) {
+        if (auto timer = std::dynamic_pointer_cast<Timer>(component)) {
+            result.push_back(timer->stats().snapshot(CallbackStats::TIMER, "", timer->get_duration().get().count()));
+        } else if (auto sub = std::dynamic_pointer_cast<Subscriber>(component)) {
+            result.push_back(sub->callback_stats().snapshot(CallbackStats::SUBSCRIBER, sub->info_.topic_info.name));
+        } else if (auto srv = std::dynamic_pointer_cast<Service>(component)) {
+            result.push_back(srv->stats().snapshot(CallbackStats::SERVICE, srv->info_.name));
+        }
+    }
+    return result;
+}
+
+bool Node::enable_stats(const rix::util::Duration &period, size_t max_entries) {
+    if (!stats_publisher_) {
+        stats_publisher_ = create_publisher<rix::msg::stats::NodeStatistics>(STATS_TOPIC_PREFIX + info_.name);
+        if (!stats_publisher_ || !stats_publisher_->ok()) {
+            stats_publisher_ = nullptr;
+            return false;
+        }
+        stats_last_ = rix::util::Time::now();
+    }
+    stats_period_ = period;
+    stats_max_entries_ = max_entries;
+    return true;
+}
+
+void Node::publish_stats() {
+    using rix::msg::stats::CallbackStatistics;
+    using rix::msg::stats::TopicStatistics;
+    auto now = rix::util::Time::now();
+    const double elapsed = std::max(1e-9, (now - stats_last_).get().count() * 1e-9);
+    stats_last_ = now;
+
+    auto &msg = stats_message_;
+    msg.header.seq++;
+    msg.header.stamp = now.to_msg();
+    msg.node = info_.name;
+    msg.topics.clear();
+    msg.callbacks.clear();
+
+    // Rates are computed from the counters of the previous report. Entries of
+    // components that no longer exist are dropped.
+    std::map<const TopicStats *, std::array<uint64_t, 2>> previous;
+    previous.swap(stats_previous_);
+    auto add_topic = [&](const std::string &topic, bool publisher, const TopicStats &stats, size_t connections,
+                         size_t queued_bytes) {
+        if (msg.topics.size() >= stats_max_entries_) return;
+        TopicStatistics t;
+        t.topic = topic;
+        t.publisher = publisher;
+        t.connections = static_cast<uint32_t>(connections);
+        t.messages = stats.messages.load();
+        t.bytes = stats.bytes.load();
+        t.drops = stats.drops.load();
+        t.write_failures = stats.write_failures.load();
+        t.lost = stats.lost.load();
+        t.duplicates = stats.duplicates.load();
+        t.reordered = stats.reordered.load();
+        t.queued_bytes = queued_bytes;
+        auto it = previous.find(&stats);
+        std::array<uint64_t, 2> last = it != previous.end() ? it->second : std::array<uint64_t, 2>{0, 0};
+        t.message_rate = static_cast<float>((t.messages - last[0]) / elapsed);
+        t.byte_rate = static_cast<float>((t.bytes - last[1]) / elapsed);
+        stats_previous_[&stats] = {t.messages, t.bytes};
+        auto latency = stats.latency.snapshot();
+        t.latency_p50 = latency.percentile(0.5);
+        t.latency_p99 = latency.percentile(0.99);
+        t.latency_max = latency.max;
+        auto delivery = stats.delivery.snapshot();
+        t.delivery_p50 = delivery.percentile(0.5);
+        t.delivery_p99 = delivery.percentile(0.99);
+        auto queueing = stats.queueing.snapshot();
+        t.queueing_p50 = queueing.percentile(0.5);
+        t.queueing_p99 = queueing.percentile(0.99);
+        msg.topics.push_back(std::move(t));
+    };
+    {
+        std::lock_guard<std::mutex> guard(components_mutex_);
+        for (const auto &weak : publishers_) {
+            auto pub = weak.lock();
+            if (pub && pub != stats_publisher_) {
+                add_topic(pub->info_.topic_info.name, true, pub->stats(), pub->get_subscriber_count(),
+                          pub->get_queued_bytes());
+            }
+        }
+        for (const auto &weak : subscribers_) {
+            if (auto sub = weak.lock()) {
+                add_topic(sub->info_.topic_info.name, false, sub->stats(), sub->get_publisher_count(),
+                          sub->get_queued_bytes());
+            }
+        }
+    }
+
+    for (const auto &cb : callback_stats()) {
+        if (msg.callbacks.size() >= stats_max_entries_) break;
+        CallbackStatistics c;
+        c.kind = cb.kind;
+        c.name = cb.name;
+        c.nominal_period = static_cast<uint64_t>(cb.nominal_period);
+        c.calls = cb.execution.count;
+        c.overruns = cb.overruns;
+        c.execution_mean = cb.execution.mean();
+        c.execution_p99 = cb.execution.percentile(0.99);
+        c.execution_max = cb.execution.max;
+        c.period_mean = cb.period.mean();
+        c.jitter_p99 = cb.jitter.percentile(0.99);
+        msg.callbacks.push_back(std::move(c));
+    }
+
+    stats_publisher_->publish(msg);
+}
+
+void Node::set_encoding(const std::string &topic, ENCODING encoding) { encodings_[topic] = encoding; }
+
+std::shared_ptr<Transport> Node::enable_multiplexing(const rix::ipc::Endpoint &endpoint) {
+    if (transport_->is_multiplexing()) {
+        return transport_;
+    }
+    auto server = server_factory_ ? server_factory_(endpoint) : nullptr;
+    if (!server || !transport_->listen(server)) {
+        rix::util::Log::error << "Failed to create transport server on " << endpoint.to_string() << std::endl;
+        return nullptr;
+    }
+    return transport_;
 }
 
 std::shared_ptr<Timer> Node::create_timer(const rix::util::Duration &d, Timer::Callback callback) {
     auto timer = std::make_shared<rix::core::Timer>(d, callback);
+    std::lock_guard<std::mutex> guard(components_mutex_);
     components_.push_back(timer);
     return timer;
 }
 
+std::shared_ptr<PoseBuffer> Node::create_pose_buffer(const std::string &topic, size_t capacity,
+                                                     const rix::ipc::Endpoint &endpoint) {
+    auto buffer = std::make_shared<PoseBuffer>(capacity);
+    std::weak_ptr<PoseBuffer> weak = buffer;
+    buffer->subscriber_ = create_subscriber<rix::msg::geometry::Pose2DStamped>(
+        topic,
+        [weak](const rix::msg::geometry::Pose2DStamped &msg) {
+            if (auto b = weak.lock()) b->insert(msg);
+        },
+        endpoint);
+    if (!buffer->subscriber_ || !buffer->subscriber_->ok()) {
+        return nullptr;
+    }
+    return buffer;
+}
+
 uint64_t Node::generate_id() {
     static std::random_device rd;
     static std::mt19937_64 gen(rd());
@@ -47,6 +229,23 @@ uint64_t Node::generate_id() {
 /**< TODO: Implement the create_publisher method */
 std::shared_ptr<Publisher> Node::create_publisher(const rix::msg::mediator::TopicInfo &topic_info,
                                                   const rix::ipc::Endpoint &endpoint) {
+    if (transport_->is_multiplexing()) {
+        rix::msg::mediator::PubInfo info;
+        info.id = generate_id();
+        info.node_id = info_.id;
+        info.protocol = PROTOCOL::TCP_MUX;
+        info.topic_info = topic_info;
+        rix::ipc::Endpoint bound = transport_->local_endpoint();
+        info.endpoint.address = bound.address;
+        info.endpoint.port = bound.port;
+
+        std::shared_ptr<Publisher> pub(new Publisher(info, nullptr, client_factory_, rixhub_endpoint_, transport_));
+        std::lock_guard<std::mutex> guard(components_mutex_);
+        components_.push_back(std::static_pointer_cast<interfaces::Spinner>(pub));
+        publishers_.push_back(pub);
+        return pub;
+    }
+
     auto server = server_factory_ ? server_factory_(endpoint) : nullptr;
     if (!server || !server->ok()) {
         rix::util::Log::error << "Failed to create publisher server on " << endpoint.to_string() << std::endl;
@@ -55,12 +254,16 @@ std::shared_ptr<Publisher> Node::create_publisher(const rix::msg::mediator::Topi
 
     rix::msg::mediator::PubInfo info;
     info.id = generate_id();
+    info.node_id = info_.id;
+    info.protocol = PROTOCOL::TCP;
     info.topic_info = topic_info;
 
     {
+        // Register the bound endpoint so that subscribers can reach ephemeral ports
+        rix::ipc::Endpoint bound = server->local_endpoint();
         rix::msg::mediator::Endpoint ep_msg;
-        ep_msg.address = endpoint.address;
-        ep_msg.port    = endpoint.port;
+        ep_msg.address = bound.address;
+        ep_msg.port    = bound.port;
         info.endpoint  = ep_msg;
     }
     
@@ -70,8 +273,9 @@ std::shared_ptr<Publisher> Node::create_publisher(const rix::msg::mediator::Topi
     }
 
     {
-        //std::lock_guard<std::mutex> guard(components_mutex_);
+        std::lock_guard<std::mutex> guard(components_mutex_);
         components_.push_back(std::static_pointer_cast<rix::core::interfaces::Spinner>(pub));
+        publishers_.push_back(pub);
     }
 
     return pub;
@@ -88,28 +292,95 @@ std::shared_ptr<Subscriber> Node::create_subscriber(const rix::msg::mediator::To
 
     rix::msg::mediator::SubInfo info;
     info.id = generate_id();
+    info.node_id = info_.id;
+    info.protocol = PROTOCOL::TCP;
     info.topic_info = topic_info;
 
     {
+        // Register the bound endpoint so that rixhub can reach ephemeral ports
+        rix::ipc::Endpoint bound = server->local_endpoint();
         rix::msg::mediator::Endpoint ep_msg;
-        ep_msg.address = endpoint.address;
-        ep_msg.port    = endpoint.port;
+        ep_msg.address = bound.address;
+        ep_msg.port    = bound.port;
         info.endpoint  = ep_msg;
     }
 
-    std::shared_ptr<rix::core::Subscriber> sub(new rix::core::Subscriber(info, server, client_factory_, rixhub_endpoint_));
+    std::shared_ptr<rix::core::Subscriber> sub(new rix::core::Subscriber(info, server, client_factory_, rixhub_endpoint_, transport_));
     if (!sub) {
         return nullptr;
     }
 
     {
-        //std::lock_guard<std::mutex> guard(components_mutex_);
+        std::lock_guard<std::mutex> guard(components_mutex_);
         components_.push_back(std::static_pointer_cast<rix::core::interfaces::Spinner>(sub));
+        std::erase_if(subscribers_, [](const std::weak_ptr<Subscriber> &s) { return s.expired(); });
+        subscribers_.push_back(sub);
     }
 
     return sub;
 }
 
+std::shared_ptr<Subscriber> Node::create_subscriber(const rix::msg::mediator::TopicInfo &topic_info,
+                                                    Subscriber::SerializedCallback callback,
+                                                    const rix::ipc::Endpoint &endpoint) {
+    auto sub = create_subscriber(topic_info, endpoint);
+    if (sub) {
+        sub->set_serialized_callback(callback);
+    }
+    return sub;
+}
+
+std::shared_ptr<Publisher> Node::create_serialized_publisher(const rix::msg::mediator::TopicInfo &topic_info,
+                                                             const rix::ipc::Endpoint &endpoint) {
+    return create_publisher(topic_info, endpoint);
+}
+
+bool Node::lookup_topic(const std::string &topic, rix::msg::mediator::TopicInfo &info) {
+    if (!client_factory_) {
+        return false;
+    }
+    rix::msg::mediator::TopicInfo request;
+    request.name = topic;
+    return request_message_with_opcode(client_factory_(), request, OPCODE::TOPIC_LOOKUP, rixhub_endpoint_, info);
+}
+
+std::shared_ptr<Service> Node::create_service(const rix::msg::mediator::SrvInfo &srv_info,
+                                              const rix::ipc::Endpoint &endpoint) {
+    auto server = server_factory_ ? server_factory_(endpoint) : nullptr;
+    if (!server || !server->ok()) {
+        rix::util::Log::error << "Failed to create service server on " << endpoint.to_string() << std::endl;
+        return nullptr;
+    }
+
+    rix::msg::mediator::SrvInfo info = srv_info;
+    info.id = generate_id();
+    info.node_id = info_.id;
+    info.protocol = PROTOCOL::TCP;
+    {
+        // Register the bound endpoint so that clients can reach ephemeral ports
+        rix::ipc::Endpoint bound = server->local_endpoint();
+        info.endpoint.address = bound.address;
+        info.endpoint.port = bound.port;
+    }
+
+    std::shared_ptr<Service> srv(new Service(info, server, client_factory_, rixhub_endpoint_));
+    std::lock_guard<std::mutex> guard(components_mutex_);
+    components_.push_back(std::static_pointer_cast<interfaces::Spinner>(srv));
+    return srv;
+}
+
+std::shared_ptr<ServiceClient> Node::create_client(const rix::msg::mediator::SrvInfo &srv_info) {
+    rix::msg::mediator::SrvInfo info = srv_info;
+    info.id = generate_id();
+    info.node_id = info_.id;
+    info.protocol = PROTOCOL::TCP;
+
+    std::shared_ptr<ServiceClient> client(new ServiceClient(info, client_factory_, rixhub_endpoint_));
+    std::lock_guard<std::mutex> guard(components_mutex_);
+    components_.push_back(std::static_pointer_cast<interfaces::Spinner>(client));
+    return client;
+}
+
 Node::Node(const std::string &name, const rix::ipc::Endpoint &rixhub_endpoint, ServerFactory server_factory,
            ClientFactory client_factory)
     : rixhub_endpoint_(rixhub_endpoint),
@@ -118,6 +389,7 @@ Node::Node(const std::string &name, const rix::ipc::Endpoint &rixhub_endpoint, S
       shutdown_flag_(false) {
     info_.id = generate_id();
     info_.name = name;
+    transport_ = std::shared_ptr<Transport>(new Transport(info_.id, client_factory_));
 
     /**< TODO: Deregister the node with the mediator */
     if (client_factory_) {
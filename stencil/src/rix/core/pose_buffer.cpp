@@ -0,0 +1,153 @@
+#include "rix/core/pose_buffer.hpp"
+
+namespace rix {
+namespace core {
+
+static int64_t to_nanoseconds(const rix::msg::standard::Time &t) {
+    return static_cast<int64_t>(t.sec) * 1'000'000'000LL + t.nsec;
+}
+
+PoseBuffer::PoseBuffer(size_t capacity)
+    : entries_(capacity > 0 ? capacity : 1), head_(0), size_(0), sequence_(0) {}
+
+PoseBuffer::~PoseBuffer() {
+    if (subscriber_) subscriber_->shutdown();
+}
+
+size_t PoseBuffer::size() const { return size_.load(std::memory_order_relaxed); }
+
+size_t PoseBuffer::capacity() const { return entries_.size(); }
+
+void PoseBuffer::copy(Entry &dst, const Entry &src) {
+    dst.stamp.store(src.stamp.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    dst.x.store(src.x.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    dst.y.store(src.y.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    dst.theta.store(src.theta.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+bool PoseBuffer::insert(const rix::msg::geometry::Pose2DStamped &msg) {
+    const int64_t stamp = to_nanoseconds(msg.header.stamp);
+    const size_t cap = entries_.size();
+    const size_t n = size_.load(std::memory_order_relaxed);
+
+    // Only the writer modifies the buffer, so it may read without the sequence
+    // check. For in-order streams this loop does not iterate.
+    size_t pos = n;
+    while (pos > 0 && at(pos - 1).stamp.load(std::memory_order_relaxed) > stamp) pos--;
+    const bool replace = pos > 0 && at(pos - 1).stamp.load(std::memory_order_relaxed) == stamp;
+    if (!replace && pos == 0 && n == cap) {
+        return false;  // Older than the entire window
+    }
+
+    // Begin write (sequence becomes odd)
+    const uint64_t seq = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Entry *slot;
+    if (replace) {
+        slot = &at(pos - 1);
+    } else if (pos == n && n < cap) {
+        slot = &at(n);
+        size_.store(n + 1, std::memory_order_relaxed);
+    } else if (pos == n) {
+        // Full and appending: overwrite the oldest entry
+        slot = &at(0);
+        head_.store((head_.load(std::memory_order_relaxed) + 1) % cap, std::memory_order_relaxed);
+    } else if (n < cap) {
+        // Out of order: shift newer entries towards the back
+        for (size_t i = n; i > pos; i--) copy(at(i), at(i - 1));
+        slot = &at(pos);
+        size_.store(n + 1, std::memory_order_relaxed);
+    } else {
+        // Out of order and full: shift older entries towards the front,
+        // discarding the oldest
+        for (size_t i = 0; i + 1 < pos; i++) copy(at(i), at(i + 1));
+        slot = &at(pos - 1);
+    }
+    slot->stamp.store(stamp, std::memory_order_relaxed);
+    slot->x.store(msg.pose.x, std::memory_order_relaxed);
+    slot->y.store(msg.pose.y, std::memory_order_relaxed);
+    slot->theta.store(msg.pose.theta, std::memory_order_relaxed);
+
+    // End write (sequence becomes even)
+    sequence_.store(seq + 2, std::memory_order_release);
+    return true;
+}
+
+bool PoseBuffer::lookup(const rix::util::Time &t, rix::msg::geometry::Pose2D &pose) const {
+    const int64_t query = t.to_nanoseconds();
+    while (true) {
+        const uint64_t seq = sequence_.load(std::memory_order_acquire);
+        if (seq & 1) continue;  // Write in progress
+
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t n = size_.load(std::memory_order_relaxed);
+        bool found = false;
+        rix::msg::geometry::Pose2D result;
+        if (n > 0 && query >= at(0, head).stamp.load(std::memory_order_relaxed) &&
+            query <= at(n - 1, head).stamp.load(std::memory_order_relaxed)) {
+            // Binary search for the first entry with stamp >= query
+            size_t lo = 0, hi = n - 1;
+            while (lo < hi) {
+                size_t mid = lo + (hi - lo) / 2;
+                if (at(mid, head).stamp.load(std::memory_order_relaxed) < query) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+
+            const Entry &e1 = at(lo, head);
+            const int64_t t1 = e1.stamp.load(std::memory_order_relaxed);
+            rix::msg::geometry::Pose2D p1;
+            p1.x = e1.x.load(std::memory_order_relaxed);
+            p1.y = e1.y.load(std::memory_order_relaxed);
+            p1.theta = e1.theta.load(std::memory_order_relaxed);
+            if (t1 == query || lo == 0) {
+                result = p1;
+            } else {
+                const Entry &e0 = at(lo - 1, head);
+                const int64_t t0 = e0.stamp.load(std::memory_order_relaxed);
+                rix::msg::geometry::Pose2D p0;
+                p0.x = e0.x.load(std::memory_order_relaxed);
+                p0.y = e0.y.load(std::memory_order_relaxed);
+                p0.theta = e0.theta.load(std::memory_order_relaxed);
+                result = interpolate(p0, p1, static_cast<double>(query - t0) / static_cast<double>(t1 - t0));
+            }
+            found = true;
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) == seq) {
+            if (found) pose = result;
+            return found;
+        }
+    }
+}
+
+bool PoseBuffer::window(rix::util::Time &oldest, rix::util::Time &newest) const {
+    while (true) {
+        const uint64_t seq = sequence_.load(std::memory_order_acquire);
+        if (seq & 1) continue;
+
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t n = size_.load(std::memory_order_relaxed);
+        int64_t first = 0, last = 0;
+        if (n > 0) {
+            first = at(0, head).stamp.load(std::memory_order_relaxed);
+            last = at(n - 1, head).stamp.load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) == seq) {
+            if (n == 0) return false;
+            oldest = rix::util::Time(rix::util::Time::Type(std::chrono::nanoseconds(first)));
+            newest = rix::util::Time(rix::util::Time::Type(std::chrono::nanoseconds(last)));
+            return true;
+        }
+    }
+}
+
+}  // namespace core
+}  // namespace rix
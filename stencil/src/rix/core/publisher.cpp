@@ -3,11 +3,46 @@
 namespace rix {
 namespace core {
 
+/**
+ * @brief A message that is already serialized, see publish_serialized.
+ *
+ */
+class SerializedMessage : public rix::msg::Message {
+   public:
+    SerializedMessage(const std::array<uint64_t, 2> &hash, const uint8_t *data, size_t len)
+        : hash_(hash), data_(data), len_(len) {}
+
+    size_t size() const override { return len_; }
+    std::array<uint64_t, 2> hash() const override { return hash_; }
+    void serialize(uint8_t *dst, size_t &offset) const override {
+        std::memcpy(dst + offset, data_, len_);
+        offset += len_;
+    }
+    bool deserialize(const uint8_t *, size_t, size_t &) override { return false; }
+    void serialize(rix::msg::Writer &dst) const override { dst.append(data_, len_); }
+
+   private:
+    std::array<uint64_t, 2> hash_;
+    const uint8_t *data_;
+    size_t len_;
+};
+
 Publisher::Publisher(const rix::msg::mediator::PubInfo &info, std::shared_ptr<rix::ipc::interfaces::Server> server,
-                     ClientFactory factory, rix::ipc::Endpoint rixhub_endpoint)
-    : info_(info), server_(server), shutdown_flag_(false), factory_(factory), rixhub_endpoint_(rixhub_endpoint) {
-    // Ensure server was intitialized properly
-    if (!server_->ok()) {
+                     ClientFactory factory, rix::ipc::Endpoint rixhub_endpoint, std::shared_ptr<Transport> transport)
+    : info_(info),
+      server_(server),
+      transport_(transport),
+      batch_bytes_(0),
+      batch_latency_(0.0),
+      batch_pending_(false),
+      shutdown_flag_(false),
+      factory_(factory),
+      rixhub_endpoint_(rixhub_endpoint) {
+    if (transport_) {
+        // Subscriptions may arrive as soon as the publisher is registered
+        transport_->advertise(info_.id, info_.topic_info.encoding == ENCODING::DELTA);
+    } else if (!server_ || !server_->ok()) {
+        // Ensure server was intitialized properly
         rix::util::Log::error << "Server invalid!" << std::endl;
         shutdown();
         return;
@@ -28,7 +63,11 @@ Publisher::Publisher(const rix::msg::mediator::PubInfo &info, std::shared_ptr<ri
 }
 
 Publisher::~Publisher() {
+    flush();
     shutdown();
+    if (transport_) {
+        transport_->unadvertise(info_.id);
+    }
     /**< TODO: Deregister the publisher with the mediator */
     if (factory_) {
         auto client = factory_();
@@ -45,46 +84,233 @@ void Publisher::publish(const rix::msg::Message &msg) {
     if (shutdown_flag_.load()) {
         return;
     }
-    
-    rix::msg::standard::UInt32 size_prefix;
-    size_prefix.data = static_cast<uint32_t>(msg.size());
-    std::vector<uint8_t> buffer(size_prefix.size() + msg.size());
-    size_t offset = 0;
-    size_prefix.serialize(buffer.data(), offset);
-    msg.serialize(buffer.data(), offset);
+    rix::util::Trace::Scope trace("Publisher::publish", info_.topic_info.name);
+    if (transport_) {
+        transport_->send(info_.id, msg, encoder_, &stats_);
+        return;
+    }
 
     std::lock_guard<std::mutex> guard(connections_mutex_);
+    serialize_locked(msg);
+    stats_.messages.add();
+
+    if (batch_bytes_ > 0) {
+        // Append the frame to every buffer and write the ones that are full
+        for (auto &kv : connections_) {
+            const auto &frame = frame_for(kv.second);
+            kv.second.batch.insert(kv.second.batch.end(), frame.data(), frame.data() + frame.size());
+            kv.second.frames++;
+        }
+        batch_locked();
+        return;
+    }
+
     for (auto it = connections_.begin(); it != connections_.end();) {
-        auto conn = it->lock();
+        auto conn = it->first.lock();
         if (!conn) {
             it = connections_.erase(it);
             continue;
         }
 
-        ssize_t bytes = conn->write(buffer.data(), buffer.size());
-        if (bytes != static_cast<ssize_t>(buffer.size())) {
+        const auto &frame = frame_for(it->second);
+        ssize_t bytes;
+        {
+            rix::util::Trace::Scope trace("Publisher::write", info_.topic_info.name);
+            bytes = conn->write(frame.data(), frame.size());
+        }
+        if (bytes != static_cast<ssize_t>(frame.size())) {
             rix::util::Log::warn << "Publisher failed to write full message; dropping connection." << std::endl;
+            stats_.write_failures.add();
+            stats_.drops.add();
             it = connections_.erase(it);
             continue;
         }
+        stats_.bytes.add(frame.size());
 
         ++it;
     }
 }
 
+void Publisher::publish_serialized(const uint8_t *data, size_t len) {
+    publish(SerializedMessage(info_.topic_info.message_hash, data, len));
+}
+
+void Publisher::publish_batch(size_t count, const std::function<const rix::msg::Message &(size_t)> &at) {
+    if (shutdown_flag_.load() || count == 0) {
+        return;
+    }
+    rix::util::Trace::Scope trace("Publisher::publish_batch", info_.topic_info.name);
+    if (transport_) {
+        // The Transport already writes everything queued in a spin at once
+        for (size_t i = 0; i < count; i++) {
+            transport_->send(info_.id, at(i), encoder_, &stats_);
+        }
+        return;
+    }
+
+    // Stage all frames in the buffer of every connection, then write each
+    // buffer once, unless batching defers the write
+    std::lock_guard<std::mutex> guard(connections_mutex_);
+    for (size_t i = 0; i < count; i++) {
+        serialize_locked(at(i));
+        stats_.messages.add();
+        for (auto &kv : connections_) {
+            const auto &frame = frame_for(kv.second);
+            kv.second.batch.insert(kv.second.batch.end(), frame.data(), frame.data() + frame.size());
+            kv.second.frames++;
+        }
+    }
+    if (batch_bytes_ > 0) {
+        batch_locked();
+    } else {
+        flush_locked();
+    }
+}
+
+void Publisher::serialize_locked(const rix::msg::Message &msg) {
+    // Serialize in a single pass and fill in the size prefix afterwards
+    frame_.clear();
+    size_t prefix = frame_.skip<uint32_t>();
+    frame_.patch(frame_.skip<uint32_t>(), sequence_++);
+    uint32_t flags = 0;
+    if (timestamping_) {
+        flags = data_frame::TIMESTAMPED;
+        frame_.patch(frame_.skip<int64_t>(), CallbackStats::now());
+    }
+    if (encoder_) {
+        encoder_(msg, frame_);
+    } else {
+        msg.serialize(frame_);
+    }
+    frame_.patch(prefix, static_cast<uint32_t>(frame_.size() - header_size()) | flags);
+}
+
+size_t Publisher::header_size() const {
+    return data_frame::HEADER_SIZE + (timestamping_ ? data_frame::TIMESTAMP_SIZE : 0);
+}
+
+const rix::msg::Writer &Publisher::frame_for(ConnectionState &state) {
+    // With the DELTA encoding, every connection sends its own frame, encoded
+    // against the previous message sent on it
+    if (info_.topic_info.encoding != ENCODING::DELTA) {
+        return frame_;
+    }
+    delta_frame_.clear();
+    size_t prefix = delta_frame_.skip<uint32_t>();
+    const size_t header = header_size();
+    delta_frame_.append(frame_.data() + sizeof(uint32_t), header - sizeof(uint32_t));  // Sequence number and time
+    state.delta.encode(frame_.data() + header, frame_.size() - header, delta_frame_);
+    uint32_t flags = timestamping_ ? data_frame::TIMESTAMPED : 0;
+    delta_frame_.patch(prefix, static_cast<uint32_t>(delta_frame_.size() - header) | flags);
+    return delta_frame_;
+}
+
+void Publisher::batch_locked() {
+    for (const auto &kv : connections_) {
+        if (kv.second.batch.size() >= batch_bytes_) {
+            flush_locked();
+            return;
+        }
+    }
+
+    // A zero latency defers the write to the end of the spin iteration
+    auto now = rix::util::Time::now();
+    if (!batch_pending_) {
+        batch_pending_ = true;
+        batch_start_ = now;
+    } else if (batch_latency_ > rix::util::Duration(0.0) && now - batch_start_ >= batch_latency_) {
+        flush_locked();
+    }
+}
+
+void Publisher::set_batching(size_t max_bytes, const rix::util::Duration &max_latency) {
+    std::lock_guard<std::mutex> guard(connections_mutex_);
+    flush_locked();
+    batch_bytes_ = max_bytes;
+    batch_latency_ = max_latency;
+}
+
+void Publisher::set_timestamping(bool enabled) {
+    std::lock_guard<std::mutex> guard(connections_mutex_);
+    timestamping_ = enabled;
+}
+
+void Publisher::flush() {
+    std::lock_guard<std::mutex> guard(connections_mutex_);
+    flush_locked();
+}
+
+void Publisher::flush_if_due() {
+    std::lock_guard<std::mutex> guard(connections_mutex_);
+    if (batch_pending_ && rix::util::Time::now() - batch_start_ >= batch_latency_) {
+        flush_locked();
+    }
+}
+
+void Publisher::flush_locked() {
+    batch_pending_ = false;
+    for (auto it = connections_.begin(); it != connections_.end();) {
+        auto &buffer = it->second.batch;
+        if (buffer.empty()) {
+            ++it;
+            continue;
+        }
+        auto conn = it->first.lock();
+        if (!conn) {
+            it = connections_.erase(it);
+            continue;
+        }
+
+        ssize_t bytes;
+        {
+            rix::util::Trace::Scope trace("Publisher::write", info_.topic_info.name);
+            bytes = conn->write(buffer.data(), buffer.size());
+        }
+        if (bytes != static_cast<ssize_t>(buffer.size())) {
+            rix::util::Log::warn << "Publisher failed to write full batch; dropping connection." << std::endl;
+            stats_.write_failures.add();
+            stats_.drops.add(it->second.frames);
+            it = connections_.erase(it);
+            continue;
+        }
+        stats_.bytes.add(buffer.size());
+        buffer.clear();
+        it->second.frames = 0;
+        ++it;
+    }
+}
+
 size_t Publisher::get_subscriber_count() const {
+    if (transport_) {
+        return transport_->get_subscriber_count(info_.id);
+    }
     std::lock_guard<std::mutex> guard(connections_mutex_);
     return connections_.size();
 }
 
+const TopicStats &Publisher::stats() const { return stats_; }
+
+size_t Publisher::get_queued_bytes() const {
+    std::lock_guard<std::mutex> guard(connections_mutex_);
+    size_t bytes = 0;
+    for (const auto &kv : connections_) bytes += kv.second.batch.size();
+    return bytes;
+}
+
 /**< TODO: Implement the spin_once method */
 void Publisher::spin_once() {
+    // Multiplexed publishers are served by the Node's Transport
+    if (!server_) {
+        return;
+    }
+
     // Check to see if a subscriber has made a connection
     if (!server_->wait_for_accept(rix::util::Duration(0.0))) {
         return;
     }
 
     // Accept a connection from a subscriber
+    rix::util::Trace::Scope trace("Publisher::accept", info_.topic_info.name);
     std::weak_ptr<rix::ipc::interfaces::Connection> conn;
     if (!server_->accept(conn)) {
         return;
@@ -92,7 +318,7 @@ void Publisher::spin_once() {
 
     // Store the connection
     std::lock_guard<std::mutex> guard(connections_mutex_);
-    connections_.insert(conn);
+    connections_[conn];
 }
 
 }  // namespace core
@@ -0,0 +1,158 @@
+#include "rix/core/service.hpp"
+
+#include <cerrno>
+
+namespace rix {
+namespace core {
+
+Service::Service(const rix::msg::mediator::SrvInfo &info, std::shared_ptr<rix::ipc::interfaces::Server> server,
+                 ClientFactory factory, const rix::ipc::Endpoint &rixhub_endpoint)
+    : info_(info),
+      server_(server),
+      chunk_(65536),
+      handler_(nullptr),
+      factory_(factory),
+      rixhub_endpoint_(rixhub_endpoint),
+      shutdown_flag_(false) {
+    // Ensure server was intitialized properly
+    if (!server_->ok()) {
+        rix::util::Log::error << "Server invalid!" << std::endl;
+        shutdown();
+        return;
+    }
+
+    bool registered = true;
+    if (factory_) {
+        auto client = factory_();
+        registered = send_message_with_opcode(client, info_, OPCODE::SRV_REGISTER, rixhub_endpoint_);
+    }
+    if (!registered) {
+        rix::util::Log::warn << "Failed to register service with rixhub." << std::endl;
+        shutdown();
+        return;
+    }
+}
+
+Service::~Service() {
+    shutdown();
+    if (factory_) {
+        auto client = factory_();
+        (void)send_message_with_opcode_no_response(client, info_, OPCODE::SRV_DEREGISTER, rixhub_endpoint_);
+    }
+}
+
+bool Service::ok() const { return !shutdown_flag_; }
+
+void Service::shutdown() { shutdown_flag_ = true; }
+
+size_t Service::get_client_count() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return sessions_.size();
+}
+
+const CallbackStats &Service::stats() const { return stats_; }
+
+void Service::handle_requests(Session &session, const SerializedHandler &handler) {
+    using namespace rix::msg::detail;
+    size_t pos = 0;
+    while (session.rx.size() - pos >= service_frame::REQUEST_HEADER_SIZE) {
+        uint32_t len, id;
+        size_t offset = pos;
+        deserialize_number(len, session.rx.data(), session.rx.size(), offset);
+        deserialize_number(id, session.rx.data(), session.rx.size(), offset);
+        if (session.rx.size() - offset < len) {
+            break;  // Incomplete request
+        }
+
+        // Reserve the response header and let the handler append the body
+        size_t header = session.tx.size();
+        session.tx.resize(header + service_frame::RESPONSE_HEADER_SIZE);
+        uint8_t status = 1;
+        const int64_t start = CallbackStats::now();
+        if (handler && handler(session.rx.data() + offset, len, session.tx)) {
+            status = 0;
+        } else {
+            session.tx.resize(header + service_frame::RESPONSE_HEADER_SIZE);
+        }
+        if (handler) {
+            stats_.record(start, CallbackStats::now());
+        }
+        uint32_t res_len = static_cast<uint32_t>(session.tx.size() - header - service_frame::RESPONSE_HEADER_SIZE);
+        size_t hoff = 0;
+        uint8_t *dst = session.tx.data() + header;
+        serialize_number(dst, hoff, res_len);
+        serialize_number(dst, hoff, id);
+        serialize_number(dst, hoff, status);
+
+        pos = offset + len;
+    }
+    session.rx.erase(session.rx.begin(), session.rx.begin() + pos);
+}
+
+void Service::spin_once() {
+    if (shutdown_flag_.load()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    // Accept new clients
+    while (server_->wait_for_accept(rix::util::Duration(0.0))) {
+        std::weak_ptr<rix::ipc::interfaces::Connection> conn;
+        if (!server_->accept(conn)) {
+            break;
+        }
+        if (auto c = conn.lock()) {
+            c->set_nonblocking(true);
+            sessions_.push_back(Session{conn, {}, {}});
+        }
+    }
+
+    for (auto it = sessions_.begin(); it != sessions_.end();) {
+        auto conn = it->connection.lock();
+        if (!conn) {
+            it = sessions_.erase(it);
+            continue;
+        }
+
+        // Read everything that is available. A readable connection that
+        // returns no data has been closed by the client.
+        bool closed = false;
+        for (int i = 0; i < 16 && conn->is_readable(); i++) {
+            ssize_t bytes = conn->read(chunk_.data(), chunk_.size());
+            if (bytes <= 0) {
+                closed = true;
+                break;
+            }
+            it->rx.insert(it->rx.end(), chunk_.begin(), chunk_.begin() + bytes);
+            if (static_cast<size_t>(bytes) < chunk_.size()) break;
+        }
+
+        handle_requests(*it, handler_);
+
+        // Write all responses at once, keeping whatever the socket did not
+        // accept. A full socket buffer is retried on the next spin.
+        if (!closed && !it->tx.empty()) {
+            errno = 0;
+            ssize_t bytes = conn->write(it->tx.data(), it->tx.size());
+            if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                bytes = 0;
+            }
+            if (bytes < 0) {
+                closed = true;
+            } else {
+                it->tx.consume(bytes);
+            }
+        }
+
+        if (closed) {
+            server_->close(it->connection);
+            it = sessions_.erase(it);
+            continue;
+        }
+        ++it;
+    }
+}
+
+}  // namespace core
+}  // namespace rix
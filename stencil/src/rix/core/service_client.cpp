@@ -0,0 +1,191 @@
+#include "rix/core/service_client.hpp"
+
+#include <cerrno>
+
+namespace rix {
+namespace core {
+
+ServiceClient::ServiceClient(const rix::msg::mediator::SrvInfo &info, ClientFactory factory,
+                             const rix::ipc::Endpoint &rixhub_endpoint)
+    : info_(info),
+      factory_(factory),
+      rixhub_endpoint_(rixhub_endpoint),
+      client_(nullptr),
+      last_lookup_(0.0),
+      connect_start_(0.0),
+      chunk_(65536),
+      next_id_(1),
+      shutdown_flag_(false) {
+    if (!factory_) {
+        rix::util::Log::error << "Service client requires a client factory." << std::endl;
+        shutdown();
+        return;
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    poll(rix::util::Duration(0.0));
+}
+
+ServiceClient::~ServiceClient() { shutdown(); }
+
+bool ServiceClient::ok() const { return !shutdown_flag_; }
+
+void ServiceClient::shutdown() {
+    shutdown_flag_ = true;
+    std::lock_guard<std::mutex> guard(mutex_);
+    disconnect();
+}
+
+bool ServiceClient::is_connected() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return client_ && client_->is_connected();
+}
+
+size_t ServiceClient::get_pending_count() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return pending_.size();
+}
+
+void ServiceClient::spin_once() {
+    if (shutdown_flag_.load()) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    poll(rix::util::Duration(0.0));
+}
+
+size_t ServiceClient::wait_for_responses(const rix::util::Duration &timeout) {
+    if (shutdown_flag_.load()) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    size_t before = pending_.size();
+    poll(timeout);
+    return before > pending_.size() ? before - pending_.size() : 0;
+}
+
+uint32_t ServiceClient::send(const rix::msg::Message &req, Completion completion) {
+    using namespace rix::msg::detail;
+    if (shutdown_flag_.load()) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    uint32_t id = next_id_++;
+    if (next_id_ == 0) next_id_ = 1;
+
+    // Serialize in one pass and fill in the length afterwards
+    size_t header = tx_.skip<uint32_t>();
+    write_number(tx_, id);
+    req.serialize(tx_);
+    tx_.patch(header, static_cast<uint32_t>(tx_.size() - header - service_frame::REQUEST_HEADER_SIZE));
+    pending_[id] = completion;
+
+    // Write immediately if possible so requests are not delayed until the next spin
+    poll(rix::util::Duration(0.0));
+    return id;
+}
+
+bool ServiceClient::cancel(uint32_t id) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return pending_.erase(id) > 0;
+}
+
+void ServiceClient::disconnect() {
+    client_ = nullptr;
+    tx_.clear();
+    rx_.clear();
+    auto pending = std::move(pending_);
+    pending_.clear();
+    for (auto &kv : pending) {
+        kv.second(nullptr, 0, false);
+    }
+}
+
+void ServiceClient::poll(const rix::util::Duration &wait) {
+    using namespace rix::msg::detail;
+
+    if (!client_) {
+        // Rate limit lookups while the service is not available
+        auto now = rix::util::Time::now();
+        if (now - last_lookup_ < rix::util::Duration(0.5)) {
+            return;
+        }
+        last_lookup_ = now;
+
+        rix::msg::mediator::SrvInfo found;
+        if (!request_message_with_opcode(factory_(), info_, OPCODE::SRV_LOOKUP, rixhub_endpoint_, found)) {
+            return;
+        }
+        client_ = factory_();
+        client_->set_nonblocking(true);
+        connect_start_ = now;
+        errno = 0;
+        if (!client_->connect(rix::ipc::Endpoint(found.endpoint.address, found.endpoint.port)) && errno != 0 &&
+            errno != EINPROGRESS && errno != EALREADY && errno != EAGAIN && errno != EINTR) {
+            rix::util::Log::warn << "Service client failed to connect; looking up the service again." << std::endl;
+            disconnect();
+            return;
+        }
+    }
+
+    if (!client_->is_connected()) {
+        if (rix::util::Time::now() - connect_start_ > rix::util::Duration(1.0)) {
+            rix::util::Log::warn << "Service client timed out connecting; looking up the service again." << std::endl;
+            disconnect();
+        }
+        return;
+    }
+
+    if (!tx_.empty()) {
+        // A full socket buffer is retried on the next spin
+        errno = 0;
+        ssize_t bytes = client_->write(tx_.data(), tx_.size());
+        if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            bytes = 0;
+        }
+        if (bytes < 0) {
+            rix::util::Log::warn << "Service client failed to write; dropping connection." << std::endl;
+            disconnect();
+            return;
+        }
+        tx_.consume(bytes);
+    }
+
+    if (pending_.empty() || !client_->wait_for_readable(wait)) {
+        return;
+    }
+    for (int i = 0; i < 16 && client_->is_readable(); i++) {
+        ssize_t bytes = client_->read(chunk_.data(), chunk_.size());
+        if (bytes <= 0) {
+            rix::util::Log::warn << "Service connection closed." << std::endl;
+            disconnect();
+            return;
+        }
+        rx_.insert(rx_.end(), chunk_.begin(), chunk_.begin() + bytes);
+        if (static_cast<size_t>(bytes) < chunk_.size()) break;
+    }
+
+    size_t pos = 0;
+    while (rx_.size() - pos >= service_frame::RESPONSE_HEADER_SIZE) {
+        uint32_t len, id;
+        uint8_t status;
+        size_t offset = pos;
+        deserialize_number(len, rx_.data(), rx_.size(), offset);
+        deserialize_number(id, rx_.data(), rx_.size(), offset);
+        deserialize_number(status, rx_.data(), rx_.size(), offset);
+        if (rx_.size() - offset < len) {
+            break;  // Incomplete response
+        }
+        auto it = pending_.find(id);
+        if (it != pending_.end()) {
+            auto completion = std::move(it->second);
+            pending_.erase(it);
+            completion(rx_.data() + offset, len, status == 0);
+        }
+        pos = offset + len;
+    }
+    rx_.erase(rx_.begin(), rx_.begin() + pos);
+}
+
+}  // namespace core
+}  // namespace rix
@@ -16,9 +16,37 @@ static bool read_head(const std::shared_ptr<rix::ipc::interfaces::Connection>& c
     return true;
 }
 
+/**
+ * @brief Invokes the callback on a received message. The delta coding of
+ * publishers with the DELTA encoding is undone first, so the callback
+ * receives the serialized message.
+ */
+static void dispatch(const Subscriber::SerializedCallback &cb, const std::string &topic, TopicStats &stats,
+                     DeltaDecoder *delta, uint8_t encoding, const uint8_t *src, size_t len) {
+    rix::util::Trace::Scope trace("Subscriber::callback", topic);
+    if (encoding != ENCODING::DELTA) {
+        cb(src, len, encoding);
+    } else if (delta && delta->decode(src, len)) {
+        cb(delta->data(), delta->size(), ENCODING::RAW);
+    } else {
+        rix::util::Log::warn << "Failed to decode delta frame from publisher." << std::endl;
+        stats.drops.add();
+    }
+}
+
 Subscriber::Subscriber(const rix::msg::mediator::SubInfo &info, std::shared_ptr<rix::ipc::interfaces::Server> server,
-                       ClientFactory factory, const rix::ipc::Endpoint &rixhub_endpoint)
-    : info_(info), server_(server), factory_(factory), callback_(nullptr), rixhub_endpoint_(rixhub_endpoint) {
+                       ClientFactory factory, const rix::ipc::Endpoint &rixhub_endpoint,
+                       std::shared_ptr<Transport> transport)
+    : info_(info),
+      factory_(factory),
+      callback_(nullptr),
+      server_(server),
+      transport_(transport),
+      rixhub_endpoint_(rixhub_endpoint),
+      chunk_(16384),
+      stats_(std::make_shared<TopicStats>()),
+      callback_stats_(std::make_shared<CallbackStats>()),
+      shutdown_flag_(false) {
     // Ensure server was intitialized properly
     if (!server_->ok()) {
         shutdown();
@@ -48,6 +76,13 @@ Subscriber::~Subscriber() {
         (void)send_message_with_opcode_no_response(client, info_, OPCODE::SUB_DEREGISTER, rixhub_endpoint_);
     }
     shutdown();
+
+    // The Transport must not invoke the receivers once this object is gone
+    if (transport_) {
+        for (const auto &kv : channels_) {
+            transport_->unsubscribe(kv.second);
+        }
+    }
 }
 
 bool Subscriber::ok() const { return !shutdown_flag_; }
@@ -56,9 +91,51 @@ void Subscriber::shutdown() { shutdown_flag_ = true; }
 
 Subscriber::SerializedCallback Subscriber::get_callback() const { return callback_; }
 
-size_t Subscriber::get_publisher_count() const {
+void Subscriber::set_serialized_callback(SerializedCallback callback) {
+    std::lock_guard<std::mutex> guard(callback_mutex_);
+    if (!callback) {
+        callback_ = nullptr;
+        return;
+    }
+    callback_ = [callback, stats = stats_, callback_stats = callback_stats_](const uint8_t *msg, size_t len,
+                                                                             uint8_t encoding) {
+        stats->messages.add();
+        const int64_t start = CallbackStats::now();
+        const int64_t budget = callback_stats->last_start() < 0 ? 0 : start - callback_stats->last_start();
+        callback(msg, len, encoding);
+        callback_stats->record(start, CallbackStats::now(), budget);
+    };
+}
+
+void Subscriber::set_loss_callback(LossCallback callback) {
     std::lock_guard<std::mutex> guard(callback_mutex_);
-    return clients_.size();
+    loss_callback_ = callback;
+}
+
+size_t Subscriber::get_publisher_count() const {
+    size_t count;
+    std::map<uint64_t, uint16_t> channels;
+    {
+        std::lock_guard<std::mutex> guard(callback_mutex_);
+        count = clients_.size();
+        channels = channels_;
+    }
+    // The Transport invokes callbacks while holding its lock, so it must not
+    // be called while holding callback_mutex_
+    for (const auto &kv : channels) {
+        if (transport_->is_subscribed(kv.second)) count++;
+    }
+    return count;
+}
+
+const TopicStats &Subscriber::stats() const { return *stats_; }
+
+const CallbackStats &Subscriber::callback_stats() const { return *callback_stats_; }
+
+size_t Subscriber::get_queued_bytes() const {
+    size_t bytes = 0;
+    for (const auto &kv : buffers_) bytes += kv.second.size();
+    return bytes;
 }
 
 /**< TODO: Implement the spin_once method */
@@ -71,9 +148,10 @@ void Subscriber::spin_once() {
     }
 
     do{
-        if (!server_->wait_for_accept(rix::util::Duration(0.25))) {
+        if (!server_->wait_for_accept(rix::util::Duration(0.0))) {
             break;
         }
+        rix::util::Trace::Scope trace("Subscriber::accept", info_.topic_info.name);
         std::weak_ptr<rix::ipc::interfaces::Connection> wconn;
         if (!server_->accept(wconn)) {
             //std::cerr << "test1";
@@ -86,8 +164,10 @@ void Subscriber::spin_once() {
             break;
         }
 
+        std::array<uint8_t, OPERATION_ARENA_SIZE> arena_buffer;
+        std::pmr::monotonic_buffer_resource arena(arena_buffer.data(), arena_buffer.size());
         rix::msg::mediator::Operation op;
-        std::vector<uint8_t> hdr(op.size());
+        std::pmr::vector<uint8_t> hdr(op.size(), &arena);
         //ssize_t hbytes = conn->read(hdr.data(), hdr.size());
         //size_t hoff = 0;
         //std::cerr << "test3";
@@ -99,7 +179,7 @@ void Subscriber::spin_once() {
             break;
         }
         if (op.len > 0) {
-            std::vector<uint8_t> payload(op.len);
+            std::pmr::vector<uint8_t> payload(op.len, &arena);
             if (!read_head(conn, payload.data(), payload.size())) {
                 break;
             }
@@ -107,12 +187,37 @@ void Subscriber::spin_once() {
             if (op.opcode != SUB_NOTIFY) {
                 break;
             }
-            rix::msg::mediator::SubNotify notify;
+            // The notification is decoded into the same message every time, so
+            // its publishers and their strings keep their allocations
             off = 0;
-            if (!notify.deserialize(payload.data(), static_cast<ssize_t>(payload.size()), off)) {
+            if (!notify_.deserialize(payload.data(), static_cast<ssize_t>(payload.size()), off)) {
                 break;
             }
-            for (const auto &pub : notify.publishers) {
+            for (const auto &pub : notify_.publishers) {
+                if (pub.protocol == PROTOCOL::TCP_MUX) {
+                    if (!transport_) {
+                        rix::util::Log::warn << "Cannot subscribe to multiplexed publisher." << std::endl;
+                        continue;
+                    }
+                    uint8_t encoding = pub.topic_info.encoding;
+                    auto delta = std::make_shared<DeltaDecoder>();
+                    Transport::Receiver receiver = [this, encoding, delta](const uint8_t *src, size_t len) {
+                        if (shutdown_flag_.load()) return;
+                        SerializedCallback cb;
+                        {
+                            std::lock_guard<std::mutex> g(callback_mutex_);
+                            cb = callback_;
+                        }
+                        stats_->bytes.add(mux_frame::HEADER_SIZE + len);
+                        if (cb) dispatch(cb, info_.topic_info.name, *stats_, delta.get(), encoding, src, len);
+                    };
+                    uint16_t channel = transport_->subscribe(pub, receiver);
+                    if (channel != 0) {
+                        std::lock_guard<std::mutex> g(callback_mutex_);
+                        channels_[pub.id] = channel;
+                    }
+                    continue;
+                }
                 auto c = factory_ ? factory_() : nullptr;
                 if (!c) {
                     continue;
@@ -122,6 +227,7 @@ void Subscriber::spin_once() {
                 (void)c->connect(ep);
                  std::lock_guard<std::mutex> g(callback_mutex_);
                 clients_[pub.id] = c;
+                encodings_[pub.id] = pub.topic_info.encoding;
                 //std::cerr << "test7";
             }
         }
@@ -130,9 +236,11 @@ void Subscriber::spin_once() {
     
 
     SerializedCallback cb;
+    LossCallback loss_cb;
     {
         std::lock_guard<std::mutex> g(callback_mutex_);
         cb = callback_;
+        loss_cb = loss_callback_;
     }
 
     for (auto it = clients_.begin(); it != clients_.end(); ) {
@@ -147,43 +255,71 @@ void Subscriber::spin_once() {
             continue; 
         }
 
-        rix::msg::standard::UInt32 size_prefix;
-        std::vector<uint8_t> sbuf(size_prefix.size());
-        //ssize_t sbytes = c->read(sbuf.data(), sbuf.size());
-        size_t off = 0;
-        if (!read_head(c, sbuf.data(), sbuf.size())) {
-            ++it;
-            continue;
-        }
-
-        /**uint32_t msg_size = (static_cast<uint32_t>(sbuf[0]) << 24) |
-                    (static_cast<uint32_t>(sbuf[1]) << 16) |
-                    (static_cast<uint32_t>(sbuf[2]) << 8)  |
-                     static_cast<uint32_t>(sbuf[3]);**/
-
-        if (!size_prefix.deserialize(sbuf.data(), static_cast<ssize_t>(sbuf.size()), off)) {
-            ++it;
-            continue;
+        // Read everything that is available so that batched messages are
+        // handled in this iteration. A readable connection that returns no
+        // data has been closed by the publisher.
+        auto &buffer = buffers_[it->first];
+        uint8_t encoding = encodings_[it->first];
+        DeltaDecoder *delta = encoding == ENCODING::DELTA ? &deltas_[it->first] : nullptr;
+        bool closed = false;
+        int64_t received = 0;
+        {
+            rix::util::Trace::Scope trace("Subscriber::read", info_.topic_info.name);
+            for (int i = 0; i < 16 && c->is_readable(); i++) {
+                ssize_t bytes = c->read(chunk_.data(), chunk_.size());
+                if (bytes <= 0) {
+                    closed = true;
+                    break;
+                }
+                buffer.insert(buffer.end(), chunk_.begin(), chunk_.begin() + bytes);
+                if (static_cast<size_t>(bytes) < chunk_.size()) break;
+            }
+            received = CallbackStats::now();
         }
 
-        if (size_prefix.data == 0) {
-            ++it;
-            continue;
+        // Invoke the callback for every complete message
+        auto &sequence = sequences_[it->first];
+        size_t pos = 0;
+        while (buffer.size() - pos >= data_frame::HEADER_SIZE) {
+            uint32_t len, seq;
+            size_t off = pos;
+            rix::msg::detail::deserialize_number(len, buffer.data(), buffer.size(), off);
+            rix::msg::detail::deserialize_number(seq, buffer.data(), buffer.size(), off);
+            const bool timestamped = len & data_frame::TIMESTAMPED;
+            len &= ~data_frame::TIMESTAMPED;
+            const size_t extra = timestamped ? data_frame::TIMESTAMP_SIZE : 0;
+            if (buffer.size() - off < extra + len) {
+                break;
+            }
+            int64_t sent = 0;
+            if (timestamped) {
+                rix::msg::detail::deserialize_number(sent, buffer.data(), buffer.size(), off);
+            }
+            stats_->bytes.add(data_frame::HEADER_SIZE + extra + len);
+            const uint32_t expected = sequence.next();
+            if (uint32_t missing = sequence.update(seq, *stats_); missing > 0 && loss_cb) {
+                loss_cb(it->first, expected, missing);
+            }
+            if (timestamped) {
+                // A frame is received when the read that completed it returned
+                stats_->delivery.record(static_cast<uint64_t>(std::max<int64_t>(received - sent, 0)));
+                stats_->queueing.record(static_cast<uint64_t>(std::max<int64_t>(CallbackStats::now() - received, 0)));
+            }
+            if (len > 0 && cb) {
+                dispatch(cb, info_.topic_info.name, *stats_, delta, encoding, buffer.data() + off, len);
+            }
+            pos = off + len;
         }
+        buffer.erase(buffer.begin(), buffer.begin() + pos);
 
-        /**if (!client->is_readable()) {
-            ++it; 
-            continue; 
-        }**/
-
-        std::vector<uint8_t> mbuf(size_prefix.data);
-        //ssize_t mbytes = c->read(mbuf.data(), mbuf.size());
-        if (!read_head(c, mbuf.data(), mbuf.size())) {
-            ++it;
+        if (closed) {
+            buffers_.erase(it->first);
+            encodings_.erase(it->first);
+            deltas_.erase(it->first);
+            std::lock_guard<std::mutex> g(callback_mutex_);
+            it = clients_.erase(it);
             continue;
         }
-
-        cb(mbuf.data(), mbuf.size());
         ++it;
     }
 }
@@ -21,7 +21,13 @@ void Timer::spin_once() {
         std::lock_guard<std::mutex> guard(callback_mutex_);
         event_.current_expected = event_.last_expected + duration_;
         event_.last_duration = event_.current_real - event_.last_real;
-        callback_(event_);
+        {
+            rix::util::Trace::Scope trace("Timer::callback");
+            const int64_t start = CallbackStats::now();
+            callback_(event_);
+            const int64_t budget = duration_.get().count();
+            stats_.record(start, CallbackStats::now(), budget, budget);
+        }
         event_.last_real = event_.current_real;
         event_.last_expected = event_.current_expected;
     }
@@ -31,5 +37,9 @@ void Timer::set_callback(Callback callback) { callback_ = callback; }
 
 Timer::Callback Timer::get_callback() const { return callback_; }
 
+const CallbackStats &Timer::stats() const { return stats_; }
+
+const rix::util::Duration &Timer::get_duration() const { return duration_; }
+
 }  // namespace core
 }  // namespace rix
\ No newline at end of file
@@ -0,0 +1,415 @@
+#include "rix/core/transport.hpp"
+
+#include <cerrno>
+
+namespace rix {
+namespace core {
+
+Transport::Transport(uint64_t node_id, ClientFactory factory)
+    : node_id_(node_id), server_(nullptr), factory_(factory), next_channel_(1), chunk_(65536), shutdown_flag_(false) {}
+
+Transport::~Transport() { shutdown(); }
+
+bool Transport::ok() const { return !shutdown_flag_; }
+
+void Transport::shutdown() {
+    shutdown_flag_ = true;
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    while (!links_.empty()) {
+        close(links_.front());
+    }
+}
+
+bool Transport::listen(std::shared_ptr<rix::ipc::interfaces::Server> server) {
+    if (!server || !server->ok()) {
+        return false;
+    }
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    server_ = server;
+    return true;
+}
+
+bool Transport::is_multiplexing() const {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    return server_ != nullptr;
+}
+
+rix::ipc::Endpoint Transport::local_endpoint() const {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    return server_ ? server_->local_endpoint() : rix::ipc::Endpoint();
+}
+
+size_t Transport::get_connection_count() const {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    return links_.size();
+}
+
+void Transport::advertise(uint64_t pub_id, bool delta) {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    routes_[pub_id];
+    if (delta) {
+        delta_publishers_.insert(pub_id);
+    }
+}
+
+void Transport::unadvertise(uint64_t pub_id) {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    routes_.erase(pub_id);
+    delta_publishers_.erase(pub_id);
+}
+
+size_t Transport::get_subscriber_count(uint64_t pub_id) const {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    auto it = routes_.find(pub_id);
+    if (it == routes_.end()) {
+        return 0;
+    }
+    size_t count = 0;
+    for (const auto &route : it->second) {
+        if (!route.link.expired()) count++;
+    }
+    return count;
+}
+
+std::shared_ptr<rix::ipc::interfaces::Connection> Transport::connection(const Link &link) {
+    if (link.client) {
+        return link.client;
+    }
+    return link.accepted.lock();
+}
+
+size_t Transport::begin_frame(Link &link, uint16_t channel, uint32_t len) {
+    using namespace rix::msg::detail;
+    size_t offset = link.tx.size();
+    uint8_t *dst = link.tx.extend(mux_frame::HEADER_SIZE + len);
+    size_t header = 0;
+    serialize_number(dst, header, len);
+    serialize_number(dst, header, channel);
+    return offset + header;
+}
+
+void Transport::send(uint64_t pub_id, const rix::msg::Message &msg, const Encoder &encoder, TopicStats *stats) {
+    using namespace rix::msg::detail;
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    if (stats) stats->messages.add();
+    auto it = routes_.find(pub_id);
+    if (it == routes_.end() || it->second.empty()) {
+        return;
+    }
+    auto &routes = it->second;
+
+    // Serialize in a single pass. With one subscription the message is
+    // written straight into its frame and the length is filled in afterwards.
+    // With several, it is serialized once and copied into every frame. Delta
+    // encoded subscriptions encode the serialized message into their frame.
+    auto serialize = [&](rix::msg::Writer &dst) {
+        if (encoder) {
+            encoder(msg, dst);
+        } else {
+            msg.serialize(dst);
+        }
+    };
+    const bool delta = delta_publishers_.count(pub_id) > 0;
+    const bool shared = routes.size() > 1 || delta;
+    if (shared) {
+        scratch_.clear();
+        serialize(scratch_);
+    }
+
+    for (auto route = routes.begin(); route != routes.end();) {
+        auto link = route->link.lock();
+        if (!link) {
+            route = routes.erase(route);
+            continue;
+        }
+
+        const size_t queued = link->tx.size();
+        if (delta) {
+            size_t header = link->tx.skip<uint32_t>();
+            write_number(link->tx, route->channel);
+            route->delta->encode(scratch_.data(), scratch_.size(), link->tx);
+            link->tx.patch(header, static_cast<uint32_t>(link->tx.size() - header - mux_frame::HEADER_SIZE));
+        } else if (shared) {
+            size_t offset = begin_frame(*link, route->channel, static_cast<uint32_t>(scratch_.size()));
+            std::memcpy(link->tx.data() + offset, scratch_.data(), scratch_.size());
+        } else {
+            size_t header = link->tx.skip<uint32_t>();
+            write_number(link->tx, route->channel);
+            serialize(link->tx);
+            link->tx.patch(header, static_cast<uint32_t>(link->tx.size() - header - mux_frame::HEADER_SIZE));
+        }
+
+        if (stats) stats->bytes.add(link->tx.size() - queued);
+
+        if (link->tx.size() >= FLUSH_THRESHOLD && !flush(*link)) {
+            if (stats) stats->write_failures.add();
+            close(link);
+            route = routes.erase(route);
+            continue;
+        }
+        ++route;
+    }
+}
+
+uint16_t Transport::subscribe(const rix::msg::mediator::PubInfo &pub, Receiver receiver) {
+    using namespace rix::msg::detail;
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    if (shutdown_flag_.load()) {
+        return 0;
+    }
+
+    // Reuse the connection to the publisher's node if there is one
+    std::shared_ptr<Link> link;
+    for (const auto &l : links_) {
+        if (l->peer_id == pub.node_id) {
+            link = l;
+            break;
+        }
+    }
+    if (!link) {
+        auto client = factory_ ? factory_() : nullptr;
+        if (!client) {
+            return 0;
+        }
+        client->set_nonblocking(true);
+        (void)client->connect(rix::ipc::Endpoint(pub.endpoint.address, pub.endpoint.port));
+
+        link = std::make_shared<Link>();
+        link->client = client;
+        link->peer_id = pub.node_id;
+        size_t offset = begin_frame(*link, mux_frame::CONTROL_CHANNEL, 9);
+        serialize_number(link->tx.data(), offset, static_cast<uint8_t>(mux_frame::HELLO));
+        serialize_number(link->tx.data(), offset, node_id_);
+        links_.push_back(link);
+    }
+
+    // Find an unused channel
+    uint16_t channel = next_channel_;
+    while (channel == mux_frame::CONTROL_CHANNEL || channels_.count(channel)) {
+        channel++;
+        if (channel == next_channel_) {
+            rix::util::Log::warn << "No channels available for subscription." << std::endl;
+            return 0;
+        }
+    }
+    next_channel_ = channel + 1;
+    channels_[channel] = Channel{link, receiver};
+
+    size_t offset = begin_frame(*link, mux_frame::CONTROL_CHANNEL, 11);
+    serialize_number(link->tx.data(), offset, static_cast<uint8_t>(mux_frame::SUBSCRIBE));
+    serialize_number(link->tx.data(), offset, pub.id);
+    serialize_number(link->tx.data(), offset, channel);
+    return channel;
+}
+
+void Transport::unsubscribe(uint16_t channel) {
+    using namespace rix::msg::detail;
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    auto it = channels_.find(channel);
+    if (it == channels_.end()) {
+        return;
+    }
+    if (auto link = it->second.link.lock()) {
+        size_t offset = begin_frame(*link, mux_frame::CONTROL_CHANNEL, 3);
+        serialize_number(link->tx.data(), offset, static_cast<uint8_t>(mux_frame::UNSUBSCRIBE));
+        serialize_number(link->tx.data(), offset, channel);
+    }
+    channels_.erase(it);
+}
+
+bool Transport::is_subscribed(uint16_t channel) const {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    auto it = channels_.find(channel);
+    return it != channels_.end() && !it->second.link.expired();
+}
+
+void Transport::handle_control(const std::shared_ptr<Link> &link, const uint8_t *src, size_t len) {
+    using namespace rix::msg::detail;
+    size_t offset = 0;
+    uint8_t type;
+    if (!deserialize_number(type, src, len, offset)) {
+        return;
+    }
+    switch (type) {
+        case mux_frame::HELLO: {
+            uint64_t peer_id;
+            if (deserialize_number(peer_id, src, len, offset)) {
+                link->peer_id = peer_id;
+            }
+            break;
+        }
+        case mux_frame::SUBSCRIBE: {
+            uint64_t pub_id;
+            uint16_t channel;
+            if (!deserialize_number(pub_id, src, len, offset) || !deserialize_number(channel, src, len, offset)) {
+                return;
+            }
+            auto it = routes_.find(pub_id);
+            if (it == routes_.end()) {
+                rix::util::Log::warn << "Subscription to unknown publisher." << std::endl;
+                return;
+            }
+            std::shared_ptr<DeltaEncoder> delta;
+            if (delta_publishers_.count(pub_id)) {
+                delta = std::make_shared<DeltaEncoder>();
+            }
+            it->second.push_back(Route{link, channel, delta});
+            break;
+        }
+        case mux_frame::UNSUBSCRIBE: {
+            uint16_t channel;
+            if (!deserialize_number(channel, src, len, offset)) {
+                return;
+            }
+            for (auto &kv : routes_) {
+                auto &routes = kv.second;
+                for (auto route = routes.begin(); route != routes.end();) {
+                    if (route->channel == channel && route->link.lock() == link) {
+                        route = routes.erase(route);
+                    } else {
+                        ++route;
+                    }
+                }
+            }
+            break;
+        }
+        default:
+            rix::util::Log::warn << "Unknown control frame." << std::endl;
+            break;
+    }
+}
+
+void Transport::handle_frames(const std::shared_ptr<Link> &link) {
+    using namespace rix::msg::detail;
+    size_t pos = 0;
+    while (link->rx.size() - pos >= mux_frame::HEADER_SIZE) {
+        uint32_t len;
+        uint16_t channel;
+        size_t offset = pos;
+        deserialize_number(len, link->rx.data(), link->rx.size(), offset);
+        deserialize_number(channel, link->rx.data(), link->rx.size(), offset);
+        if (link->rx.size() - offset < len) {
+            break;  // Incomplete frame
+        }
+
+        const uint8_t *payload = link->rx.data() + offset;
+        if (channel == mux_frame::CONTROL_CHANNEL) {
+            handle_control(link, payload, len);
+        } else {
+            // Look up the channel for every frame, a receiver may unsubscribe
+            auto it = channels_.find(channel);
+            if (it != channels_.end() && it->second.link.lock() == link && it->second.receiver) {
+                auto receiver = it->second.receiver;
+                receiver(payload, len);
+            }
+        }
+        pos = offset + len;
+    }
+    link->rx.erase(link->rx.begin(), link->rx.begin() + pos);
+}
+
+bool Transport::flush(Link &link) {
+    auto conn = connection(link);
+    if (!conn) {
+        return false;
+    }
+    if (link.tx.empty() || (link.client && !link.client->is_connected())) {
+        return link.tx.size() < MAX_QUEUED;
+    }
+    ssize_t bytes;
+    {
+        rix::util::Trace::Scope trace("Transport::write");
+        errno = 0;
+        bytes = conn->write(link.tx.data(), link.tx.size());
+        // A full socket buffer keeps the bytes queued until MAX_QUEUED is reached
+        if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            bytes = 0;
+        }
+    }
+    if (bytes < 0) {
+        return false;
+    }
+    link.tx.consume(bytes);
+    if (link.tx.size() >= MAX_QUEUED) {
+        rix::util::Log::warn << "Peer is not reading; dropping connection." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void Transport::close(const std::shared_ptr<Link> &link) {
+    for (auto it = channels_.begin(); it != channels_.end();) {
+        if (it->second.link.lock() == link) {
+            it = channels_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    if (server_ && !link->client) {
+        server_->close(link->accepted);
+    }
+    link->client = nullptr;
+    links_.remove(link);
+}
+
+void Transport::spin_once() {
+    if (shutdown_flag_.load()) {
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+
+    // Accept new connections from other nodes
+    while (server_ && server_->wait_for_accept(rix::util::Duration(0.0))) {
+        std::weak_ptr<rix::ipc::interfaces::Connection> conn;
+        rix::util::Trace::Scope trace("Transport::accept");
+        if (!server_->accept(conn)) {
+            break;
+        }
+        if (auto c = conn.lock()) {
+            c->set_nonblocking(true);
+            auto link = std::make_shared<Link>();
+            link->accepted = conn;
+            link->peer_id = 0;
+            links_.push_back(link);
+        }
+    }
+
+    // Iterate over a copy, receivers may subscribe and create new links
+    auto links = links_;
+    for (auto &link : links) {
+        auto conn = connection(*link);
+        if (!conn) {
+            close(link);
+            continue;
+        }
+        if (link->client && !link->client->is_connected()) {
+            continue;
+        }
+
+        // Read everything that is available. A readable connection that
+        // returns no data has been closed by the peer.
+        bool closed = false;
+        {
+            rix::util::Trace::Scope trace("Transport::read");
+            for (int i = 0; i < 16 && conn->is_readable(); i++) {
+                ssize_t bytes = conn->read(chunk_.data(), chunk_.size());
+                if (bytes <= 0) {
+                    closed = true;
+                    break;
+                }
+                link->rx.insert(link->rx.end(), chunk_.begin(), chunk_.begin() + bytes);
+                if (static_cast<size_t>(bytes) < chunk_.size()) break;
+            }
+        }
+
+        handle_frames(link);
+
+        if (closed || !flush(*link)) {
+            close(link);
+        }
+    }
+}
+
+}  // namespace core
+}  // namespace rix
@@ -0,0 +1,232 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <set>
+
+#include "rix/core/bag.hpp"
+#include "rix/core/node.hpp"
+#include "rix/ipc/signal.hpp"
+#include "rix/util/argument_parser.hpp"
+
+static const char USAGE[] =
+    "Usage: rixbag <command> [options]\n"
+    "\n"
+    "Commands:\n"
+    "  record <file> <topics>...   Record topics to a bag\n"
+    "  play <file>                 Publish the messages of a bag\n";
+
+/**
+ * @brief Records the serialized messages of the topics until SIGINT. Topics
+ * that are not registered with rixhub yet are looked up again every second.
+ *
+ */
+static int record(int argc, char **argv) {
+    rix::util::ArgumentParser parser("rixbag record", "Record topics to a bag");
+    parser.add<std::string>("file", "The bag to create");
+    parser.add<std::vector<std::string>>("topics", "The topics to record");
+    parser.add<int>("chunk", "Size of a chunk in MiB", 'c', 4);
+    if (!parser.parse(argc, argv)) {
+        std::cerr << parser.help() << std::endl;
+        return 1;
+    }
+    std::string file;
+    std::vector<std::string> topics;
+    int chunk_mib = 4;
+    parser.get("file", file);
+    parser.get("topics", topics);
+    parser.get("chunk", chunk_mib);
+
+    rix::core::BagWriter bag;
+    if (chunk_mib <= 0 || !bag.open(file, size_t(chunk_mib) << 20)) {
+        rix::util::Log::error << "Failed to create bag " << file << std::endl;
+        return 1;
+    }
+
+    rix::ipc::Endpoint rixhub_endpoint("127.0.0.1", rix::core::RIXHUB_PORT);
+    auto node = std::make_shared<rix::core::Node>("rixbag", rixhub_endpoint);
+    if (!node->ok()) {
+        rix::util::Log::error << "Failed to create node." << std::endl;
+        return 1;
+    }
+
+    // Messages are stored as received, with the time of their callback
+    std::vector<std::shared_ptr<rix::core::Subscriber>> subscribers(topics.size());
+    auto subscribe = [&]() {
+        for (size_t i = 0; i < topics.size(); i++) {
+            rix::msg::mediator::TopicInfo info;
+            if (subscribers[i] || !node->lookup_topic(topics[i], info)) {
+                continue;
+            }
+            int id = bag.add_topic(info);
+            if (id < 0) {
+                return;
+            }
+            subscribers[i] = node->create_subscriber(info, [&bag, id](const uint8_t *src, size_t len, uint8_t encoding) {
+                bag.write(static_cast<uint16_t>(id), rix::util::Time::now().to_nanoseconds(), encoding, src, len);
+            });
+            if (subscribers[i]) {
+                rix::util::Log::info << "Recording " << topics[i] << std::endl;
+            }
+        }
+    };
+    subscribe();
+    auto timer = node->create_timer(rix::util::Duration(1.0), [&](const rix::core::Timer::Event &) {
+        if (!bag.ok()) {
+            node->shutdown();
+            return;
+        }
+        subscribe();
+    });
+
+    auto notif = std::make_shared<rix::ipc::Signal>(SIGINT);
+    node->spin(notif);
+    subscribers.clear();
+
+    uint64_t messages = bag.messages();
+    uint64_t bytes = bag.bytes();
+    if (!bag.close()) {
+        rix::util::Log::error << "Failed to write bag " << file << std::endl;
+        return 1;
+    }
+    std::cout << "Recorded " << messages << " messages (" << bytes << " bytes) to " << file << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Publishes the messages of a bag with their recorded timing, scaled
+ * by the rate. The node spins while the player waits for the next message,
+ * and at least every 10 ms when it falls behind, so that subscribers keep
+ * connecting during playback.
+ *
+ */
+static int play(int argc, char **argv) {
+    rix::util::ArgumentParser parser("rixbag play", "Publish the messages of a bag");
+    parser.add<std::string>("file", "The bag to play");
+    parser.add<double>("rate", "Factor of the playback speed (0 to publish as fast as possible)", 'r', 1.0);
+    parser.add<double>("start", "Seconds into the bag to start at", 's', 0.0);
+    parser.add<double>("delay", "Seconds to wait for subscribers before playing", 'd', 1.0);
+    parser.add<std::vector<std::string>>("topics", "The topics to play (default: all)", 't', {});
+    if (!parser.parse(argc, argv)) {
+        std::cerr << parser.help() << std::endl;
+        return 1;
+    }
+    std::string file;
+    double rate = 1.0, start = 0.0, delay = 1.0;
+    std::vector<std::string> topics;
+    parser.get("file", file);
+    parser.get("rate", rate);
+    parser.get("start", start);
+    parser.get("delay", delay);
+    parser.get("topics", topics);
+
+    rix::core::BagReader bag;
+    if (rate < 0.0 || !bag.open(file)) {
+        rix::util::Log::error << "Failed to open bag " << file << std::endl;
+        return 1;
+    }
+
+    rix::ipc::Endpoint rixhub_endpoint("127.0.0.1", rix::core::RIXHUB_PORT);
+    auto node = std::make_shared<rix::core::Node>("rixbag", rixhub_endpoint);
+    if (!node->ok()) {
+        rix::util::Log::error << "Failed to create node." << std::endl;
+        return 1;
+    }
+
+    // One publisher per topic and encoding, since the bytes are published as
+    // recorded. Subscribers record DELTA messages decoded, as RAW.
+    const std::set<std::string> selected(topics.begin(), topics.end());
+    std::map<std::pair<uint16_t, uint8_t>, std::shared_ptr<rix::core::Publisher>> publishers;
+    auto publisher_for = [&](uint16_t topic, uint8_t encoding) -> rix::core::Publisher * {
+        auto key = std::make_pair(topic, encoding);
+        auto it = publishers.find(key);
+        if (it != publishers.end()) {
+            return it->second.get();
+        }
+        std::shared_ptr<rix::core::Publisher> pub;
+        const auto &all = bag.topics();
+        if (topic < all.size() && (selected.empty() || selected.count(all[topic].name) > 0)) {
+            auto info = all[topic];
+            info.encoding = encoding;
+            pub = node->create_serialized_publisher(info);
+            if (!pub) {
+                rix::util::Log::warn << "Failed to create publisher on " << info.name << std::endl;
+            }
+        }
+        return publishers.emplace(key, pub).first->second.get();
+    };
+    for (uint16_t topic = 0; topic < bag.topics().size(); topic++) {
+        uint8_t encoding = bag.topics()[topic].encoding;
+        publisher_for(topic, encoding == rix::core::ENCODING::DELTA ? static_cast<uint8_t>(rix::core::ENCODING::RAW)
+                                                                    : static_cast<uint8_t>(encoding));
+    }
+
+    auto notif = std::make_shared<rix::ipc::Signal>(SIGINT);
+    using Clock = std::chrono::steady_clock;
+    auto wait_until = [&](Clock::time_point deadline) {
+        while (node->ok()) {
+            node->spin_once();
+            auto now = Clock::now();
+            if (now >= deadline) {
+                return true;
+            }
+            auto timeout = std::min<Clock::duration>(deadline - now, std::chrono::milliseconds(10));
+            if (notif->wait(rix::util::Duration(std::chrono::duration<double>(timeout).count()))) {
+                return false;
+            }
+        }
+        return false;
+    };
+    if (!wait_until(Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(delay)))) {
+        return 0;
+    }
+
+    const int64_t begin = bag.start_time() + static_cast<int64_t>(start * 1e9);
+    bag.start(bag.seek(begin));
+    const auto wall_begin = Clock::now();
+    auto last_spin = wall_begin;
+    uint64_t played = 0;
+    int64_t last_time = begin;
+    rix::core::BagReader::Message msg;
+    while (node->ok() && bag.next(msg)) {
+        if (msg.time < begin) {
+            continue;
+        }
+        auto now = Clock::now();
+        if (rate > 0.0) {
+            auto due = wall_begin + std::chrono::nanoseconds(static_cast<int64_t>((msg.time - begin) / rate));
+            if (due > now) {
+                if (!wait_until(due)) break;
+                last_spin = Clock::now();
+            }
+        }
+        if (now - last_spin >= std::chrono::milliseconds(10)) {
+            node->spin_once();
+            if (notif->wait(rix::util::Duration(0.0))) break;
+            last_spin = now;
+        }
+        if (auto *pub = publisher_for(msg.topic, msg.encoding)) {
+            pub->publish_serialized(msg.data, msg.len);
+            played++;
+            last_time = msg.time;
+        }
+    }
+    node->spin_once();
+
+    double seconds = std::chrono::duration<double>(Clock::now() - wall_begin).count();
+    double recorded = (last_time - begin) * 1e-9;
+    std::cout << "Played " << played << " messages in " << seconds << " s (" << recorded / std::max(seconds, 1e-9)
+              << "x real time)" << std::endl;
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 2 && std::strcmp(argv[1], "record") == 0) {
+        return record(argc - 1, argv + 1);
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "play") == 0) {
+        return play(argc - 1, argv + 1);
+    }
+    std::cerr << USAGE;
+    return 1;
+}
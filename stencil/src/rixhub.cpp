@@ -1,11 +1,23 @@
 #include <iostream>
+#include <thread>
 
 #include "rix/core/mediator.hpp"
+#include "rix/core/node.hpp"
 #include "rix/ipc/signal.hpp"
+#include "rix/util/argument_parser.hpp"
+
+int main(int argc, char **argv) {
+    rix::util::ArgumentParser parser("rixhub", "Mediator of rix nodes");
+    parser.add<double>("stats", "Publish statistics on /rix/stats/rixhub every N seconds (0 to disable)", 's', 0.0);
+    if (!parser.parse(argc, argv)) {
+        std::cerr << parser.help() << std::endl;
+        return 1;
+    }
+    double stats_period = 0.0;
+    parser.get("stats", stats_period);
 
-int main() {
     rix::ipc::Endpoint rixhub_endpoint("127.0.0.1", rix::core::RIXHUB_PORT);
-    
+
     auto mediator = std::make_shared<rix::core::Mediator>(rixhub_endpoint);
     if (!mediator->ok()) {
         rix::util::Log::error << "Failed to create mediator." << std::endl;
@@ -13,7 +25,30 @@ int main() {
     }
 
     auto notif = std::make_shared<rix::ipc::Signal>(SIGINT);
-    mediator->spin(notif);
+    if (stats_period <= 0.0) {
+        mediator->spin(notif);
+        return 0;
+    }
+
+    // The statistics are published by a node of rixhub, which registers with
+    // the mediator like any other node, so the mediator spins on its own thread
+    std::thread mediator_thread([&]() { mediator->spin(); });
+    {
+        auto node = std::make_shared<rix::core::Node>("rixhub", rixhub_endpoint);
+        auto pub = node->create_publisher<rix::msg::stats::MediatorStatistics>(
+            std::string(rix::core::STATS_TOPIC_PREFIX) + "rixhub");
+        if (!node->ok() || !pub) {
+            rix::util::Log::error << "Failed to create statistics publisher." << std::endl;
+            node->shutdown();
+        }
+        auto timer = node->create_timer(rix::util::Duration(stats_period),
+                                        [&](const rix::core::Timer::Event &) { pub->publish(mediator->stats()); });
+        if (node->ok()) {
+            node->spin(notif);
+        }
+    }
+    mediator->shutdown();
+    mediator_thread.join();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,19 @@
+#include <iostream>
+
+#include "rix/util/binary_log.hpp"
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <file.rixlog>..." << std::endl;
+        return 1;
+    }
+
+    int status = 0;
+    for (int i = 1; i < argc; i++) {
+        if (!rix::util::BinaryLog::decode(argv[i], std::cout)) {
+            std::cerr << argv[i] << " is not a binary log." << std::endl;
+            status = 1;
+        }
+    }
+    return status;
+}
@@ -1,13 +1,25 @@
 #include <gmock/gmock.h>
 
+#include <limits>
 #include <thread>
 
 #include "mocks/mock_client.hpp"
 #include "mocks/mock_server.hpp"
+#include "rix/core/bag.hpp"
+#include "rix/core/delta.hpp"
 #include "rix/core/mediator.hpp"
+#include "rix/core/message_pool.hpp"
 #include "rix/core/node.hpp"
+#include "rix/core/pose_buffer.hpp"
+#include "rix/core/stats.hpp"
+#include "rix/core/synchronizer.hpp"
+#include "rix/msg/geometry/Pose2DStamped.hpp"
+#include "rix/msg/mediator/SubNotify.hpp"
+#include "rix/msg/sensor/LaserScan.hpp"
+#include "rix/msg/sensor/QuantizedLaserScan.hpp"
 #include "rix/msg/standard/Header.hpp"
 #include "rix/msg/standard/UInt32.hpp"
+#include "rix/util/binary_log.hpp"
 
 using ::testing::NiceMock;
 
@@ -684,4 +696,1556 @@ TEST(RIXTest, DifferentNodesAndTopics) {
     NiceMock<MockServer>::server_map = nullptr;
     NiceMock<MockClient>::server_mutex = nullptr;
     NiceMock<MockServer>::server_mutex = nullptr;
-}
\ No newline at end of file
+}
+
+TEST(RIXTest, Synchronizer) {
+    using rix::msg::geometry::Pose2DStamped;
+    using rix::msg::sensor::LaserScan;
+
+    auto make_scan = [](int32_t sec, int32_t nsec) {
+        LaserScan msg{};
+        msg.header.stamp.sec = sec;
+        msg.header.stamp.nsec = nsec;
+        return msg;
+    };
+    auto make_pose = [](int32_t sec, int32_t nsec) {
+        Pose2DStamped msg{};
+        msg.header.stamp.sec = sec;
+        msg.header.stamp.nsec = nsec;
+        return msg;
+    };
+
+    // Exact time: only identical stamps are matched, older heads are dropped
+    std::vector<std::pair<int32_t, int32_t>> exact;
+    rix::core::Synchronizer<LaserScan, Pose2DStamped> exact_sync(
+        rix::core::SyncPolicy::EXACT_TIME,
+        [&](const LaserScan &scan, const Pose2DStamped &pose) {
+            EXPECT_EQ(scan.header.stamp.nsec, pose.header.stamp.nsec);
+            exact.push_back({scan.header.stamp.sec, scan.header.stamp.nsec});
+        },
+        4);
+    exact_sync.add<0>(make_scan(1, 0));
+    exact_sync.add<1>(make_pose(1, 100));
+    exact_sync.add<0>(make_scan(1, 100));
+    exact_sync.add<1>(make_pose(1, 200));
+    exact_sync.add<0>(make_scan(1, 200));
+    ASSERT_EQ(exact.size(), 2);
+    EXPECT_EQ(exact[0].second, 100);
+    EXPECT_EQ(exact[1].second, 200);
+    EXPECT_EQ(exact_sync.get_matched_count(), 2);
+    EXPECT_EQ(exact_sync.get_dropped_count(), 1);
+
+    // The callback runs without the lock, so it may add messages itself
+    rix::core::Synchronizer<LaserScan, Pose2DStamped> *self = nullptr;
+    size_t calls = 0;
+    rix::core::Synchronizer<LaserScan, Pose2DStamped> reentrant_sync(
+        rix::core::SyncPolicy::EXACT_TIME,
+        [&](const LaserScan &scan, const Pose2DStamped &pose) {
+            if (calls++ == 0) self->add<0>(make_scan(2, 0));
+        },
+        4);
+    self = &reentrant_sync;
+    reentrant_sync.add<0>(make_scan(1, 0));
+    reentrant_sync.add<1>(make_pose(1, 0));
+    reentrant_sync.add<1>(make_pose(2, 0));
+    EXPECT_EQ(calls, 2);
+
+    // Approximate time: closest message to the pivot is selected
+    std::vector<std::pair<int32_t, int32_t>> approx;
+    rix::core::Synchronizer<LaserScan, Pose2DStamped> approx_sync(
+        rix::core::SyncPolicy::APPROXIMATE_TIME,
+        [&](const LaserScan &scan, const Pose2DStamped &pose) {
+            approx.push_back({scan.header.stamp.nsec, pose.header.stamp.nsec});
+        },
+        8, rix::util::Duration(0.0000005));
+    approx_sync.add<1>(make_pose(0, 0));
+    approx_sync.add<1>(make_pose(0, 900));
+    approx_sync.add<0>(make_scan(0, 1000));
+    EXPECT_TRUE(approx.empty());  // A closer pose may still arrive
+    approx_sync.add<1>(make_pose(0, 1050));
+    ASSERT_EQ(approx.size(), 1);
+    EXPECT_EQ(approx[0].first, 1000);
+    EXPECT_EQ(approx[0].second, 1050);
+
+    // Sets wider than the maximum interval are not emitted
+    approx_sync.add<0>(make_scan(0, 5000));
+    approx_sync.add<1>(make_pose(0, 6000));
+    EXPECT_EQ(approx.size(), 1);
+}
+
+TEST(RIXTest, PoseBuffer) {
+    rix::core::PoseBuffer buffer(4);
+    rix::msg::geometry::Pose2D pose;
+    EXPECT_FALSE(buffer.lookup(rix::util::Time(1.0), pose));
+
+    auto insert = [&](int32_t sec, float x, float y, float theta) {
+        rix::msg::geometry::Pose2DStamped msg{};
+        msg.header.stamp.sec = sec;
+        msg.pose.x = x;
+        msg.pose.y = y;
+        msg.pose.theta = theta;
+        return buffer.insert(msg);
+    };
+
+    EXPECT_TRUE(insert(1, 0.0f, 0.0f, 0.0f));
+    EXPECT_TRUE(insert(3, 2.0f, 0.0f, 0.0f));
+    EXPECT_TRUE(insert(2, 1.0f, 0.0f, 0.0f));  // Out of order
+    EXPECT_EQ(buffer.size(), 3);
+
+    ASSERT_TRUE(buffer.lookup(rix::util::Time(2.5), pose));
+    EXPECT_NEAR(pose.x, 1.5f, 1e-5);
+    EXPECT_NEAR(pose.y, 0.0f, 1e-5);
+    EXPECT_FALSE(buffer.lookup(rix::util::Time(3.5), pose));
+
+    // Quarter turn along a unit-radius arc: the midpoint lies on the arc
+    EXPECT_TRUE(insert(4, 3.0f, 0.0f, 0.0f));
+    EXPECT_TRUE(insert(5, 4.0f, 1.0f, static_cast<float>(M_PI_2)));
+    EXPECT_EQ(buffer.size(), 4);
+    EXPECT_FALSE(buffer.lookup(rix::util::Time(1.5), pose));  // Evicted
+    ASSERT_TRUE(buffer.lookup(rix::util::Time(4.5), pose));
+    EXPECT_NEAR(pose.x, 3.0f + std::sin(M_PI_4), 1e-4);
+    EXPECT_NEAR(pose.y, 1.0f - std::cos(M_PI_4), 1e-4);
+    EXPECT_NEAR(pose.theta, M_PI_4, 1e-4);
+
+    EXPECT_FALSE(insert(1, 0.0f, 0.0f, 0.0f));  // Older than the window
+}
+
+TEST(RIXTest, FixedSize) {
+    using namespace rix::msg;
+    static_assert(is_fixed_size_v<geometry::Pose2D> && fixed_size_v<geometry::Pose2D> == 12);
+    static_assert(is_fixed_size_v<standard::Time> && fixed_size_v<standard::Time> == 8);
+    static_assert(fixed_size_v<std::array<standard::Time, 3>> == 24);
+    static_assert(!is_fixed_size_v<standard::Header> && !is_fixed_size_v<geometry::Pose2DStamped>);
+    static_assert(detail::fixed_size_of<standard::Time, geometry::Pose2D, uint8_t>() == 21);
+
+    geometry::Pose2D pose;
+    pose.x = 1.0f;
+    pose.y = -2.0f;
+    pose.theta = 0.5f;
+    EXPECT_EQ(pose.size(), 12);
+
+    // Same bytes as the field by field encoding
+    std::vector<uint8_t> buffer(pose.size());
+    size_t offset = 0;
+    pose.serialize(buffer.data(), offset);
+    EXPECT_EQ(offset, 12);
+    float fields[3];
+    std::memcpy(fields, buffer.data(), sizeof(fields));
+    EXPECT_EQ(fields[0], 1.0f);
+    EXPECT_EQ(fields[1], -2.0f);
+    EXPECT_EQ(fields[2], 0.5f);
+
+    geometry::Pose2D copy;
+    offset = 0;
+    ASSERT_TRUE(copy.deserialize(buffer.data(), buffer.size(), offset));
+    EXPECT_EQ(offset, 12);
+    EXPECT_EQ(copy.x, 1.0f);
+    EXPECT_EQ(copy.y, -2.0f);
+    EXPECT_EQ(copy.theta, 0.5f);
+
+    // Truncated input fails without consuming anything
+    offset = 0;
+    EXPECT_FALSE(copy.deserialize(buffer.data(), buffer.size() - 1, offset));
+    EXPECT_EQ(offset, 0);
+    offset = 13;
+    EXPECT_FALSE(copy.deserialize(buffer.data(), buffer.size(), offset));
+}
+
+TEST(RIXTest, WireFormat) {
+    using namespace rix::msg;
+
+    // Numbers are little-endian on the wire regardless of the host
+    standard::UInt32 msg;
+    msg.data = 0x01020304;
+    std::vector<uint8_t> buffer(msg.size() + 1);
+    size_t offset = 1;  // Unaligned
+    msg.serialize(buffer.data(), offset);
+    EXPECT_EQ(buffer, (std::vector<uint8_t>{0, 0x04, 0x03, 0x02, 0x01}));
+    standard::UInt32 copy;
+    offset = 1;
+    ASSERT_TRUE(copy.deserialize(buffer.data(), buffer.size(), offset));
+    EXPECT_EQ(copy.data, 0x01020304u);
+
+    // Bulk byteswap matches a scalar swap for every element size, including
+    // unaligned data and tails shorter than a vector register
+    auto check = [](auto size_tag, size_t count) {
+        constexpr size_t S = decltype(size_tag)::value;
+        std::vector<uint8_t> data(count * S + 1), expected(count * S + 1);
+        for (size_t i = 0; i < data.size(); i++) data[i] = static_cast<uint8_t>(i * 7 + 1);
+        expected = data;
+        for (size_t e = 0; e < count; e++) {
+            std::reverse(expected.begin() + 1 + e * S, expected.begin() + 1 + (e + 1) * S);
+        }
+        detail::byteswap_array<S>(data.data() + 1, count);
+        EXPECT_EQ(data, expected) << "S=" << S << " count=" << count;
+    };
+    for (size_t count : {0, 1, 3, 8, 17, 100}) {
+        check(std::integral_constant<size_t, 2>(), count);
+        check(std::integral_constant<size_t, 4>(), count);
+        check(std::integral_constant<size_t, 8>(), count);
+    }
+    EXPECT_EQ(detail::byteswap<uint32_t>(0x01020304), 0x04030201u);
+    EXPECT_EQ(detail::byteswap(detail::byteswap(1.5)), 1.5);
+
+    // Vectors are checked in bytes, not elements
+    sensor::LaserScan scan;
+    scan.ranges = {1.0f, 2.0f};
+    buffer.resize(scan.size());
+    offset = 0;
+    scan.serialize(buffer.data(), offset);
+    std::vector<float> ranges;
+    offset = buffer.size() - 4 - 8 - 4;  // ranges count, 2 floats, empty intensities
+    EXPECT_TRUE(detail::deserialize_number_vector(ranges, buffer.data(), buffer.size() - 4, offset));
+    offset = buffer.size() - 4 - 8 - 4;
+    EXPECT_FALSE(detail::deserialize_number_vector(ranges, buffer.data(), buffer.size() - 5, offset));
+
+    // Counts that cannot fit in the input are rejected before allocating
+    std::vector<uint8_t> huge = {0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0};
+    std::vector<std::string> strings;
+    offset = 0;
+    EXPECT_FALSE(detail::deserialize_string_vector(strings, huge.data(), huge.size(), offset));
+    EXPECT_TRUE(strings.empty());
+    std::vector<mediator::PubInfo> infos;
+    offset = 0;
+    EXPECT_FALSE(detail::deserialize_message_vector(infos, huge.data(), huge.size(), offset));
+    EXPECT_TRUE(infos.empty());
+    std::string str;
+    offset = 0;
+    EXPECT_FALSE(detail::deserialize_string(str, huge.data(), huge.size(), offset));
+}
+
+TEST(RIXTest, Writer) {
+    using namespace rix::msg;
+    mediator::SubNotify notify;
+    notify.id = 42;
+    notify.publishers.resize(50);
+    for (size_t i = 0; i < notify.publishers.size(); i++) {
+        notify.publishers[i].id = i;
+        notify.publishers[i].topic_info.name = "/topic/" + std::to_string(i);
+        notify.publishers[i].endpoint.address = "127.0.0.1";
+    }
+
+    std::vector<uint8_t> expected(notify.size());
+    size_t offset = 0;
+    notify.serialize(expected.data(), offset);
+
+    // Single pass into a small buffer that grows, with a back-patched prefix
+    Writer writer(8);
+    size_t prefix = writer.skip<uint32_t>();
+    notify.serialize(writer);
+    writer.patch(prefix, static_cast<uint32_t>(writer.size() - sizeof(uint32_t)));
+    ASSERT_EQ(writer.size(), expected.size() + 4);
+    uint32_t len;
+    offset = 0;
+    ASSERT_TRUE(detail::deserialize_number(len, writer.data(), writer.size(), offset));
+    EXPECT_EQ(len, expected.size());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), writer.data() + 4));
+
+    // Reuse keeps the allocation
+    size_t capacity = writer.capacity();
+    writer.clear();
+    notify.serialize(writer);
+    EXPECT_EQ(writer.size(), expected.size());
+    EXPECT_EQ(writer.capacity(), capacity);
+
+    // Fixed-size messages and the default implementation for messages that
+    // only implement the byte array interface
+    writer.clear();
+    geometry::Pose2D pose;
+    pose.x = 2.0f;
+    pose.serialize(writer);
+    static_cast<const Message &>(notify.publishers[3].endpoint).serialize(writer);
+    EXPECT_EQ(writer.size(), 12 + notify.publishers[3].endpoint.size());
+
+    writer.consume(12);
+    mediator::Endpoint endpoint;
+    offset = 0;
+    ASSERT_TRUE(endpoint.deserialize(writer.data(), writer.size(), offset));
+    EXPECT_EQ(endpoint.address, "127.0.0.1");
+}
+
+TEST(RIXTest, GeneratedMessages) {
+    using namespace rix::msg;
+    static_assert(StaticMessage<sensor::LaserScan> && StaticMessage<mediator::SubNotify>);
+    static_assert(standard::Time::HASH != standard::Duration::HASH);
+    constexpr auto scan_hash = sensor::LaserScan::HASH;
+    EXPECT_EQ(sensor::LaserScan().hash(), scan_hash);
+
+    sensor::LaserScan scan;
+    scan.header.seq = 7;
+    scan.header.stamp.sec = 3;
+    scan.header.frame_id = "laser";
+    scan.angle_min = -1.5f;
+    scan.ranges = {1.0f, 2.0f, 3.0f};
+    scan.intensities = {0.5f};
+
+    // The static and virtual paths produce the same bytes
+    std::vector<uint8_t> buffer(scan.static_size());
+    ASSERT_EQ(buffer.size(), static_cast<const Message &>(scan).size());
+    size_t offset = 0;
+    scan.static_serialize(buffer.data(), offset);
+    std::vector<uint8_t> virtual_buffer(buffer.size());
+    offset = 0;
+    static_cast<const Message &>(scan).serialize(virtual_buffer.data(), offset);
+    EXPECT_EQ(buffer, virtual_buffer);
+
+    sensor::LaserScan::View view;
+    offset = 0;
+    ASSERT_TRUE(view.parse(buffer.data(), buffer.size(), offset));
+    EXPECT_EQ(offset, buffer.size());
+    EXPECT_EQ(view.header().seq(), 7);
+    EXPECT_EQ(view.header().stamp().sec(), 3);
+    EXPECT_EQ(view.header().frame_id(), "laser");
+    EXPECT_EQ(view.angle_min(), -1.5f);
+    ASSERT_EQ(view.ranges().size(), 3);
+    EXPECT_EQ(view.ranges()[2], 3.0f);
+    EXPECT_EQ(view.intensities().to_vector(), std::vector<float>{0.5f});
+
+    // Views check the bytes once and reject truncated input
+    for (size_t size = 0; size < buffer.size(); size++) {
+        offset = 0;
+        EXPECT_FALSE(view.parse(buffer.data(), size, offset));
+    }
+
+    mediator::SubNotify notify;
+    notify.publishers.resize(2);
+    notify.publishers[0].topic_info.name = "/a";
+    notify.publishers[1].topic_info.name = "/b";
+    notify.publishers[1].endpoint.port = 1234;
+    buffer.resize(notify.size());
+    offset = 0;
+    notify.serialize(buffer.data(), offset);
+
+    mediator::SubNotify::View notify_view;
+    offset = 0;
+    ASSERT_TRUE(notify_view.parse(buffer.data(), buffer.size(), offset));
+    std::vector<std::string_view> names;
+    for (const auto &pub : notify_view.publishers()) names.push_back(pub.topic_info().name());
+    EXPECT_EQ(names, (std::vector<std::string_view>{"/a", "/b"}));
+    auto it = notify_view.publishers().begin();
+    ++it;
+    EXPECT_EQ(it->endpoint().port(), 1234);
+}
+
+TEST(RIXTest, PartialDecoding) {
+    using namespace rix::msg;
+    sensor::LaserScan scan;
+    scan.header.seq = 7;
+    scan.header.stamp.sec = 3;
+    scan.header.stamp.nsec = 500;
+    scan.header.frame_id = "laser";
+    scan.scan_time = 0.1f;
+    scan.ranges.assign(100, 2.0f);
+    scan.intensities = {0.5f, 1.5f};
+    std::vector<uint8_t> buffer(scan.size());
+    size_t offset = 0;
+    scan.serialize(buffer.data(), offset);
+
+    // A Header consumer decodes seq and stamp and stops before frame_id
+    standard::Header header;
+    offset = 0;
+    ASSERT_TRUE(header.deserialize_prefix(buffer.data(), buffer.size(), offset, standard::Header::FIELD::FRAME_ID));
+    EXPECT_EQ(header.seq, 7);
+    EXPECT_EQ(header.stamp.nsec, 500);
+    EXPECT_TRUE(header.frame_id.empty());
+    EXPECT_EQ(offset, 12);
+
+    sensor::LaserScan prefix;
+    offset = 0;
+    ASSERT_TRUE(prefix.deserialize_prefix(buffer.data(), buffer.size(), offset, sensor::LaserScan::FIELD::RANGES));
+    EXPECT_EQ(prefix.header.frame_id, "laser");
+    EXPECT_EQ(prefix.scan_time, 0.1f);
+    EXPECT_TRUE(prefix.ranges.empty());
+
+    // seek jumps to a field without decoding the fields before it
+    offset = 0;
+    ASSERT_TRUE(sensor::LaserScan::seek(sensor::LaserScan::FIELD::SCAN_TIME, buffer.data(), buffer.size(), offset));
+    float scan_time;
+    ASSERT_TRUE(detail::deserialize_number(scan_time, buffer.data(), buffer.size(), offset));
+    EXPECT_EQ(scan_time, 0.1f);
+
+    offset = 0;
+    ASSERT_TRUE(sensor::LaserScan::seek(sensor::LaserScan::FIELD::INTENSITIES, buffer.data(), buffer.size(), offset));
+    std::vector<float> intensities;
+    ASSERT_TRUE(detail::deserialize_number_vector(intensities, buffer.data(), buffer.size(), offset));
+    EXPECT_EQ(intensities, scan.intensities);
+
+    offset = 0;
+    ASSERT_TRUE(sensor::LaserScan::seek(sensor::LaserScan::FIELD_COUNT, buffer.data(), buffer.size(), offset));
+    EXPECT_EQ(offset, buffer.size());
+    offset = 0;
+    EXPECT_FALSE(sensor::LaserScan::seek(sensor::LaserScan::FIELD_COUNT + 1, buffer.data(), buffer.size(), offset));
+    for (size_t size = 0; size < buffer.size(); size++) {
+        offset = 0;
+        EXPECT_FALSE(sensor::LaserScan::skip(buffer.data(), size, offset));
+    }
+
+    mediator::SubNotify notify;
+    notify.publishers.resize(2);
+    notify.publishers[1].topic_info.name = "/b";
+    buffer.resize(notify.size());
+    offset = 0;
+    notify.serialize(buffer.data(), offset);
+    offset = 0;
+    ASSERT_TRUE(mediator::SubNotify::skip(buffer.data(), buffer.size(), offset));
+    EXPECT_EQ(offset, buffer.size());
+}
+
+TEST(RIXTest, Service) {
+    auto server_map = std::make_shared<std::map<rix::ipc::Endpoint, NiceMock<MockServer> *>>();
+    auto server_mutex = std::make_shared<std::mutex>();
+    NiceMock<MockClient>::address = "127.0.0.1";
+    NiceMock<MockClient>::server_map = server_map;
+    NiceMock<MockServer>::server_map = server_map;
+    NiceMock<MockClient>::server_mutex = server_mutex;
+    NiceMock<MockServer>::server_mutex = server_mutex;
+
+    {
+        rix::ipc::Endpoint rixhub_endpoint("127.0.0.1", rix::core::RIXHUB_PORT);
+        auto mediator = std::make_shared<rix::core::Mediator>(rixhub_endpoint, server_factory, client_factory);
+        ASSERT_TRUE(mediator->ok());
+        std::thread rixhub_thread([&]() { mediator->spin(); });
+
+        {
+            auto node = std::make_shared<rix::core::Node>("test", rixhub_endpoint, server_factory, client_factory);
+            EXPECT_TRUE(node->ok());
+
+            using rix::msg::standard::UInt32;
+            auto srv = node->create_service<UInt32, UInt32>(
+                "/add_one",
+                [](const UInt32 &req, UInt32 &res) {
+                    res.data = req.data + 1;
+                    return req.data != 0;
+                },
+                rix::ipc::Endpoint("127.0.0.1", 2));
+            ASSERT_TRUE(srv->ok());
+
+            // A second service with the same name is rejected
+            auto dup = node->create_service<UInt32, UInt32>(
+                "/add_one", [](const UInt32 &, UInt32 &) { return true; }, rix::ipc::Endpoint("127.0.0.1", 3));
+            EXPECT_FALSE(dup->ok());
+
+            auto client = node->create_client<UInt32, UInt32>("/add_one");
+            ASSERT_TRUE(client->ok());
+
+            node->spin_once();  // Service accepts the client connection
+            EXPECT_EQ(srv->get_client_count(), 1);
+            EXPECT_TRUE(client->is_connected());
+
+            // Pipeline several requests before spinning
+            std::vector<std::future<std::optional<UInt32>>> futures;
+            for (uint32_t i = 0; i < 4; i++) {
+                UInt32 req;
+                req.data = i;
+                futures.push_back(client->call_async<UInt32, UInt32>(req));
+            }
+            EXPECT_EQ(client->get_pending_count(), 4);
+
+            node->spin_once();  // Service handles requests, client reads responses
+            node->spin_once();
+            EXPECT_EQ(client->get_pending_count(), 0);
+
+            for (uint32_t i = 0; i < futures.size(); i++) {
+                ASSERT_EQ(futures[i].wait_for(std::chrono::seconds(0)), std::future_status::ready);
+                auto res = futures[i].get();
+                if (i == 0) {
+                    EXPECT_FALSE(res.has_value());
+                } else {
+                    ASSERT_TRUE(res.has_value());
+                    EXPECT_EQ(res->data, i + 1);
+                }
+            }
+
+            // Type mismatch fails without sending
+            auto bad = client->call_async<rix::msg::standard::Header, UInt32>(rix::msg::standard::Header());
+            EXPECT_FALSE(bad.get().has_value());
+
+            // A call that times out is cancelled, and its late response is ignored
+            UInt32 late_req, late_res;
+            late_req.data = 7;
+            EXPECT_FALSE(client->call(late_req, late_res, rix::util::Duration(0.05)));
+            EXPECT_EQ(client->get_pending_count(), 0);
+            node->spin_once();  // Service handles the request, client drops the response
+            node->spin_once();
+            EXPECT_EQ(client->get_pending_count(), 0);
+
+            // call() may be used while another thread spins the node
+            std::atomic<bool> spinning(true);
+            std::thread spin_thread([&]() {
+                while (spinning) node->spin_once();
+            });
+            for (uint32_t i = 1; i <= 20; i++) {
+                UInt32 req, res;
+                req.data = i;
+                EXPECT_TRUE(client->call(req, res)) << i;
+                EXPECT_EQ(res.data, i + 1);
+            }
+            spinning = false;
+            spin_thread.join();
+            EXPECT_EQ(client->get_pending_count(), 0);
+
+            // A connect that does not complete fails the pending requests, so
+            // that the service is looked up again
+            auto stalled_node =
+                std::make_shared<rix::core::Node>("stalled", rixhub_endpoint, server_factory, client_factory);
+            auto stalled = stalled_node->create_service<UInt32, UInt32>(
+                "/stalled", [](const UInt32 &, UInt32 &) { return true; }, rix::ipc::Endpoint("127.0.0.1", 6));
+            ASSERT_TRUE(stalled->ok());
+            auto stalled_client = node->create_client<UInt32, UInt32>("/stalled");
+            auto stalled_future = stalled_client->call_async<UInt32, UInt32>(UInt32());
+            auto deadline = rix::util::Time::now() + rix::util::Duration(3.0);
+            while (stalled_future.wait_for(std::chrono::milliseconds(10)) != std::future_status::ready &&
+                   rix::util::Time::now() < deadline) {
+                node->spin_once();
+            }
+            ASSERT_EQ(stalled_future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+            EXPECT_FALSE(stalled_future.get().has_value());
+            EXPECT_FALSE(stalled_client->is_connected());
+        }
+
+        mediator->shutdown();
+        rixhub_thread.join();
+    }
+
+    NiceMock<MockClient>::server_map = nullptr;
+    NiceMock<MockServer>::server_map = nullptr;
+    NiceMock<MockClient>::server_mutex = nullptr;
+    NiceMock<MockServer>::server_mutex = nullptr;
+}
+
+TEST(RIXTest, Multiplexing) {
+    auto server_map = std::make_shared<std::map<rix::ipc::Endpoint, NiceMock<MockServer> *>>();
+    auto server_mutex = std::make_shared<std::mutex>();
+    NiceMock<MockClient>::address = "127.0.0.1";
+    NiceMock<MockClient>::server_map = server_map;
+    NiceMock<MockServer>::server_map = server_map;
+    NiceMock<MockClient>::server_mutex = server_mutex;
+    NiceMock<MockServer>::server_mutex = server_mutex;
+
+    {
+        rix::ipc::Endpoint rixhub_endpoint("127.0.0.1", rix::core::RIXHUB_PORT);
+        auto mediator = std::make_shared<rix::core::Mediator>(rixhub_endpoint, server_factory, client_factory);
+        ASSERT_TRUE(mediator->ok());
+        std::thread rixhub_thread([&]() { mediator->spin(); });
+
+        {
+            auto node1 = std::make_shared<rix::core::Node>("test", rixhub_endpoint, server_factory, client_factory);
+            auto node2 = std::make_shared<rix::core::Node>("test", rixhub_endpoint, server_factory, client_factory);
+            auto transport1 = node1->enable_multiplexing(rix::ipc::Endpoint("127.0.0.1", 10));
+            auto transport2 = node2->enable_multiplexing(rix::ipc::Endpoint("127.0.0.1", 11));
+            ASSERT_TRUE(transport1 && transport2);
+
+            // node1 publishes three topics and node2 publishes one
+            const size_t topics = 3;
+            std::vector<std::shared_ptr<rix::core::Publisher>> pubs;
+            for (size_t i = 0; i < topics; i++) {
+                pubs.push_back(node1->create_publisher<rix::msg::standard::UInt32>("/mux" + std::to_string(i)));
+                ASSERT_TRUE(pubs.back()->ok());
+            }
+            auto pub2 = node2->create_publisher<rix::msg::standard::UInt32>("/mux_back");
+            ASSERT_TRUE(pub2->ok());
+
+            // node2 subscribes to all topics of node1. Each subscriber reads
+            // its notification from rixhub and subscribes through the
+            // transport, which opens a single connection to node1.
+            std::vector<std::shared_ptr<rix::core::Subscriber>> subs;
+            std::vector<uint32_t> received(topics, 0);
+            for (size_t i = 0; i < topics; i++) {
+                subs.push_back(node2->create_subscriber<rix::msg::standard::UInt32>(
+                    "/mux" + std::to_string(i),
+                    [&received, i](const rix::msg::standard::UInt32 &msg) { received[i] = msg.data; },
+                    rix::ipc::Endpoint("127.0.0.1", 20 + i)));
+                ASSERT_TRUE(subs.back()->ok());
+                rix::util::sleep_for(rix::util::Duration(0.25));
+                node2->spin_once();
+            }
+            node1->spin_once();  // Accept the connection from node2
+            node2->spin_once();  // Send HELLO and SUBSCRIBE frames
+            node1->spin_once();  // Learn that the peer is node2 and add the routes
+
+            // node1 subscribes to node2's topic, which reuses the connection
+            uint32_t received_back = 0;
+            auto sub1 = node1->create_subscriber<rix::msg::standard::UInt32>(
+                "/mux_back", [&](const rix::msg::standard::UInt32 &msg) { received_back = msg.data; },
+                rix::ipc::Endpoint("127.0.0.1", 30));
+            rix::util::sleep_for(rix::util::Duration(0.25));
+            node1->spin_once();
+            node2->spin_once();
+
+            EXPECT_EQ(transport1->get_connection_count(), 1);
+            EXPECT_EQ(transport2->get_connection_count(), 1);
+            for (size_t i = 0; i < topics; i++) {
+                EXPECT_EQ(pubs[i]->get_subscriber_count(), 1);
+                EXPECT_EQ(subs[i]->get_publisher_count(), 1);
+            }
+            EXPECT_EQ(pub2->get_subscriber_count(), 1);
+            EXPECT_EQ(sub1->get_publisher_count(), 1);
+
+            // Messages on all topics are written together at the end of the spin
+            for (size_t i = 0; i < topics; i++) {
+                rix::msg::standard::UInt32 msg;
+                msg.data = 100 + i;
+                pubs[i]->publish(msg);
+            }
+            rix::msg::standard::UInt32 back;
+            back.data = 7;
+            pub2->publish(back);
+
+            node1->spin_once();  // Flush
+            node2->spin_once();  // Demultiplex and flush
+            node1->spin_once();
+            for (size_t i = 0; i < topics; i++) {
+                EXPECT_EQ(received[i], 100 + i);
+            }
+            EXPECT_EQ(received_back, 7);
+
+            // Destroying a subscriber unsubscribes its channel
+            subs[0]->shutdown();
+            subs[0] = nullptr;
+            node2->spin_once();  // Remove the subscriber and send UNSUBSCRIBE
+            node1->spin_once();
+            EXPECT_EQ(pubs[0]->get_subscriber_count(), 0);
+            EXPECT_EQ(pubs[1]->get_subscriber_count(), 1);
+        }
+
+        mediator->shutdown();
+        rixhub_thread.join();
+    }
+
+    NiceMock<MockClient>::server_map = nullptr;
+    NiceMock<MockServer>::server_map = nullptr;
+    NiceMock<MockClient>::server_mutex = nullptr;
+    NiceMock<MockServer>::server_mutex = nullptr;
+}
+
+TEST(RIXTest, Batching) {
+    auto server_map = std::make_shared<std::map<rix::ipc::Endpoint, NiceMock<MockServer> *>>();
+    auto server_mutex = std::make_shared<std::mutex>();
+    NiceMock<MockClient>::address = "127.0.0.1";
+    NiceMock<MockClient>::server_map = server_map;
+    NiceMock<MockServer>::server_map = server_map;
+    NiceMock<MockClient>::server_mutex = server_mutex;
+    NiceMock<MockServer>::server_mutex = server_mutex;
+
+    {
+        rix::ipc::Endpoint rixhub_endpoint("127.0.0.1", rix::core::RIXHUB_PORT);
+        auto mediator = std::make_shared<rix::core::Mediator>(rixhub_endpoint, server_factory, client_factory);
+        ASSERT_TRUE(mediator->ok());
+        std::thread rixhub_thread([&]() { mediator->spin(); });
+
+        {
+            auto node = std::make_shared<rix::core::Node>("test", rixhub_endpoint, server_factory, client_factory);
+            EXPECT_TRUE(node->ok());
+
+            std::vector<uint32_t> received;
+            auto sub = node->create_subscriber<rix::msg::standard::UInt32>(
+                "/test_topic", [&](const rix::msg::standard::UInt32 &msg) { received.push_back(msg.data); },
+                rix::ipc::Endpoint("127.0.0.1", 2));
+            auto pub = node->create_publisher<rix::msg::standard::UInt32>("/test_topic",
+                                                                          rix::ipc::Endpoint("127.0.0.1", 3));
+            rix::util::sleep_for(rix::util::Duration(0.25));
+            node->spin_once();  // Subscriber calls connect
+            node->spin_once();  // Publisher calls accept
+            ASSERT_EQ(pub->get_subscriber_count(), 1);
+
+            // Messages stay buffered until the latency has elapsed
+            pub->set_batching(96, rix::util::Duration(10.0));
+            rix::msg::standard::UInt32 msg;
+            for (uint32_t i = 0; i < 3; i++) {
+                msg.data = i;
+                pub->publish(msg);
+            }
+            node->spin_once();
+            EXPECT_TRUE(received.empty());
+
+            // All buffered messages are read in a single spin once written
+            pub->flush();
+            node->spin_once();
+            EXPECT_EQ(received, std::vector<uint32_t>({0, 1, 2}));
+
+            // Filling the buffer (12 bytes per frame) writes it immediately
+            received.clear();
+            for (uint32_t i = 0; i < 8; i++) {
+                msg.data = i;
+                pub->publish(msg);
+            }
+            node->spin_once();
+            EXPECT_EQ(received.size(), 8);
+
+            // With zero latency, the buffer is written at the end of the spin
+            received.clear();
+            pub->set_batching(96, rix::util::Duration(0.0));
+            pub->publish(msg);
+            pub->publish(msg);
+            node->spin_once();  // Publisher writes at the end of the iteration
+            EXPECT_TRUE(received.empty());
+            node->spin_once();  // Subscriber reads
+            EXPECT_EQ(received.size(), 2);
+
+            // publish_batch writes a burst at once, and each message gets a callback
+            received.clear();
+            pub->set_batching(0);
+            std::vector<rix::msg::standard::UInt32> burst(10);
+            for (uint32_t i = 0; i < burst.size(); i++) burst[i].data = i;
+            pub->publish_batch<rix::msg::standard::UInt32>(burst);
+            node->spin_once();
+            EXPECT_EQ(received, std::vector<uint32_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+        }
+
+        mediator->shutdown();
+        rixhub_thread.join();
+    }
+
+    NiceMock<MockClient>::server_map = nullptr;
+    NiceMock<MockServer>::server_map = nullptr;
+    NiceMock<MockClient>::server_mutex = nullptr;
+    NiceMock<MockServer>::server_mutex = nullptr;
+}
+
+TEST(RIXTest, MessagePool) {
+    rix::core::MessagePool<rix::msg::standard::UInt32> pool(2);
+    auto a = pool.acquire();
+    auto b = pool.acquire();
+    auto c = pool.acquire();  // Pool is full, c is not kept
+    EXPECT_EQ(pool.size(), 2);
+    EXPECT_NE(a, b);
+    EXPECT_NE(a, c);
+    rix::msg::standard::UInt32 *released = b.get();
+    b.reset();
+    EXPECT_EQ(pool.acquire().get(), released);
+
+    auto server_map = std::make_shared<std::map<rix::ipc::Endpoint, NiceMock<MockServer> *>>();
+    auto server_mutex = std::make_shared<std::mutex>();
+    NiceMock<MockClient>::address = "127.0.0.1";
+    NiceMock<MockClient>::server_map = server_map;
+    NiceMock<MockServer>::server_map = server_map;
+    NiceMock<MockClient>::server_mutex = server_mutex;
+    NiceMock<MockServer>::server_mutex = server_mutex;
+
+    {
+        rix::ipc::Endpoint rixhub_endpoint("127.0.0.1", rix::core::RIXHUB_PORT);
+        auto mediator = std::make_shared<rix::core::Mediator>(rixhub_endpoint, server_factory, client_factory);
+        ASSERT_TRUE(mediator->ok());
+        std::thread rixhub_thread([&]() { mediator->spin(); });
+
+        {
+            auto node = std::make_shared<rix::core::Node>("test", rixhub_endpoint, server_factory, client_factory);
+            EXPECT_TRUE(node->ok());
+
+            using rix::msg::sensor::LaserScan;
+            std::vector<const float *> ranges;
+            auto sub = node->create_subscriber<LaserScan>(
+                "/scan", [&](const LaserScan &msg) { ranges.push_back(msg.ranges.data()); },
+                rix::ipc::Endpoint("127.0.0.1", 2));
+            std::vector<std::shared_ptr<const LaserScan>> kept;
+            auto shared_sub = node->create_subscriber<LaserScan>(
+                "/scan", [&](std::shared_ptr<const LaserScan> msg) { kept.push_back(msg); },
+                rix::ipc::Endpoint("127.0.0.1", 3));
+            auto pub = node->create_publisher<LaserScan>("/scan", rix::ipc::Endpoint("127.0.0.1", 4));
+            rix::util::sleep_for(rix::util::Duration(0.25));
+            node->spin_once();  // Subscribers call connect
+            node->spin_once();  // Publisher calls accept
+            ASSERT_EQ(pub->get_subscriber_count(), 2);
+
+            LaserScan scan;
+            scan.ranges.assign(64, 1.0f);
+            for (int i = 0; i < 3; i++) {
+                scan.ranges[0] = i;
+                pub->publish(scan);
+                node->spin_once();
+            }
+
+            // The reference callback receives the same message each time, and
+            // its ranges keep their allocation
+            ASSERT_EQ(ranges.size(), 3);
+            EXPECT_EQ(ranges[0], ranges[1]);
+            EXPECT_EQ(ranges[1], ranges[2]);
+
+            // Messages kept by the callback are not reused
+            ASSERT_EQ(kept.size(), 3);
+            EXPECT_NE(kept[0], kept[1]);
+            EXPECT_NE(kept[1], kept[2]);
+            for (int i = 0; i < 3; i++) EXPECT_EQ(kept[i]->ranges[0], i);
+
+            // Released messages return to the pool
+            const LaserScan *first = kept[0].get();
+            kept.clear();
+            pub->publish(scan);
+            node->spin_once();
+            ASSERT_EQ(kept.size(), 1);
+            EXPECT_EQ(kept[0].get(), first);
+        }
+
+        mediator->shutdown();
+        rixhub_thread.join();
+    }
+
+    NiceMock<MockClient>::server_map = nullptr;
+    NiceMock<MockServer>::server_map = nullptr;
+    NiceMock<MockClient>::server_mutex = nullptr;
+    NiceMock<MockServer>::server_mutex = nullptr;
+}
+
+TEST(RIXTest, QuantizedEncoding) {
+    using rix::core::Encoding;
+    using rix::msg::sensor::LaserScan;
+    const float inf = std::numeric_limits<float>::infinity();
+
+    LaserScan scan;
+    scan.header.frame_id = "laser";
+    scan.angle_increment = 0.01f;
+    scan.ranges = {0.0f, 0.0004f, 0.0006f, 1.2346f, 30.0f, inf, NAN, -1.0f};
+    for (int i = 0; i < 29; i++) scan.ranges.push_back(i * 0.731f);  // Not a multiple of the SIMD width
+    for (size_t i = 0; i < scan.ranges.size(); i++) scan.intensities.push_back(i * 10.0f);
+
+    rix::msg::Writer raw, quantized;
+    Encoding<LaserScan>::encode(rix::core::ENCODING::RAW, scan, raw);
+    Encoding<LaserScan>::encode(rix::core::ENCODING::QUANTIZED, scan, quantized);
+    EXPECT_EQ(raw.size() - quantized.size(), 5 * scan.ranges.size() - 2 * sizeof(float));
+
+    // The encoded bytes are a QuantizedLaserScan
+    rix::msg::sensor::QuantizedLaserScan::View view;
+    size_t offset = 0;
+    ASSERT_TRUE(view.parse(quantized.data(), quantized.size(), offset));
+    EXPECT_EQ(offset, quantized.size());
+    EXPECT_EQ(view.range_scale(), 0.001f);
+    EXPECT_EQ(view.ranges()[3], 1235);
+    EXPECT_EQ(view.ranges()[5], rix::msg::detail::QUANTIZED_U16_INVALID);
+
+    LaserScan decoded;
+    offset = 0;
+    ASSERT_TRUE(Encoding<LaserScan>::decode(rix::core::ENCODING::QUANTIZED, decoded, quantized.data(),
+                                            quantized.size(), offset));
+    EXPECT_EQ(decoded.header.frame_id, "laser");
+    EXPECT_EQ(decoded.angle_increment, 0.01f);
+    ASSERT_EQ(decoded.ranges.size(), scan.ranges.size());
+    ASSERT_EQ(decoded.intensities.size(), scan.intensities.size());
+    EXPECT_EQ(decoded.ranges[5], inf);
+    EXPECT_EQ(decoded.ranges[6], inf);
+    EXPECT_EQ(decoded.ranges[7], 0.0f);
+    for (size_t i = 0; i < scan.ranges.size(); i++) {
+        if (i < 5 || i > 7) {
+            EXPECT_NEAR(decoded.ranges[i], scan.ranges[i], 0.0005f + 1e-6f) << i;
+        }
+        EXPECT_NEAR(decoded.intensities[i], scan.intensities[i], 360.0f / 255 / 2 + 1e-3f) << i;
+    }
+
+    // Ranges beyond 65.534 m coarsen the scale instead of saturating
+    scan.ranges[4] = 100.0f;
+    quantized.clear();
+    Encoding<LaserScan>::encode(rix::core::ENCODING::QUANTIZED, scan, quantized);
+    offset = 0;
+    ASSERT_TRUE(Encoding<LaserScan>::decode(rix::core::ENCODING::QUANTIZED, decoded, quantized.data(),
+                                            quantized.size(), offset));
+    EXPECT_NEAR(decoded.ranges[4], 100.0f, 100.0f / 65534);
+
+    // Truncated input is rejected
+    for (size_t size = 0; size < quantized.size(); size++) {
+        offset = 0;
+        EXPECT_FALSE(Encoding<LaserScan>::decode(rix::core::ENCODING::QUANTIZED, decoded, quantized.data(), size,
+                                                 offset));
+    }
+
+    auto server_map = std::make_shared<std::map<rix::ipc::Endpoint, NiceMock<MockServer> *>>();
+    auto server_mutex = std::make_shared<std::mutex>();
+    NiceMock<MockClient>::address = "127.0.0.1";
+    NiceMock<MockClient>::server_map = server_map;
+    NiceMock<MockServer>::server_map = server_map;
+    NiceMock<MockClient>::server_mutex = server_mutex;
+    NiceMock<MockServer>::server_mutex = server_mutex;
+
+    {
+        rix::ipc::Endpoint rixhub_endpoint("127.0.0.1", rix::core::RIXHUB_PORT);
+        auto mediator = std::make_shared<rix::core::Mediator>(rixhub_endpoint, server_factory, client_factory);
+        ASSERT_TRUE(mediator->ok());
+        std::thread rixhub_thread([&]() { mediator->spin(); });
+
+        {
+            auto node = std::make_shared<rix::core::Node>("test", rixhub_endpoint, server_factory, client_factory);
+            EXPECT_TRUE(node->ok());
+
+            // The subscriber learns the encoding of the publisher from the Mediator
+            node->set_encoding("/scan", rix::core::ENCODING::QUANTIZED);
+            LaserScan received;
+            auto sub = node->create_subscriber<LaserScan>(
+                "/scan", [&](const LaserScan &msg) { received = msg; }, rix::ipc::Endpoint("127.0.0.1", 2));
+            auto pub = node->create_publisher<LaserScan>("/scan", rix::ipc::Endpoint("127.0.0.1", 3));
+            rix::util::sleep_for(rix::util::Duration(0.25));
+            node->spin_once();  // Subscriber calls connect
+            node->spin_once();  // Publisher calls accept
+            ASSERT_EQ(pub->get_subscriber_count(), 1);
+
+            scan.ranges[4] = 30.0f;
+            pub->publish(scan);
+            node->spin_once();
+            ASSERT_EQ(received.ranges.size(), scan.ranges.size());
+            EXPECT_EQ(received.header.frame_id, "laser");
+            EXPECT_NEAR(received.ranges[3], 1.2346f, 0.0005f);
+            EXPECT_EQ(received.ranges[5], inf);
+            EXPECT_NEAR(received.ranges[4], 30.0f, 0.0005f);
+        }
+
+        mediator->shutdown();
+        rixhub_thread.join();
+    }
+
+    NiceMock<MockClient>::server_map = nullptr;
+    NiceMock<MockServer>::server_map = nullptr;
+    NiceMock<MockClient>::server_mutex = nullptr;
+    NiceMock<MockServer>::server_mutex = nullptr;
+}
+
+TEST(RIXTest, DeltaEncoding) {
+    using rix::msg::geometry::Pose2DStamped;
+    auto serialize = [](const Pose2DStamped &msg) {
+        std::vector<uint8_t> bytes(msg.size());
+        size_t offset = 0;
+        msg.serialize(bytes.data(), offset);
+        return bytes;
+    };
+
+    rix::core::DeltaEncoder encoder(4);
+    rix::core::DeltaDecoder decoder;
+    Pose2DStamped msg;
+    msg.header.frame_id = "map";
+    rix::msg::Writer frame;
+    std::vector<size_t> sizes;
+    for (uint32_t i = 0; i < 8; i++) {
+        msg.header.seq = i;
+        msg.pose.x = 1.0f + i * 0.001f;
+        auto bytes = serialize(msg);
+        frame.clear();
+        encoder.encode(bytes.data(), bytes.size(), frame);
+        sizes.push_back(frame.size());
+        EXPECT_EQ(frame.data()[0], i % 4 == 0 ? rix::core::delta_frame::KEYFRAME : rix::core::delta_frame::DELTA);
+        ASSERT_TRUE(decoder.decode(frame.data(), frame.size()));
+        EXPECT_EQ(std::vector<uint8_t>(decoder.data(), decoder.data() + decoder.size()), bytes);
+    }
+    EXPECT_LT(sizes[1], sizes[0] / 2);
+
+    // A change of size sends a keyframe
+    msg.header.frame_id = "odom_frame";
+    auto bytes = serialize(msg);
+    frame.clear();
+    encoder.encode(bytes.data(), bytes.size(), frame);
+    EXPECT_EQ(frame.data()[0], rix::core::delta_frame::KEYFRAME);
+    ASSERT_TRUE(decoder.decode(frame.data(), frame.size()));
+
+    // Invalid deltas are rejected and leave the previous message intact
+    msg.pose.theta = 2.0f;
+    auto next = serialize(msg);
+    frame.clear();
+    encoder.encode(next.data(), next.size(), frame);
+    ASSERT_EQ(frame.data()[0], rix::core::delta_frame::DELTA);
+    EXPECT_FALSE(rix::core::DeltaDecoder().decode(frame.data(), frame.size()));
+    EXPECT_FALSE(decoder.decode(frame.data(), frame.size() - 1));
+    EXPECT_EQ(std::vector<uint8_t>(decoder.data(), decoder.data() + decoder.size()), bytes);
+    ASSERT_TRUE(decoder.decode(frame.data(), frame.size()));
+    EXPECT_EQ(std::vector<uint8_t>(decoder.data(), decoder.data() + decoder.size()), next);
+
+    auto server_map = std::make_shared<std::map<rix::ipc::Endpoint, NiceMock<MockServer> *>>();
+    auto server_mutex = std::make_shared<std::mutex>();
+    NiceMock<MockClient>::address = "127.0.0.1";
+    NiceMock<MockClient>::server_map = server_map;
+    NiceMock<MockServer>::server_map = server_map;
+    NiceMock<MockClient>::server_mutex = server_mutex;
+    NiceMock<MockServer>::server_mutex = server_mutex;
+
+    {
+        rix::ipc::Endpoint rixhub_endpoint("127.0.0.1", rix::core::RIXHUB_PORT);
+        auto mediator = std::make_shared<rix::core::Mediator>(rixhub_endpoint, server_factory, client_factory);
+        ASSERT_TRUE(mediator->ok());
+        std::thread rixhub_thread([&]() { mediator->spin(); });
+
+        {
+            // node1 publishes over its own connection, node2 over its Transport
+            auto node1 = std::make_shared<rix::core::Node>("test", rixhub_endpoint, server_factory, client_factory);
+            auto node2 = std::make_shared<rix::core::Node>("test", rixhub_endpoint, server_factory, client_factory);
+            ASSERT_TRUE(node2->enable_multiplexing(rix::ipc::Endpoint("127.0.0.1", 10)));
+            node1->set_encoding("/pose", rix::core::ENCODING::DELTA);
+            node2->set_encoding("/pose_mux", rix::core::ENCODING::DELTA);
+            auto pub = node1->create_publisher<Pose2DStamped>("/pose", rix::ipc::Endpoint("127.0.0.1", 3));
+            auto pub_mux = node2->create_publisher<Pose2DStamped>("/pose_mux");
+
+            std::vector<Pose2DStamped> received, received_mux;
+            auto sub = node1->create_subscriber<Pose2DStamped>(
+                "/pose", [&](const Pose2DStamped &msg) { received.push_back(msg); },
+                rix::ipc::Endpoint("127.0.0.1", 4));
+            rix::util::sleep_for(rix::util::Duration(0.25));
+            node1->spin_once();  // Subscriber connects
+            auto sub_mux = node1->create_subscriber<Pose2DStamped>(
+                "/pose_mux", [&](const Pose2DStamped &msg) { received_mux.push_back(msg); },
+                rix::ipc::Endpoint("127.0.0.1", 5));
+            rix::util::sleep_for(rix::util::Duration(0.25));
+            node1->spin_once();  // Publisher accepts, subscriber connects through the Transport
+            node2->spin_once();  // Transport accepts
+            node1->spin_once();  // Transport sends HELLO and SUBSCRIBE
+            node2->spin_once();  // Transport adds the route
+            ASSERT_EQ(pub->get_subscriber_count(), 1);
+            ASSERT_EQ(pub_mux->get_subscriber_count(), 1);
+
+            for (uint32_t i = 0; i < 5; i++) {
+                msg.header.seq = i;
+                msg.pose.y = i * 0.5f;
+                pub->publish(msg);
+                pub_mux->publish(msg);
+                node2->spin_once();  // Transport writes
+                node1->spin_once();  // Subscribers read
+            }
+            ASSERT_EQ(received.size(), 5);
+            ASSERT_EQ(received_mux.size(), 5);
+            for (uint32_t i = 0; i < 5; i++) {
+                EXPECT_EQ(received[i].header.seq, i);
+                EXPECT_EQ(received[i].pose.y, i * 0.5f);
+                EXPECT_EQ(received[i].header.frame_id, "odom_frame");
+                EXPECT_EQ(received_mux[i].header.seq, i);
+                EXPECT_EQ(received_mux[i].pose.y, i * 0.5f);
+            }
+        }
+
+        mediator->shutdown();
+        rixhub_thread.join();
+    }
+
+    NiceMock<MockClient>::server_map = nullptr;
+    NiceMock<MockServer>::server_map = nullptr;
+    NiceMock<MockClient>::server_mutex = nullptr;
+    NiceMock<MockServer>::server_mutex = nullptr;
+}
+
+TEST(RIXTest, Stats) {
+    using rix::core::LatencyHistogram;
+    for (uint64_t value : {0ull, 31ull, 32ull, 1000ull, 123456789ull}) {
+        uint64_t lower = LatencyHistogram::lower_bound(LatencyHistogram::index_of(value));
+        EXPECT_LE(lower, value);
+        EXPECT_LE(value - lower, lower / 16);
+    }
+    EXPECT_EQ(LatencyHistogram::index_of(~0ull), LatencyHistogram::BUCKET_COUNT - 1);
+    LatencyHistogram histogram;
+    for (int64_t i = 1; i <= 100; i++) histogram.record(i * 1000);
+    histogram.record(-5);
+    auto latency = histogram.snapshot();
+    EXPECT_EQ(latency.count, 101);
+    EXPECT_EQ(latency.max, 100000);
+    EXPECT_NEAR(latency.percentile(0.5), 50000, 50000 / 16);
+    EXPECT_EQ(latency.percentile(0.0), 0);
+
+    auto server_map = std::make_shared<std::map<rix::ipc::Endpoint, NiceMock<MockServer> *>>();
+    auto server_mutex = std::make_shared<std::mutex>();
+    NiceMock<MockClient>::address = "127.0.0.1";
+    NiceMock<MockClient>::server_map = server_map;
+    NiceMock<MockServer>::server_map = server_map;
+    NiceMock<MockClient>::server_mutex = server_mutex;
+    NiceMock<MockServer>::server_mutex = server_mutex;
+
+    {
+        rix::ipc::Endpoint rixhub_endpoint("127.0.0.1", rix::core::RIXHUB_PORT);
+        auto mediator = std::make_shared<rix::core::Mediator>(rixhub_endpoint, server_factory, client_factory);
+        ASSERT_TRUE(mediator->ok());
+        std::thread rixhub_thread([&]() { mediator->spin(); });
+
+        {
+            using rix::msg::geometry::Pose2DStamped;
+            auto node = std::make_shared<rix::core::Node>("test", rixhub_endpoint, server_factory, client_factory);
+            size_t received = 0;
+            bool slow = false;
+            auto sub = node->create_subscriber<Pose2DStamped>(
+                "/pose",
+                [&](const Pose2DStamped &msg) {
+                    received++;
+                    if (slow) rix::util::sleep_for(rix::util::Duration(0.002));
+                },
+                rix::ipc::Endpoint("127.0.0.1", 2));
+            auto pub = node->create_publisher<Pose2DStamped>("/pose", rix::ipc::Endpoint("127.0.0.1", 3));
+            rix::util::sleep_for(rix::util::Duration(0.25));
+            node->spin_once();  // Subscriber calls connect
+            node->spin_once();  // Publisher calls accept
+            ASSERT_EQ(pub->get_subscriber_count(), 1);
+
+            // Stamped one millisecond in the past
+            Pose2DStamped msg;
+            msg.header.stamp = (rix::util::Time::now() - rix::util::Duration(0.001)).to_msg();
+            for (int i = 0; i < 3; i++) pub->publish(msg);
+            node->spin_once();
+            ASSERT_EQ(received, 3);
+
+            auto stats = node->stats();
+            ASSERT_EQ(stats.size(), 2);
+            const auto &pub_stats = stats[0];
+            const auto &sub_stats = stats[1];
+            EXPECT_TRUE(pub_stats.publisher);
+            EXPECT_EQ(pub_stats.topic, "/pose");
+            EXPECT_EQ(pub_stats.messages, 3);
+            EXPECT_EQ(pub_stats.bytes, 3 * (rix::core::data_frame::HEADER_SIZE + msg.size()));
+            EXPECT_EQ(pub_stats.write_failures, 0);
+            EXPECT_FALSE(sub_stats.publisher);
+            EXPECT_EQ(sub_stats.messages, 3);
+            EXPECT_EQ(sub_stats.bytes, pub_stats.bytes);
+            EXPECT_EQ(sub_stats.drops, 0);
+            EXPECT_EQ(sub_stats.lost, 0);
+            EXPECT_EQ(sub_stats.duplicates + sub_stats.reordered, 0);
+            EXPECT_EQ(sub_stats.latency.count, 3);
+            EXPECT_GE(sub_stats.latency.percentile(0.5), 900'000);
+
+            // The messages share a stamp, so the callback has no budget
+            auto callbacks = node->callback_stats();
+            ASSERT_EQ(callbacks.size(), 1);
+            EXPECT_EQ(callbacks[0].kind, rix::core::CallbackStats::SUBSCRIBER);
+            EXPECT_EQ(callbacks[0].name, "/pose");
+            EXPECT_EQ(callbacks[0].execution.count, 3);
+            EXPECT_EQ(callbacks[0].period.count, 2);
+            EXPECT_EQ(callbacks[0].overruns, 0);
+            EXPECT_EQ(sub_stats.delivery.count, 0);
+
+            // Timestamped frames carry the send time after the sequence number
+            const uint64_t bytes = pub_stats.bytes;
+            pub->set_timestamping(true);
+            for (int i = 0; i < 2; i++) pub->publish(msg);
+            node->spin_once();
+            ASSERT_EQ(received, 5);
+            stats = node->stats();
+            EXPECT_EQ(stats[0].bytes - bytes,
+                      2 * (rix::core::data_frame::HEADER_SIZE + rix::core::data_frame::TIMESTAMP_SIZE + msg.size()));
+            EXPECT_EQ(stats[1].bytes, stats[0].bytes);
+            EXPECT_EQ(stats[1].lost, 0);
+            EXPECT_EQ(stats[1].delivery.count, 2);
+            EXPECT_EQ(stats[1].queueing.count, 2);
+            EXPECT_LT(stats[1].delivery.max, 1'000'000'000);
+
+            // Messages stamped 1 ms apart give the callback a 1 ms budget,
+            // which a 2 ms callback overruns, also across spins
+            slow = true;
+            for (int i = 0; i < 3; i++) {
+                msg.header.stamp = (rix::util::Time(msg.header.stamp) + rix::util::Duration(0.001)).to_msg();
+                pub->publish(msg);
+                node->spin_once();
+            }
+            ASSERT_EQ(received, 8);
+            callbacks = node->callback_stats();
+            ASSERT_EQ(callbacks.size(), 1);
+            EXPECT_EQ(callbacks[0].overruns, 3);
+        }
+
+        mediator->shutdown();
+        rixhub_thread.join();
+    }
+
+    NiceMock<MockClient>::server_map = nullptr;
+    NiceMock<MockServer>::server_map = nullptr;
+    NiceMock<MockClient>::server_mutex = nullptr;
+    NiceMock<MockServer>::server_mutex = nullptr;
+}
+
+TEST(RIXTest, StatsTopic) {
+    auto server_map = std::make_shared<std::map<rix::ipc::Endpoint, NiceMock<MockServer> *>>();
+    auto server_mutex = std::make_shared<std::mutex>();
+    NiceMock<MockClient>::address = "127.0.0.1";
+    NiceMock<MockClient>::server_map = server_map;
+    NiceMock<MockServer>::server_map = server_map;
+    NiceMock<MockClient>::server_mutex = server_mutex;
+    NiceMock<MockServer>::server_mutex = server_mutex;
+
+    {
+        rix::ipc::Endpoint rixhub_endpoint("127.0.0.1", rix::core::RIXHUB_PORT);
+        auto mediator = std::make_shared<rix::core::Mediator>(rixhub_endpoint, server_factory, client_factory);
+        ASSERT_TRUE(mediator->ok());
+        std::thread rixhub_thread([&]() { mediator->spin(); });
+
+        {
+            using rix::msg::stats::NodeStatistics;
+            auto node = std::make_shared<rix::core::Node>("test", rixhub_endpoint, server_factory, client_factory);
+            auto pub = node->create_publisher<rix::msg::geometry::Pose2DStamped>("/pose",
+                                                                                  rix::ipc::Endpoint("127.0.0.1", 3));
+            ASSERT_TRUE(node->enable_stats(rix::util::Duration(0.02), 8));
+            NodeStatistics report;
+            size_t received = 0;
+            auto sub = node->create_subscriber<NodeStatistics>(
+                "/rix/stats/test",
+                [&](const NodeStatistics &msg) {
+                    report = msg;
+                    received++;
+                },
+                rix::ipc::Endpoint("127.0.0.1", 2));
+            rix::util::sleep_for(rix::util::Duration(0.25));
+            for (int i = 0; i < 100 && received < 2; i++) {
+                node->spin_once();
+                rix::util::sleep_for(rix::util::Duration(0.005));
+            }
+            ASSERT_GE(received, 2);
+
+            // The statistics publisher does not report itself
+            EXPECT_EQ(report.node, "test");
+            ASSERT_EQ(report.topics.size(), 2);
+            EXPECT_EQ(report.topics[0].topic, "/pose");
+            EXPECT_TRUE(report.topics[0].publisher);
+            EXPECT_EQ(report.topics[1].topic, "/rix/stats/test");
+            EXPECT_FALSE(report.topics[1].publisher);
+            EXPECT_EQ(report.topics[1].connections, 1);
+            EXPECT_GE(report.topics[1].messages, 1);
+            EXPECT_GT(report.topics[1].message_rate, 0.0f);
+            ASSERT_EQ(report.callbacks.size(), 1);
+            EXPECT_EQ(report.callbacks[0].kind, rix::core::CallbackStats::SUBSCRIBER);
+            EXPECT_EQ(report.callbacks[0].calls, received - 1);
+        }
+
+        auto stats = mediator->stats();
+        EXPECT_GE(stats.registrations, 4);
+        EXPECT_EQ(stats.failures, 0);
+        EXPECT_GT(stats.registration_latency_max, 0);
+        EXPECT_GE(stats.registration_latency_max, stats.registration_latency_p50);
+
+        mediator->shutdown();
+        rixhub_thread.join();
+    }
+
+    NiceMock<MockClient>::server_map = nullptr;
+    NiceMock<MockServer>::server_map = nullptr;
+    NiceMock<MockClient>::server_mutex = nullptr;
+    NiceMock<MockServer>::server_mutex = nullptr;
+}
+
+TEST(RIXTest, SequenceTracker) {
+    rix::core::TopicStats stats;
+    rix::core::SequenceTracker tracker;
+    auto received = [&](std::initializer_list<uint32_t> seqs) {
+        std::vector<uint32_t> missing;
+        for (uint32_t seq : seqs) missing.push_back(tracker.update(seq, stats));
+        return missing;
+    };
+
+    // The first message may have any number, e.g. after connecting late
+    EXPECT_EQ(received({10, 11, 12}), std::vector<uint32_t>({0, 0, 0}));
+    EXPECT_EQ(received({15}), std::vector<uint32_t>({2}));
+    EXPECT_EQ(stats.lost.load(), 2);
+    EXPECT_EQ(received({13, 13, 15, 16}), std::vector<uint32_t>({0, 0, 0, 0}));
+    EXPECT_EQ(stats.reordered.load(), 1);
+    EXPECT_EQ(stats.duplicates.load(), 2);
+
+    // Sequence numbers wrap around
+    rix::core::SequenceTracker wrapping;
+    rix::core::TopicStats wrap_stats;
+    wrapping.update(UINT32_MAX - 1, wrap_stats);
+    EXPECT_EQ(wrapping.update(1, wrap_stats), 2);
+    EXPECT_EQ(wrap_stats.lost.load(), 2);
+    EXPECT_EQ(wrap_stats.reordered.load(), 0);
+}
+
+TEST(RIXTest, CallbackStats) {
+    using rix::core::CallbackStats;
+    CallbackStats stats;
+    stats.record(1'000, 1'500, 400, 1'000);  // Overruns its budget
+    stats.record(2'200, 2'300, 400, 1'000);
+    stats.record(3'000, 3'200, 0, 1'000);    // No budget
+    auto snapshot = stats.snapshot(CallbackStats::TIMER, "", 1'000);
+    EXPECT_EQ(snapshot.overruns, 1);
+    EXPECT_EQ(snapshot.execution.count, 3);
+    EXPECT_EQ(snapshot.execution.min, 100);
+    EXPECT_EQ(snapshot.execution.max, 500);
+    EXPECT_EQ(snapshot.execution.mean(), 266);
+    EXPECT_EQ(snapshot.period.count, 2);
+    EXPECT_EQ(snapshot.period.max, 1'200);
+    EXPECT_EQ(snapshot.jitter.min, 200);
+    EXPECT_EQ(snapshot.jitter.max, 200);
+
+    // A 2 ms timer whose callback takes 3 ms overruns on every call
+    rix::core::Timer timer(rix::util::Duration(0.002),
+                           [](const rix::core::Timer::Event &) { rix::util::sleep_for(rix::util::Duration(0.003)); });
+    for (int i = 0; i < 3; i++) timer.spin_once();
+    auto timer_stats = timer.stats().snapshot(CallbackStats::TIMER, "", timer.get_duration().get().count());
+    EXPECT_EQ(timer_stats.execution.count, 3);
+    EXPECT_EQ(timer_stats.overruns, 3);
+    EXPECT_GE(timer_stats.execution.min, 3'000'000);
+    EXPECT_GE(timer_stats.jitter.min, 1'000'000);
+}
+
+TEST(RIXTest, Trace) {
+    using rix::util::Trace;
+    const std::string path = "/tmp/rix_test_" + std::to_string(getpid()) + ".trace.json";
+    rix::core::Timer timer(rix::util::Duration(0.0), [](const rix::core::Timer::Event &) {});
+
+    // Nothing is recorded while tracing is disabled
+    timer.spin_once();
+    Trace::enable(4);
+    for (int i = 0; i < 2; i++) Trace::Scope scope("ring");
+    timer.spin_once();
+    std::thread other([]() {
+        Trace::Scope scope("other", "/quoted\"topic");
+    });
+    other.join();
+    for (int i = 0; i < 2; i++) Trace::Scope scope("ring");
+    Trace::disable();
+    timer.spin_once();
+    ASSERT_TRUE(Trace::dump(path));
+    Trace::clear();
+
+    std::ifstream file(path);
+    std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::remove(path.c_str());
+    auto count = [&](const std::string &text) {
+        size_t n = 0;
+        for (size_t pos = json.find(text); pos != std::string::npos; pos = json.find(text, pos + 1)) n++;
+        return n;
+    };
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+    // The ring buffer of this thread keeps its last 4 events
+    EXPECT_EQ(count("\"name\":\"Timer::callback\""), 1u);
+    EXPECT_EQ(count("\"name\":\"ring\""), 3u);
+    EXPECT_EQ(count("\"name\":\"other\""), 1u);
+    EXPECT_EQ(count("\"detail\":\"/quoted\\\"topic\""), 1u) << json;
+    EXPECT_EQ(count("\"ph\":\"X\""), 5u);
+}
+
+TEST(RIXTest, AsyncLog) {
+    testing::internal::CaptureStdout();
+    rix::util::Log::set_async(true);
+    std::thread other([]() {
+        for (int i = 0; i < 3; i++) rix::util::Log::warn << "other " << i << std::endl;
+    });
+    for (int i = 0; i < 3; i++) rix::util::Log::warn << "main " << i << std::endl;
+    other.join();
+    rix::util::Log::set_async(false);
+    std::string output = testing::internal::GetCapturedStdout();
+
+    // Every record is written once, in order within its thread
+    for (const char *name : {"main", "other"}) {
+        size_t pos = 0;
+        for (int i = 0; i < 3; i++) {
+            std::string text = std::string(name) + " " + std::to_string(i) + "\n";
+            pos = output.find(text, pos);
+            ASSERT_NE(pos, std::string::npos) << text;
+            EXPECT_EQ(output.find(text, pos + 1), std::string::npos);
+        }
+    }
+    EXPECT_EQ(std::count(output.begin(), output.end(), '\n'), 6);
+    EXPECT_NE(output.find("WARN"), std::string::npos);
+
+    // Truncated records keep their newline
+    testing::internal::CaptureStdout();
+    rix::util::Log::set_async(true);
+    rix::util::Log::warn << std::string(1000, 'x') << std::endl;
+    rix::util::Log::warn << "after" << std::endl;
+    rix::util::Log::set_async(false);
+    output = testing::internal::GetCapturedStdout();
+    EXPECT_EQ(std::count(output.begin(), output.end(), '\n'), 2);
+    EXPECT_NE(output.find(std::string(rix::util::detail::LogRecord::TEXT_SIZE - 1, 'x') + "\n"), std::string::npos);
+}
+
+TEST(RIXTest, BinaryLog) {
+    using rix::util::BinaryLog;
+    const std::string path = "/tmp/rix_test_" + std::to_string(getpid()) + ".rixlog";
+
+    // Formats registered before and after the log is opened are both decoded
+    static const auto before = BinaryLog::format<int32_t, double, std::string_view>(
+        rix::util::Log::WARN, "scan {} took {} ms on {}");
+    ASSERT_TRUE(BinaryLog::open_file(path, "rix_test", 4096));
+    static const auto after = BinaryLog::format<bool, uint64_t>(rix::util::Log::ERROR, "ok={} seq={}");
+    BinaryLog::write(before, -3, 1.5, "lidar");
+    BinaryLog::write(after, true, uint64_t(1) << 40);
+
+    // Records that do not fit are dropped and counted
+    for (int i = 0; i < 200; i++) BinaryLog::write(after, false, i);
+    EXPECT_GT(BinaryLog::dropped(), 0u);
+    BinaryLog::close();
+
+    std::ostringstream out;
+    ASSERT_TRUE(BinaryLog::decode(path, out));
+    std::string text = out.str();
+    EXPECT_NE(text.find("[WARN]  [rix_test] scan -3 took 1.5 ms on lidar\n"), std::string::npos) << text;
+    EXPECT_NE(text.find("[ERROR] [rix_test] ok=true seq=1099511627776\n"), std::string::npos) << text;
+    EXPECT_EQ(std::count(text.begin(), text.end(), '\n'), 2 + 200 - static_cast<long>(BinaryLog::dropped()));
+    std::remove(path.c_str());
+
+    std::ofstream(path) << "not a binary log";
+    EXPECT_FALSE(BinaryLog::decode(path, out));
+    std::remove(path.c_str());
+
+    // A format record with ID 0 is skipped
+    std::vector<uint8_t> corrupt(rix::util::binary_log::HEADER_SIZE, 0);
+    std::memcpy(corrupt.data(), rix::util::binary_log::MAGIC, sizeof(rix::util::binary_log::MAGIC));
+    auto append = [&](uint16_t id, uint16_t format_id, const std::string &text) {
+        std::vector<uint8_t> record(rix::util::binary_log::RECORD_HEADER_SIZE, 0);
+        if (id == rix::util::binary_log::FORMAT_RECORD) {
+            record.insert(record.end(), {uint8_t(format_id), uint8_t(format_id >> 8), rix::util::Log::INFO, 0});
+            record.insert(record.end(), text.begin(), text.end());
+        }
+        const uint32_t size = static_cast<uint32_t>(record.size());
+        std::memcpy(record.data(), &size, sizeof(size));
+        std::memcpy(record.data() + 4, &id, sizeof(id));
+        corrupt.insert(corrupt.end(), record.begin(), record.end());
+    };
+    append(rix::util::binary_log::FORMAT_RECORD, 0, "corrupt");
+    append(rix::util::binary_log::FORMAT_RECORD, 1, "valid");
+    append(1, 0, "");
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(corrupt.data()), corrupt.size());
+    out.str("");
+    ASSERT_TRUE(BinaryLog::decode(path, out));
+    EXPECT_NE(out.str().find("] valid\n"), std::string::npos) << out.str();
+    EXPECT_EQ(out.str().find("corrupt"), std::string::npos);
+    std::remove(path.c_str());
+}
+
+TEST(RIXTest, Bag) {
+    auto server_map = std::make_shared<std::map<rix::ipc::Endpoint, NiceMock<MockServer> *>>();
+    auto server_mutex = std::make_shared<std::mutex>();
+    NiceMock<MockClient>::address = "127.0.0.1";
+    NiceMock<MockClient>::server_map = server_map;
+    NiceMock<MockServer>::server_map = server_map;
+    NiceMock<MockClient>::server_mutex = server_mutex;
+    NiceMock<MockServer>::server_mutex = server_mutex;
+
+    const std::string path = "/tmp/rix_test_" + std::to_string(getpid()) + ".rixbag";
+    rix::ipc::Endpoint rixhub_endpoint("127.0.0.1", rix::core::RIXHUB_PORT);
+    auto mediator = std::make_shared<rix::core::Mediator>(rixhub_endpoint, server_factory, client_factory);
+    ASSERT_TRUE(mediator->ok());
+    std::thread rixhub_thread([&]() { mediator->spin(); });
+
+    rix::msg::standard::Header msg;
+    msg.frame_id = "bag";
+    {
+        auto node = std::make_shared<rix::core::Node>("test", rixhub_endpoint, server_factory, client_factory);
+        auto pub = node->create_publisher<rix::msg::standard::Header>("/chatter", rix::ipc::Endpoint("127.0.0.1", 3));
+        rix::msg::mediator::TopicInfo info;
+        EXPECT_FALSE(node->lookup_topic("/missing", info));
+        ASSERT_TRUE(node->lookup_topic("/chatter", info));
+        EXPECT_EQ(info.message_hash, msg.hash());
+
+        // Chunks of 64 bytes hold a single record each
+        rix::core::BagWriter bag;
+        ASSERT_TRUE(bag.open(path, 64, 1));
+        int topic = bag.add_topic(info);
+        ASSERT_EQ(topic, 0);
+        auto sub = node->create_subscriber(
+            info,
+            [&](const uint8_t *src, size_t len, uint8_t encoding) {
+                bag.write(static_cast<uint16_t>(topic), rix::util::Time::now().to_nanoseconds(), encoding, src, len);
+            },
+            rix::ipc::Endpoint("127.0.0.1", 2));
+        ASSERT_NE(sub, nullptr);
+        rix::util::sleep_for(rix::util::Duration(0.25));
+        node->spin_once();  // Subscriber calls connect
+        node->spin_once();  // Publisher calls accept
+        ASSERT_EQ(pub->get_subscriber_count(), 1);
+
+        for (uint32_t i = 0; i < 5; i++) {
+            msg.seq = i;
+            pub->publish(msg);
+        }
+        node->spin_once();
+        EXPECT_EQ(bag.messages(), 5);
+        EXPECT_EQ(sub->stats().messages.load(), 5);
+        ASSERT_TRUE(bag.close());
+        uint64_t bytes = bag.bytes();
+
+        std::ifstream file(path, std::ios::binary);
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        ASSERT_EQ(data.size(), bytes);
+        ASSERT_EQ(std::memcmp(data.data(), rix::core::bag::MAGIC, sizeof(rix::core::bag::MAGIC)), 0);
+
+        // Walk the chunks up to the index and decode the messages
+        using rix::msg::detail::deserialize_number;
+        uint64_t index_offset;
+        size_t header_off = sizeof(rix::core::bag::MAGIC);
+        ASSERT_TRUE(deserialize_number(index_offset, data.data(), data.size(), header_off));
+        ASSERT_LT(index_offset, data.size());
+        size_t pos = rix::core::bag::HEADER_SIZE;
+        uint32_t messages = 0;
+        while (pos < index_offset) {
+            uint64_t size;
+            uint32_t records, chunk_messages;
+            int64_t first, last;
+            size_t off = pos;
+            ASSERT_TRUE(deserialize_number(size, data.data(), data.size(), off));
+            ASSERT_TRUE(deserialize_number(records, data.data(), data.size(), off));
+            ASSERT_TRUE(deserialize_number(chunk_messages, data.data(), data.size(), off));
+            ASSERT_TRUE(deserialize_number(first, data.data(), data.size(), off));
+            ASSERT_TRUE(deserialize_number(last, data.data(), data.size(), off));
+            ASSERT_LE(first, last);
+            ASSERT_LE(off + size, data.size());
+            for (uint32_t r = 0; r < records; r++) {
+                uint32_t len;
+                uint16_t id;
+                uint8_t kind, encoding;
+                int64_t time;
+                deserialize_number(len, data.data(), data.size(), off);
+                deserialize_number(id, data.data(), data.size(), off);
+                deserialize_number(kind, data.data(), data.size(), off);
+                deserialize_number(encoding, data.data(), data.size(), off);
+                deserialize_number(time, data.data(), data.size(), off);
+                EXPECT_EQ(id, 0);
+                size_t end = off;
+                if (kind == rix::core::bag::MESSAGE) {
+                    rix::msg::standard::Header decoded;
+                    ASSERT_TRUE(decoded.deserialize(data.data(), off + len, end));
+                    EXPECT_EQ(decoded.seq, messages++);
+                    EXPECT_EQ(decoded.frame_id, "bag");
+                    EXPECT_EQ(time, first);
+                } else {
+                    rix::msg::mediator::TopicInfo recorded;
+                    ASSERT_TRUE(recorded.deserialize(data.data(), off + len, end));
+                    EXPECT_EQ(recorded.name, "/chatter");
+                }
+                off = (off + len + 7) & ~size_t(7);
+            }
+            EXPECT_EQ(off, pos + rix::core::bag::CHUNK_HEADER_SIZE + size);
+            pos = off;
+        }
+        EXPECT_EQ(pos, index_offset);
+        EXPECT_EQ(messages, 5);
+
+        // The reader finds the messages through the index, and without it
+        for (bool indexed : {true, false}) {
+            if (!indexed) {
+                // A bag that was not closed ends with its last chunk
+                std::fstream truncated(path, std::ios::binary | std::ios::in | std::ios::out);
+                truncated.seekp(sizeof(rix::core::bag::MAGIC));
+                truncated.write("\0\0\0\0\0\0\0\0", 8);
+                truncated.close();
+                ASSERT_EQ(truncate(path.c_str(), static_cast<off_t>(index_offset)), 0);
+            }
+            rix::core::BagReader reader;
+            ASSERT_TRUE(reader.open(path));
+            ASSERT_EQ(reader.topics().size(), 1);
+            EXPECT_EQ(reader.topics()[0].name, "/chatter");
+            EXPECT_EQ(reader.messages(), 5);
+            EXPECT_EQ(reader.chunks().size(), 6);
+            EXPECT_EQ(reader.seek(reader.start_time()), 1);
+            EXPECT_EQ(reader.seek(reader.end_time() + 1), reader.chunks().size());
+
+            ASSERT_TRUE(reader.start(reader.seek(reader.chunks()[3].first), 2));
+            rix::core::BagReader::Message read;
+            std::vector<uint32_t> seqs;
+            while (reader.next(read)) {
+                rix::msg::standard::Header decoded;
+                size_t off = 0;
+                ASSERT_TRUE(decoded.deserialize(read.data, read.len, off));
+                seqs.push_back(decoded.seq);
+            }
+            EXPECT_EQ(seqs, (std::vector<uint32_t>{2, 3, 4}));
+        }
+
+        // Serialized publishers send the recorded bytes as they are
+        rix::core::BagReader reader;
+        ASSERT_TRUE(reader.open(path));
+        auto replay = node->create_serialized_publisher(reader.topics()[0], rix::ipc::Endpoint("127.0.0.1", 4));
+        ASSERT_NE(replay, nullptr);
+        rix::util::sleep_for(rix::util::Duration(0.25));
+        node->spin_once();  // The recording subscriber accepts the notification
+        std::vector<uint32_t> replayed;
+        auto typed = node->create_subscriber<rix::msg::standard::Header>(
+            "/chatter", [&](const rix::msg::standard::Header &h) { replayed.push_back(h.seq); },
+            rix::ipc::Endpoint("127.0.0.1", 5));
+        rix::util::sleep_for(rix::util::Duration(0.25));
+        node->spin_once();
+        node->spin_once();
+        ASSERT_EQ(replay->get_subscriber_count(), 2);
+        reader.start();
+        rix::core::BagReader::Message read;
+        while (reader.next(read)) replay->publish_serialized(read.data, read.len);
+        node->spin_once();
+        EXPECT_EQ(replayed, (std::vector<uint32_t>{0, 1, 2, 3, 4}));
+    }
+    std::remove(path.c_str());
+
+    mediator->shutdown();
+    rixhub_thread.join();
+}
@@ -0,0 +1,486 @@
+#!/usr/bin/env python3
+"""Generates the C++ message headers in include/rix/msg from .msg definitions.
+
+A definition lives in <msg_dir>/<package>/<Name>.msg and lists one field per
+line as "<type> <name>". Lines starting with '#' are comments. Types are
+
+    numbers:   bool int8 uint8 int16 uint16 int32 uint32 int64 uint64
+               float32 float64
+    strings:   string
+    messages:  Name (same package) or package/Name
+
+and any type may be followed by [N] for a fixed-size array or [] for a
+vector. Each definition is written to <out_dir>/<package>/<Name>.hpp. Headers
+are only rewritten when their content changes, so regenerating does not
+trigger a rebuild of unchanged code.
+
+The hash of a message is the MD5 digest of its canonical definition: the
+line "<package>/<Name>" followed by "<type> <name>" for every field, where
+nested message types are replaced by the hex digest of their own hash. Two
+messages with the same fields but different names therefore have different
+hashes, and changing a nested message changes the hash of every message that
+contains it.
+
+Usage: rixmsg.py <msg_dir> <out_dir>
+"""
+
+import hashlib
+import os
+import re
+import sys
+
+NUMBERS = {
+    'bool': 'bool',
+    'int8': 'int8_t',
+    'uint8': 'uint8_t',
+    'int16': 'int16_t',
+    'uint16': 'uint16_t',
+    'int32': 'int32_t',
+    'uint32': 'uint32_t',
+    'int64': 'int64_t',
+    'uint64': 'uint64_t',
+    'float32': 'float',
+    'float64': 'double',
+}
+
+SIZES = {
+    'bool': 1,
+    'int8': 1,
+    'uint8': 1,
+    'int16': 2,
+    'uint16': 2,
+    'int32': 4,
+    'uint32': 4,
+    'int64': 8,
+    'uint64': 8,
+    'float32': 4,
+    'float64': 8,
+}
+
+FIELD_RE = re.compile(r'^([A-Za-z_][A-Za-z0-9_/]*)(?:\[(\d*)\])?\s+([A-Za-z_][A-Za-z0-9_]*)$')
+
+
+class Field:
+    def __init__(self, package, base, length, name):
+        self.name = name
+        self.length = length  # None for scalars, -1 for vectors, N for arrays
+        if base in NUMBERS:
+            self.kind = 'number'
+            self.base = base
+        elif base == 'string':
+            self.kind = 'string'
+            self.base = base
+        else:
+            self.kind = 'message'
+            self.base = base if '/' in base else package + '/' + base
+
+    @property
+    def container(self):
+        if self.length is None:
+            return ''
+        return '_vector' if self.length < 0 else '_array'
+
+    def element_type(self):
+        if self.kind == 'number':
+            return NUMBERS[self.base]
+        if self.kind == 'string':
+            return 'std::string'
+        return self.base.replace('/', '::')
+
+    def cpp_type(self):
+        element = self.element_type()
+        if self.length is None:
+            return element
+        if self.length < 0:
+            return 'std::vector<%s>' % element
+        return 'std::array<%s, %d>' % (element, self.length)
+
+    def view_type(self):
+        if self.kind == 'number':
+            return NUMBERS[self.base] if self.length is None else 'NumberSpan<%s>' % NUMBERS[self.base]
+        element = 'std::string_view' if self.kind == 'string' else self.element_type() + '::View'
+        return element if self.length is None else 'SequenceView<%s>' % element
+
+    def skip_call(self):
+        kind = self.kind + self.container
+        if self.kind == 'string':
+            return 'skip_string_array<%d>' % self.length if self.length and self.length >= 0 else 'skip_' + kind
+        args = [NUMBERS[self.base] if self.kind == 'number' else self.element_type()]
+        if self.length is not None and self.length >= 0:
+            args.append(str(self.length))
+        return 'skip_%s<%s>' % (kind, ', '.join(args))
+
+    def view_call(self):
+        kind = self.kind + self.container
+        if self.length is None:
+            if self.kind == 'number':
+                return 'view_number<%s>' % NUMBERS[self.base]
+            return 'view_' + kind
+        if self.kind == 'number':
+            args = [NUMBERS[self.base]]
+        elif self.kind == 'message':
+            args = [self.element_type() + '::View']
+        else:
+            args = []
+        if self.length >= 0:
+            args.append(str(self.length))
+        return 'view_%s<%s>' % (kind, ', '.join(args)) if args else 'view_' + kind
+
+
+class Definition:
+    def __init__(self, package, name, fields):
+        self.package = package
+        self.name = name
+        self.fields = fields
+
+    @property
+    def key(self):
+        return self.package + '/' + self.name
+
+
+def parse(path, package, name):
+    fields = []
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            line = line.split('#', 1)[0].strip()
+            if not line:
+                continue
+            match = FIELD_RE.match(line)
+            if not match:
+                sys.exit('%s:%d: invalid field "%s"' % (path, number, line))
+            base, length, field = match.groups()
+            if length is None:
+                length = None
+            elif length == '':
+                length = -1
+            else:
+                length = int(length)
+            fields.append(Field(package, base, length, field))
+    return Definition(package, name, fields)
+
+
+class Generator:
+    def __init__(self, definitions):
+        self.definitions = {d.key: d for d in definitions}
+        self.hashes = {}
+        for d in definitions:
+            for f in d.fields:
+                if f.kind == 'message' and f.base not in self.definitions:
+                    sys.exit('%s: unknown message type "%s"' % (d.key, f.base))
+
+    def hash(self, key, visiting=()):
+        if key in self.hashes:
+            return self.hashes[key]
+        if key in visiting:
+            sys.exit('%s: recursive message definition' % key)
+        lines = [key]
+        for f in self.definitions[key].fields:
+            base = self.hash(f.base, visiting + (key,)) if f.kind == 'message' else f.base
+            suffix = '' if f.length is None else '[]' if f.length < 0 else '[%d]' % f.length
+            lines.append('%s%s %s' % (base, suffix, f.name))
+        self.hashes[key] = hashlib.md5('\n'.join(lines).encode()).hexdigest()
+        return self.hashes[key]
+
+    def is_fixed(self, field):
+        if field.length is not None and field.length < 0:
+            return False
+        if field.kind == 'number':
+            return True
+        if field.kind == 'string':
+            return False
+        return all(self.is_fixed(f) for f in self.definitions[field.base].fields)
+
+    def fixed_size(self, field):
+        if field.kind == 'number':
+            size = SIZES[field.base]
+        else:
+            size = sum(self.fixed_size(f) for f in self.definitions[field.base].fields)
+        return size if field.length is None else size * field.length
+
+    def skip_runs(self, fields):
+        """Groups fields for skipping: a list of (index, fields) for each run of
+        fixed-size fields, or (index, field) for a field of variable size."""
+        runs = []
+        for i, f in enumerate(fields):
+            if not self.is_fixed(f):
+                runs.append((i, f))
+            elif runs and isinstance(runs[-1][1], list):
+                runs[-1][1].append(f)
+            else:
+                runs.append((i, [f]))
+        return runs
+
+    def generate(self, d):
+        fields = d.fields
+        fixed = all(self.is_fixed(f) for f in fields)
+        digest = self.hash(d.key)
+        out = []
+        w = out.append
+
+        w('// Generated by tools/rixmsg.py from msg/%s.msg. Do not edit.' % d.key)
+        w('#pragma once')
+        w('')
+        w('#include <cstdint>')
+        w('#include <vector>')
+        w('#include <array>')
+        w('#include <map>')
+        w('#include <string>')
+        w('#include <string_view>')
+        w('#include <cstring>')
+        w('')
+        w('#include "rix/msg/serialization.hpp"')
+        w('#include "rix/msg/message.hpp"')
+        w('#include "rix/msg/view.hpp"')
+        includes = []
+        for f in fields:
+            if f.kind == 'message' and f.base not in includes:
+                includes.append(f.base)
+        for include in includes:
+            w('#include "rix/msg/%s.hpp"' % include)
+        w('')
+        w('namespace rix {')
+        w('namespace msg {')
+        w('namespace %s {' % d.package)
+        w('')
+        w('class %s : public Message {' % d.name)
+        w('  public:')
+        for f in fields:
+            w('    %s %s{};' % (f.cpp_type(), f.name))
+        if fields:
+            w('')
+        w('    %s() = default;' % d.name)
+        w('    %s(const %s &other) = default;' % (d.name, d.name))
+        w('    ~%s() = default;' % d.name)
+        w('')
+        if fixed:
+            types = ', '.join(f.cpp_type() for f in fields)
+            w('    static constexpr size_t FIXED_SIZE = detail::fixed_size_of<%s>();' % types)
+        w('    static constexpr std::array<uint64_t, 2> HASH = {0x%sULL, 0x%sULL};' % (digest[:16], digest[16:]))
+        w('')
+        w('    /**')
+        w('     * @brief Indices of the fields in serialization order, for')
+        w('     * deserialize_prefix() and seek().')
+        w('     */')
+        w('    struct FIELD {')
+        w('        enum INDEX : size_t {')
+        for i, f in enumerate(fields):
+            w('            %s = %d,' % (f.name.upper(), i))
+        w('        };')
+        w('    };')
+        w('    static constexpr size_t FIELD_COUNT = %d;' % len(fields))
+        w('')
+        w('    size_t size() const override {')
+        w('        return static_size();')
+        w('    }')
+        w('')
+        w('    std::array<uint64_t, 2> hash() const override {')
+        w('        return HASH;')
+        w('    }')
+        w('')
+        w('    void serialize(uint8_t *dst, size_t &offset) const override {')
+        w('        static_serialize(dst, offset);')
+        w('    }')
+        w('')
+        w('    bool deserialize(const uint8_t *src, size_t size, size_t &offset) override {')
+        w('        return static_deserialize(src, size, offset);')
+        w('    }')
+        w('')
+        w('    void serialize(Writer &dst) const override {')
+        w('        static_serialize(dst);')
+        w('    }')
+        w('')
+
+        names = ', '.join(f.name for f in fields)
+        w('    size_t static_size() const {')
+        if fixed:
+            w('        return FIXED_SIZE;')
+        else:
+            w('        using namespace detail;')
+            w('        size_t size = 0;')
+            for f in fields:
+                w('        size += size_%s%s(%s);' % (f.kind, f.container, f.name))
+            w('        return size;')
+        w('    }')
+        w('')
+        w('    void static_serialize(uint8_t *dst, size_t &offset) const {')
+        w('        using namespace detail;')
+        if fixed:
+            w('        serialize_fixed(dst, offset%s);' % (', ' + names if names else ''))
+        else:
+            for f in fields:
+                w('        serialize_%s%s(dst, offset, %s);' % (f.kind, f.container, f.name))
+        w('    }')
+        w('')
+        w('    void static_serialize(Writer &dst) const {')
+        w('        using namespace detail;')
+        if fixed:
+            w('        write_fixed(dst%s);' % (', ' + names if names else ''))
+        else:
+            # Fields other than messages are appended in runs, with a single
+            # capacity check per run
+            runs = []
+            for f in fields:
+                if f.kind == 'message':
+                    runs.append(f)
+                elif runs and isinstance(runs[-1], list):
+                    runs[-1].append(f)
+                else:
+                    runs.append([f])
+            declared = False
+            for run in runs:
+                if not isinstance(run, list):
+                    w('        write_%s%s(dst, %s);' % (run.kind, run.container, run.name))
+                    continue
+                prefix = '        run = dst.extend(' if declared else '        uint8_t *run = dst.extend('
+                sizes = ['size_%s%s(%s)' % (f.kind, f.container, f.name) for f in run]
+                line = prefix
+                for i, size in enumerate(sizes):
+                    term = size + (');' if i == len(sizes) - 1 else ' +')
+                    if line.strip() and len(line) + len(term) > 100 and line != prefix:
+                        w(line.rstrip())
+                        line = ' ' * len(prefix)
+                    line += term + ' '
+                w(line.rstrip())
+                w('        offset = 0;' if declared else '        size_t offset = 0;')
+                declared = True
+                for f in run:
+                    w('        serialize_%s%s(run, offset, %s);' % (f.kind, f.container, f.name))
+        w('    }')
+        w('')
+        w('    bool static_deserialize(const uint8_t *src, size_t size, size_t &offset) {')
+        w('        using namespace detail;')
+        if fixed:
+            w('        return deserialize_fixed(src, size, offset%s);' % (', ' + names if names else ''))
+        else:
+            for f in fields:
+                w('        if (!deserialize_%s%s(%s, src, size, offset)) { return false; };'
+                  % (f.kind, f.container, f.name))
+            w('        return true;')
+        w('    }')
+        w('')
+        w('    /**')
+        w('     * @brief Deserializes only the first `fields` fields and leaves `offset` at')
+        w('     * the start of the next one. The remaining fields are not read.')
+        w('     */')
+        w('    bool deserialize_prefix(const uint8_t *src, size_t size, size_t &offset, size_t fields) {')
+        w('        using namespace detail;')
+        for i, f in enumerate(fields):
+            w('        if (fields > %d && !deserialize_%s%s(%s, src, size, offset)) { return false; };'
+              % (i, f.kind, f.container, f.name))
+        w('        return true;')
+        w('    }')
+        w('')
+        runs = self.skip_runs(fields)
+        w('    /**')
+        w('     * @brief Increments `offset` past a serialized %s without decoding it.' % d.name)
+        w('     */')
+        w('    static bool skip(const uint8_t *src, size_t size, size_t &offset) {')
+        w('        using namespace detail;')
+        if fixed:
+            w('        return view_skip(FIXED_SIZE, size, offset);')
+        else:
+            for i, run in runs:
+                if isinstance(run, list):
+                    w('        if (!view_skip(%d, size, offset)) { return false; };'
+                      % sum(self.fixed_size(f) for f in run))
+                else:
+                    w('        if (!%s(src, size, offset)) { return false; };' % run.skip_call())
+            w('        return true;')
+        w('    }')
+        w('')
+        w('    /**')
+        w('     * @brief Increments `offset` from the start of a serialized %s to the' % d.name)
+        w('     * start of `field` (or to its end for FIELD_COUNT) without decoding the')
+        w('     * fields before it. Offsets within runs of fixed-size fields are constant.')
+        w('     */')
+        w('    static bool seek(size_t field, const uint8_t *src, size_t size, size_t &offset) {')
+        w('        using namespace detail;')
+        w('        if (field > FIELD_COUNT) { return false; };')
+        for i, run in runs:
+            if not isinstance(run, list):
+                w('        if (field == %d) { return true; };' % i)
+                w('        if (!%s(src, size, offset)) { return false; };' % run.skip_call())
+                continue
+            offsets = [0]
+            for f in run[:-1]:
+                offsets.append(offsets[-1] + self.fixed_size(f))
+            total = offsets[-1] + self.fixed_size(run[-1])
+            if len(run) == 1:
+                w('        if (field == %d) { return true; };' % i)
+            else:
+                w('        if (field < %d) {' % (i + len(run)))
+                w('            static constexpr size_t offsets[] = {%s};' % ', '.join(str(o) for o in offsets))
+                w('            return view_skip(offsets[field - %d], size, offset);' % i)
+                w('        }')
+            w('        if (!view_skip(%d, size, offset)) { return false; };' % total)
+        w('        return true;')
+        w('    }')
+        w('')
+
+        w('    /**')
+        w('     * @brief Read-only view of a serialized %s. parse() checks the bytes' % d.name)
+        w('     * once, after which the accessors read fields in place without copying.')
+        w('     * The viewed bytes must outlive the View.')
+        w('     */')
+        w('    class View {')
+        w('      public:')
+        w('        bool parse(const uint8_t *src, size_t size, size_t &offset) {')
+        w('            using namespace detail;')
+        w('            src_ = src;')
+        for f in fields:
+            w('            if (!%s(%s_, src, size, offset)) { return false; };' % (f.view_call(), f.name))
+        w('            return true;')
+        w('        }')
+        for f in fields:
+            w('')
+            if f.kind == 'number' and f.length is None:
+                w('        %s %s() const { return detail::load_number<%s>(src_, %s_); }'
+                  % (f.view_type(), f.name, f.view_type(), f.name))
+            else:
+                w('        const %s &%s() const { return %s_; }' % (f.view_type(), f.name, f.name))
+        w('')
+        w('      private:')
+        w('        const uint8_t *src_ = nullptr;')
+        for f in fields:
+            if f.kind == 'number' and f.length is None:
+                w('        size_t %s_ = 0;' % f.name)
+            else:
+                w('        %s %s_{};' % (f.view_type(), f.name))
+        w('    };')
+        w('};')
+        w('')
+        w('} // namespace %s' % d.package)
+        w('} // namespace msg')
+        w('} // namespace rix')
+        return '\n'.join(out)
+
+
+def main(argv):
+    if len(argv) != 3:
+        sys.exit(__doc__)
+    msg_dir, out_dir = argv[1], argv[2]
+
+    definitions = []
+    for package in sorted(os.listdir(msg_dir)):
+        package_dir = os.path.join(msg_dir, package)
+        if not os.path.isdir(package_dir):
+            continue
+        for filename in sorted(os.listdir(package_dir)):
+            if filename.endswith('.msg'):
+                definitions.append(parse(os.path.join(package_dir, filename), package, filename[:-4]))
+
+    generator = Generator(definitions)
+    for d in definitions:
+        content = generator.generate(d)
+        path = os.path.join(out_dir, d.package, d.name + '.hpp')
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+        if os.path.exists(path):
+            with open(path) as f:
+                if f.read() == content:
+                    continue
+        with open(path, 'w') as f:
+            f.write(content)
+
+
+if __name__ == '__main__':
+    main(sys.argv)